@@ -19,6 +19,7 @@
 #include "angband.h"
 #include "cave.h"
 #include "init.h"
+#include "profile.h"
 #include "project.h"
 
 /**
@@ -817,6 +818,8 @@ void update_fire(struct chunk *c, struct player *p)
 	struct loc grid;
 	bool in_pit = square_ispit(c, p->grid) && !p->upkeep->leaping;
 
+	PROFILE_START(update_fire);
+
 	/*** Step 0 -- Begin ***/
 
 	/* Wipe */
@@ -956,6 +959,8 @@ void update_fire(struct chunk *c, struct player *p)
 			}
 		}
 	}
+
+	PROFILE_STOP(update_fire);
 }
 
 /**
@@ -28,6 +28,7 @@
 #include "obj-util.h"
 #include "player-calcs.h"
 #include "player-timed.h"
+#include "profile.h"
 #include "trap.h"
 
 /**
@@ -253,13 +254,14 @@ void square_note_spot(struct chunk *c, struct loc grid)
 /**
  * Tell the UI that a given map location has been updated
  *
- * This function should only be called on "legal" grids.
+ * This function should only be called on "legal" grids.  The change is
+ * passed on with the others at the next handle_stuff() or wait for a key.
  */
 void square_light_spot(struct chunk *c, struct loc grid)
 {
 	if ((c == cave) && player->cave) {
 		player->upkeep->redraw |= PR_ITEMLIST;
-		event_signal_point(EVENT_MAP, grid.x, grid.y);
+		event_mark_map(grid);
 	}
 }
 
@@ -299,10 +301,10 @@ static void cave_unlight(struct point_set *ps)
  */
 static void cave_room_aux(struct point_set *seen, struct loc grid)
 {
-	if (point_set_contains(seen, grid))
+	if (!square_in_bounds(cave, grid))
 		return;
 
-	if (!square_in_bounds(cave, grid))
+	if (point_set_contains(seen, grid))
 		return;
 
 	if (!square_isroom(cave, grid))
@@ -320,7 +322,8 @@ void light_room(struct loc grid, bool light)
 	int i, d;
 	struct point_set *ps;
 
-	ps = point_set_new(200);
+	PROFILE_START(light_room);
+	ps = point_set_new_indexed(200, cave->width, cave->height);
 
 	/* Add the initial grid */
 	cave_room_aux(ps, grid);
@@ -341,6 +344,7 @@ void light_room(struct loc grid, bool light)
 		cave_unlight(ps);
 	}
 	point_set_dispose(ps);
+	PROFILE_STOP(light_room);
 
 	/* Fully update the visuals */
 	player->upkeep->update |= (PU_UPDATE_VIEW | PU_MONSTERS);
@@ -23,6 +23,7 @@
 #include "monster.h"
 #include "obj-knowledge.h"
 #include "obj-pile.h"
+#include "obj-tval.h"
 #include "obj-util.h"
 #include "object.h"
 #include "player-abilities.h"
@@ -884,7 +885,7 @@ bool square_allows_summon(struct chunk *c, struct loc grid)
  */
 bool square_seen_by_keen_senses(struct chunk *c, struct loc grid)
 {
-	if (player_active_ability(player, "Keen Senses") &&
+	if (player_active_ability(player, PA_KEEN_SENSES) &&
 		square_isview(c, grid) && (square_light(c, grid) == 0)) {
 		int d;
 		for (d = 0; d < 8; d++) {
@@ -974,6 +975,7 @@ bool square_holds_object(struct chunk *c, struct loc grid, struct object *obj) {
 void square_excise_object(struct chunk *c, struct loc grid, struct object *obj){
 	assert(square_in_bounds(c, grid));
 	pile_excise(&c->squares[grid.y][grid.x].obj, obj);
+	square_note_pile(c, grid);
 }
 
 /**
@@ -1092,6 +1094,7 @@ void square_know_pile(struct chunk *c, struct loc grid)
 	if (c != cave) return;
 
 	object_lists_check_integrity(c, player->cave);
+	artifact_objects_check_integrity(c, player);
 
 	/* Know every item on this grid */
 	for (obj = square_object(c, grid); obj; obj = obj->next) {
@@ -1146,6 +1149,73 @@ int square_num_walls_diagonal(struct chunk *c, struct loc grid)
 }
 
 
+/**
+ * Add a grid to or remove it from the chunk's list of floor grids
+ */
+static void square_note_floor(struct chunk *c, struct loc grid, bool floor)
+{
+	int n = grid.y * c->width + grid.x;
+
+	if (floor) {
+		c->floor_place[n] = c->floor_count;
+		c->floor_grids[c->floor_count++] = n;
+	} else {
+		/* Move the last one into the gap */
+		int last = c->floor_grids[--c->floor_count];
+		c->floor_grids[c->floor_place[n]] = last;
+		c->floor_place[last] = c->floor_place[n];
+		c->floor_place[n] = -1;
+	}
+}
+
+/**
+ * Put a grid in or take it out of one of the chunk's grid classes; does
+ * nothing if it is already in or out
+ */
+static void square_note_class(struct chunk *c, struct loc grid, int class,
+		bool member)
+{
+	struct grid_list *list = &c->grid_lists[class];
+	int n = grid.y * c->width + grid.x;
+
+	if (member && list->place[n] < 0) {
+		if (list->count == list->size) {
+			list->size = list->size ? 2 * list->size : 16;
+			list->grids = mem_realloc(list->grids,
+				list->size * sizeof(*list->grids));
+		}
+		list->place[n] = list->count;
+		list->grids[list->count++] = n;
+	} else if (!member && list->place[n] >= 0) {
+		/* Move the last one into the gap */
+		int last = list->grids[--list->count];
+		list->grids[list->place[n]] = last;
+		list->place[last] = list->place[n];
+		list->place[n] = -1;
+	}
+}
+
+/**
+ * Get the grid classes, as (1 << GRID_CLASS_xxx) bits, which come from
+ * having a given terrain
+ */
+static int feat_grid_classes(int feat)
+{
+	const bitflag *flags = f_info[feat].flags;
+	int classes = 0;
+
+	if (tf_has(flags, TF_DOOR_ANY)) {
+		classes |= (1 << GRID_CLASS_DOOR);
+		if (tf_has(flags, TF_ROCK)) classes |= (1 << GRID_CLASS_SECRET_DOOR);
+	} else if (tf_has(flags, TF_ROCK) && !tf_has(flags, TF_WALL)) {
+		classes |= (1 << GRID_CLASS_RUBBLE);
+	}
+	if (feat_is_chasm(feat)) classes |= (1 << GRID_CLASS_CHASM);
+	if (feat_is_forge(feat)) classes |= (1 << GRID_CLASS_FORGE);
+	if (tf_has(flags, TF_STAIR)) classes |= (1 << GRID_CLASS_STAIR);
+	return classes;
+}
+
 /**
  * Set the terrain type for a square.
  *
@@ -1154,7 +1224,7 @@ int square_num_walls_diagonal(struct chunk *c, struct loc grid)
  */
 void square_set_feat(struct chunk *c, struct loc grid, int feat)
 {
-	int current_feat;
+	int current_feat, old_classes, new_classes;
 
 	assert(square_in_bounds(c, grid));
 	current_feat = square(c, grid)->feat;
@@ -1162,9 +1232,25 @@ void square_set_feat(struct chunk *c, struct loc grid, int feat)
 	/* Track changes */
 	if (current_feat) c->feat_count[current_feat]--;
 	if (feat) c->feat_count[feat]++;
+	if (feat_is_floor(current_feat) != feat_is_floor(feat)) {
+		square_note_floor(c, grid, feat_is_floor(feat));
+	}
+	old_classes = feat_grid_classes(current_feat);
+	new_classes = feat_grid_classes(feat);
+	if (old_classes != new_classes) {
+		int i;
+
+		for (i = 0; i < GRID_CLASS_MAX; i++) {
+			if ((old_classes ^ new_classes) & (1 << i)) {
+				square_note_class(c, grid, i, (new_classes & (1 << i)) != 0);
+			}
+		}
+	}
 
 	/* Make the change */
 	c->squares[grid.y][grid.x].feat = feat;
+	c->feat_stamp++;
+	path_cache_terrain_changed();
 
 	/* Make the new terrain feel at home */
 	if (character_dungeon) {
@@ -1197,6 +1283,7 @@ static void square_set_known_feat(struct chunk *c, struct loc grid, int feat)
 void square_set_mon(struct chunk *c, struct loc grid, int midx)
 {
 	c->squares[grid.y][grid.x].mon = midx;
+	path_cache_occupancy_changed();
 }
 
 /**
@@ -1205,6 +1292,25 @@ void square_set_mon(struct chunk *c, struct loc grid, int midx)
 void square_set_obj(struct chunk *c, struct loc grid, struct object *obj)
 {
 	c->squares[grid.y][grid.x].obj = obj;
+	square_note_pile(c, grid);
+}
+
+/**
+ * Bring the grid classes that depend on a square's objects up to date after
+ * its pile has changed.
+ */
+void square_note_pile(struct chunk *c, struct loc grid)
+{
+	struct object *obj;
+	bool chest = false;
+
+	for (obj = square_object(c, grid); obj; obj = obj->next) {
+		if (tval_is_chest(obj)) {
+			chest = true;
+			break;
+		}
+	}
+	square_note_class(c, grid, GRID_CLASS_CHEST, chest);
 }
 
 /**
@@ -1213,6 +1319,7 @@ void square_set_obj(struct chunk *c, struct loc grid, struct object *obj)
 void square_set_trap(struct chunk *c, struct loc grid, struct trap *trap)
 {
 	c->squares[grid.y][grid.x].trap = trap;
+	square_note_class(c, grid, GRID_CLASS_TRAP, trap != NULL);
 }
 
 void square_add_trap(struct chunk *c, struct loc grid)
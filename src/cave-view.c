@@ -27,6 +27,8 @@
 #include "player-abilities.h"
 #include "player-calcs.h"
 #include "player-timed.h"
+#include "profile.h"
+#include "project.h"
 #include "trap.h"
 
 /**
@@ -48,6 +50,120 @@ int distance(struct loc grid1, struct loc grid2)
 	return ay > ax ? ay + (ax >> 1) : ax + (ay >> 1);
 }
 
+/**
+ * Line of sight and projection results, shared by los() and projectable().
+ * Each entry is stamped with counters that change whenever terrain changes
+ * or anything moves, so an entry is only used while the grids it was traced
+ * through are as they were; that makes it safe to keep entries from one
+ * game turn to the next.
+ */
+#define PATH_CACHE_SIZE 4096
+
+struct path_cache_entry {
+	struct loc grid1;
+	struct loc grid2;
+	int flg;				/* Projection flags, or PATH_CACHE_LOS */
+	uint32_t terrain;		/* path_cache_terrain when the entry was made */
+	uint32_t occupancy;		/* path_cache_occupancy when the entry was made */
+	int result;
+};
+
+static struct path_cache_entry path_cache[PATH_CACHE_SIZE];
+static uint32_t path_cache_terrain = 1;
+static uint32_t path_cache_occupancy = 1;
+
+/**
+ * Find the cache slot for a path
+ */
+static struct path_cache_entry *path_cache_slot(struct loc grid1,
+		struct loc grid2, int flg)
+{
+	uint32_t hash = (uint32_t) grid1.x * 73856093U
+		^ (uint32_t) grid1.y * 19349663U
+		^ (uint32_t) grid2.x * 83492791U
+		^ (uint32_t) grid2.y * 50331653U
+		^ (uint32_t) flg * 2654435761U;
+
+	return &path_cache[(hash ^ (hash >> 16)) & (PATH_CACHE_SIZE - 1)];
+}
+
+/**
+ * Whether a path result can be cached at all, and whether it depends on
+ * where monsters and the player are as well as on the terrain
+ */
+static bool path_cache_usable(struct chunk *c, int flg, bool *occupants)
+{
+	/* Only the current level, with no grid being ignored */
+	if ((c != cave) || !loc_is_zero(c->project_path_ignore)) return false;
+
+	/* Paths limited to known grids depend on the player's memory */
+	if ((flg != PATH_CACHE_LOS) && (flg & (PROJECT_INVIS))) return false;
+
+	*occupants = (flg != PATH_CACHE_LOS) &&
+		(flg & (PROJECT_STOP | PROJECT_CHCK));
+	return true;
+}
+
+/**
+ * Look up a cached line of sight or projection result.  Returns true and
+ * sets result if a current entry exists.
+ */
+bool path_cache_get(struct chunk *c, struct loc grid1, struct loc grid2,
+		int flg, int *result)
+{
+	struct path_cache_entry *entry;
+	bool occupants;
+
+	if (!path_cache_usable(c, flg, &occupants)) return false;
+	entry = path_cache_slot(grid1, grid2, flg);
+	if (!loc_eq(entry->grid1, grid1) || !loc_eq(entry->grid2, grid2) ||
+		(entry->flg != flg) ||
+		(entry->terrain != path_cache_terrain) ||
+		(occupants && (entry->occupancy != path_cache_occupancy))) {
+		PROFILE_COUNT(path_cache_miss);
+		return false;
+	}
+	PROFILE_COUNT(path_cache_hit);
+	*result = entry->result;
+	return true;
+}
+
+/**
+ * Remember a line of sight or projection result
+ */
+void path_cache_set(struct chunk *c, struct loc grid1, struct loc grid2,
+		int flg, int result)
+{
+	struct path_cache_entry *entry;
+	bool occupants;
+
+	if (!path_cache_usable(c, flg, &occupants)) return;
+	entry = path_cache_slot(grid1, grid2, flg);
+	entry->grid1 = grid1;
+	entry->grid2 = grid2;
+	entry->flg = flg;
+	entry->terrain = path_cache_terrain;
+	entry->occupancy = path_cache_occupancy;
+	entry->result = result;
+}
+
+/**
+ * Forget all cached paths, because terrain has changed
+ */
+void path_cache_terrain_changed(void)
+{
+	path_cache_terrain++;
+}
+
+/**
+ * Forget cached paths which can be blocked by monsters or the player,
+ * because one of them has moved
+ */
+void path_cache_occupancy_changed(void)
+{
+	path_cache_occupancy++;
+}
+
 
 /**
  * A simple, fast, integer-based line-of-sight algorithm.  By Joseph Hall,
@@ -85,7 +201,7 @@ int distance(struct loc grid1, struct loc grid2)
  * determining which grids are illuminated by the player's torch, and which
  * grids and monsters can be "seen" by the player, etc).
  */
-bool los(struct chunk *c, struct loc grid1, struct loc grid2)
+static bool los_trace(struct chunk *c, struct loc grid1, struct loc grid2)
 {
 	/* Delta */
 	int dx, dy;
@@ -250,6 +366,24 @@ bool los(struct chunk *c, struct loc grid1, struct loc grid2)
 	return (true);
 }
 
+/**
+ * Determine whether there is line of sight between two grids; see
+ * los_trace() above for the details
+ */
+bool los(struct chunk *c, struct loc grid1, struct loc grid2)
+{
+	int result;
+
+	/* Short lines are quicker to trace than to look up */
+	if (distance(grid1, grid2) < 4) return los_trace(c, grid1, grid2);
+
+	if (!path_cache_get(c, grid1, grid2, PATH_CACHE_LOS, &result)) {
+		result = los_trace(c, grid1, grid2);
+		path_cache_set(c, grid1, grid2, PATH_CACHE_LOS, result);
+	}
+	return result != 0;
+}
+
 /**
  * The comments below are still predominantly true, and have been left
  * (slightly modified for accuracy) for historical and nostalgic reasons.
@@ -622,7 +756,7 @@ static void add_light(struct chunk *c, struct player *p, struct loc sgrid,
 	int bonus_light = 0;
 
 	/* Handle Inner Light */
-	if (loc_eq(sgrid, p->grid) && player_active_ability(p, "Inner Light")) {
+	if (loc_eq(sgrid, p->grid) && player_active_ability(p, PA_INNER_LIGHT)) {
 		bonus_light = 1;
 	}
 
@@ -665,6 +799,8 @@ static void calc_lighting(struct chunk *c, struct player *p)
 	int light = p->upkeep->cur_light, radius = ABS(light);
 	int old_light = square_light(c, p->grid);
 
+	PROFILE_START(calc_lighting);
+
 	/* Starting values based on permanent light */
 	for (y = 0; y < c->height; y++) {
 		for (x = 0; x < c->width; x++) {
@@ -759,6 +895,8 @@ static void calc_lighting(struct chunk *c, struct player *p)
 	if (square_light(c, p->grid) != old_light) {
 		p->upkeep->redraw |= PR_LIGHT;
 	}
+
+	PROFILE_STOP(calc_lighting);
 }
 
 /**
@@ -891,6 +1029,8 @@ void update_view(struct chunk *c, struct player *p)
 {
 	int x, y;
 
+	PROFILE_START(update_view);
+
 	/* Record the current view */
 	mark_wasseen(c);
 
@@ -927,6 +1067,8 @@ void update_view(struct chunk *c, struct player *p)
 
 	/* Update field-of-fire (using the old view algorithm for now - NRM) */
 	update_fire(c, p);
+
+	PROFILE_STOP(update_view);
 }
 
 
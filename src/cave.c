@@ -425,12 +425,25 @@ void flow_free(struct chunk *c, struct flow *flow) {
  * Allocate a new chunk of the world
  */
 struct chunk *cave_new(int height, int width) {
-	int y, x;
+	int y, x, i;
 
 	struct chunk *c = mem_zalloc(sizeof *c);
 	c->height = height;
 	c->width = width;
 	c->feat_count = mem_zalloc((FEAT_MAX + 1) * sizeof(int));
+	c->feat_stamp = 1;
+	c->floor_grids = mem_zalloc(height * width * sizeof(int));
+	c->floor_place = mem_alloc(height * width * sizeof(int));
+	for (y = 0; y < height * width; y++) {
+		c->floor_place[y] = -1;
+	}
+	for (i = 0; i < GRID_CLASS_MAX; i++) {
+		struct grid_list *list = &c->grid_lists[i];
+		list->place = mem_alloc(height * width * sizeof(int));
+		for (y = 0; y < height * width; y++) {
+			list->place[y] = -1;
+		}
+	}
 
 	c->squares = mem_zalloc(c->height * sizeof(struct square*));
 	for (y = 0; y < c->height; y++) {
@@ -442,7 +455,7 @@ struct chunk *cave_new(int height, int width) {
 
 	flow_new(c, &c->player_noise);
 	flow_new(c, &c->monster_noise);
-	flow_new(c, &c->scent);
+	c->scent = mem_zalloc(c->height * c->width * sizeof(uint32_t));
 
 	c->objects = mem_zalloc(OBJECT_LIST_SIZE * sizeof(struct object*));
 	c->obj_max = OBJECT_LIST_SIZE - 1;
@@ -486,9 +499,19 @@ void cave_free(struct chunk *c) {
 
 	flow_free(c, &c->player_noise);
 	flow_free(c, &c->monster_noise);
-	flow_free(c, &c->scent);
+	for (i = 0; i < NOISE_FLOW_CACHE; i++) {
+		if (c->noise_flows[i].grids) flow_free(c, &c->noise_flows[i]);
+		mem_free(c->noise_flow_heard[i]);
+	}
+	mem_free(c->scent);
 
 	mem_free(c->feat_count);
+	mem_free(c->floor_grids);
+	mem_free(c->floor_place);
+	for (i = 0; i < GRID_CLASS_MAX; i++) {
+		mem_free(c->grid_lists[i].grids);
+		mem_free(c->grid_lists[i].place);
+	}
 	mem_free(c->objects);
 	mem_free(c->monsters);
 	mem_free(c->monster_groups);
@@ -605,6 +628,104 @@ void object_lists_check_integrity(struct chunk *c, struct chunk *c_k)
 	}
 }
 
+/**
+ * Check consistency of the recorded artifact objects
+ *
+ * Each recorded object must be an instance of its artifact, and each
+ * artifact on the level, held by a monster or in the player's gear must
+ * have a recorded instance
+ */
+void artifact_objects_check_integrity(struct chunk *c, struct player *p)
+{
+	struct object *obj;
+	int i;
+
+	for (i = 0; i < z_info->a_max; i++) {
+		obj = aup_info[i].obj;
+		if (obj) {
+			assert(obj->artifact == &a_info[i]);
+		}
+	}
+	for (i = 1; i < c->obj_max; i++) {
+		obj = c->objects[i];
+		if (obj && obj->artifact &&
+				(!loc_is_zero(obj->grid) || obj->held_m_idx)) {
+			assert(artifact_object(obj->artifact));
+		}
+	}
+	for (obj = p->gear; obj; obj = obj->next) {
+		if (obj->artifact) {
+			assert(artifact_object(obj->artifact));
+		}
+	}
+}
+
+static int cmp_grid_index(const void *a, const void *b)
+{
+	return *(const int *) a - *(const int *) b;
+}
+
+/**
+ * Get the grids in any of a set of grid classes
+ *
+ * \param c is the chunk
+ * \param classes has bit (1 << GRID_CLASS_xxx) set for each class wanted
+ * \param n is set to the number of grids found
+ * \return the grids in row-major order, each once, to be freed by the caller
+ *
+ * The result is a snapshot, so the caller may change the grids in it as it
+ * goes, and visits them in the same order as a scan of the whole level would.
+ */
+struct loc *cave_class_grids(struct chunk *c, int classes, int *n)
+{
+	struct loc *grids;
+	int *index;
+	int i, j, total = 0;
+
+	for (i = 0; i < GRID_CLASS_MAX; i++) {
+		if (classes & (1 << i)) total += c->grid_lists[i].count;
+	}
+	index = mem_alloc((total + 1) * sizeof(*index));
+	total = 0;
+	for (i = 0; i < GRID_CLASS_MAX; i++) {
+		if (classes & (1 << i)) {
+			memcpy(index + total, c->grid_lists[i].grids,
+				c->grid_lists[i].count * sizeof(*index));
+			total += c->grid_lists[i].count;
+		}
+	}
+	sort(index, total, sizeof(*index), cmp_grid_index);
+
+	/* Drop grids in more than one class */
+	grids = mem_alloc((total + 1) * sizeof(*grids));
+	for (i = 0, j = 0; i < total; i++) {
+		if (i && index[i] == index[i - 1]) continue;
+		grids[j++] = loc(index[i] % c->width, index[i] / c->width);
+	}
+	mem_free(index);
+	*n = j;
+	return grids;
+}
+
+/**
+ * Pick a grid of the given class at random
+ *
+ * \param c is the chunk
+ * \param grid is set to the grid picked
+ * \param class is the GRID_CLASS_xxx index
+ * \return whether there was any grid of the class
+ */
+bool cave_find_class(struct chunk *c, struct loc *grid, int class)
+{
+	const struct grid_list *list = &c->grid_lists[class];
+	int n;
+
+	if (!list->count) return false;
+	n = list->grids[randint0(list->count)];
+	*grid = loc(n % c->width, n / c->width);
+	return true;
+}
+
 /**
  * Standard "find me a location" function, now with all legal outputs!
  *
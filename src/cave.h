@@ -187,6 +187,33 @@ struct connector {
 	struct connector *next;
 };
 
+/**
+ * Classes of grid listed by each chunk
+ */
+enum
+{
+	#define GRID_CLASS(a, b) GRID_CLASS_##a,
+	#include "list-grid-classes.h"
+	#undef GRID_CLASS
+	GRID_CLASS_MAX
+};
+
+/**
+ * The grids of one class, as y * width + x, with the place of each in the
+ * list so grids can be added and removed in constant time
+ */
+struct grid_list {
+	int *grids;		/* The grids in the class, unordered */
+	int *place;		/* Each grid's place in grids, or -1 */
+	int count;		/* Number of grids in the class */
+	int size;		/* Allocated length of grids */
+};
+
+/**
+ * Number of recent noise sources whose flows each chunk keeps for reuse
+ */
+#define NOISE_FLOW_CACHE 4
+
 struct chunk {
 	char *name;
 	int32_t turn;
@@ -196,14 +223,23 @@ struct chunk {
 	int width;
 
 	int *feat_count;
+	uint32_t feat_stamp;	/* Changes whenever any grid's terrain changes */
+	int *floor_grids;		/* Every floor grid, as y * width + x, unordered */
+	int *floor_place;		/* Each grid's place in floor_grids, or -1 */
+	int floor_count;		/* Number of floor grids */
+	struct grid_list grid_lists[GRID_CLASS_MAX];	/* Doors, traps, etc */
 
 	struct loc project_path_ignore;
 
 	struct square **squares;
 	struct flow player_noise;
 	struct flow monster_noise;
-	struct flow scent;
-	int scent_age;
+	struct flow noise_flows[NOISE_FLOW_CACHE];	/* Recent monster_noise flows */
+	uint32_t noise_flow_stamp[NOISE_FLOW_CACHE];	/* feat_stamp of each */
+	uint64_t *noise_flow_heard[NOISE_FLOW_CACHE];	/* Grids each reached */
+	int noise_flow_next;	/* Next of noise_flows to replace */
+	uint32_t *scent;		/* Scent stamps, height * width of them */
+	uint32_t scent_turn;	/* Number of times scent has been laid */
 
 	struct object **objects;
 	uint16_t obj_max;
@@ -240,7 +276,19 @@ int project_path(struct chunk *c, struct loc *gp, int range, struct loc grid1,
 	struct loc *grid2, int flg);
 
 /* cave-view.c */
+
+/**
+ * Flags value used for line of sight entries in the path cache
+ */
+#define PATH_CACHE_LOS -1
+
 int distance(struct loc grid1, struct loc grid2);
+bool path_cache_get(struct chunk *c, struct loc grid1, struct loc grid2,
+	int flg, int *result);
+void path_cache_set(struct chunk *c, struct loc grid1, struct loc grid2,
+	int flg, int result);
+void path_cache_terrain_changed(void);
+void path_cache_occupancy_changed(void);
 bool los(struct chunk *c, struct loc grid1, struct loc grid2);
 void update_view(struct chunk *c, struct player *p);
 bool no_light(const struct player *p);
@@ -391,6 +439,7 @@ int square_num_walls_diagonal(struct chunk *c, struct loc grid);
 void square_set_feat(struct chunk *c, struct loc grid, int feat);
 void square_set_mon(struct chunk *c, struct loc grid, int midx);
 void square_set_obj(struct chunk *c, struct loc grid, struct object *obj);
+void square_note_pile(struct chunk *c, struct loc grid);
 void square_set_trap(struct chunk *c, struct loc grid, struct trap *trap);
 void square_add_trap(struct chunk *c, struct loc grid);
 void square_add_glyph(struct chunk *c, struct loc grid, int type);
@@ -441,6 +490,9 @@ void cave_free(struct chunk *c);
 void list_object(struct chunk *c, struct object *obj);
 void delist_object(struct chunk *c, struct object *obj);
 void object_lists_check_integrity(struct chunk *c, struct chunk *c_k);
+struct loc *cave_class_grids(struct chunk *c, int classes, int *n);
+bool cave_find_class(struct chunk *c, struct loc *grid, int class);
+void artifact_objects_check_integrity(struct chunk *c, struct player *p);
 void scatter(struct chunk *c, struct loc *place, struct loc grid, int d,
 			 bool need_los);
 int scatter_ext(struct chunk *c, struct loc *places, int n, struct loc grid,
@@ -0,0 +1,6 @@
+MACRO(CONFIGURE_BENCH_FRONTEND _NAME_TARGET)
+
+    TARGET_COMPILE_DEFINITIONS(${_NAME_TARGET} PRIVATE -D USE_BENCH)
+    MESSAGE(STATUS "Support for benchmark front end - Ready")
+
+ENDMACRO()
@@ -0,0 +1,6 @@
+MACRO(CONFIGURE_PROFILE_BACKEND _NAME_TARGET)
+
+    TARGET_COMPILE_DEFINITIONS(${_NAME_TARGET} PRIVATE -D USE_PROFILE)
+    MESSAGE(STATUS "Support for profiling backend - Ready")
+
+ENDMACRO()
@@ -0,0 +1,32 @@
+# Usage: cmake -DBENCH=<executable> -P check_bench.cmake
+# Play the seed 42 benchmark and check that its profile reflects real play:
+# the autoplayer has to see monsters and trade projections with them, or the
+# timings it reports say little about the game.
+# Variables with special meanings to this script:
+# BENCH
+#     The path to an executable built with the benchmark front end.  Required.
+
+CMAKE_POLICY(VERSION 3.5)
+
+IF(NOT DEFINED BENCH)
+    MESSAGE(FATAL_ERROR "BENCH must be set to the executable to run")
+ENDIF()
+
+# The game refuses to start without UTF-8 support.
+SET(ENV{LANG} "C.UTF-8")
+EXECUTE_PROCESS(COMMAND "${BENCH}" -mbench -- -s42 -t50000 -q
+    WORKING_DIRECTORY . RESULT_VARIABLE _RUN_RESULT
+    OUTPUT_VARIABLE _RUN_OUTPUT ERROR_VARIABLE _RUN_ERROR)
+IF(_RUN_RESULT)
+    MESSAGE(FATAL_ERROR "Benchmark died: ${_RUN_RESULT} ${_RUN_ERROR}")
+ENDIF()
+
+FOREACH(_REGION update_monsters project)
+    IF(NOT (_RUN_OUTPUT MATCHES "\"${_REGION}\": { \"calls\": ([0-9]+),"))
+        MESSAGE(FATAL_ERROR "Benchmark output has no count for ${_REGION}")
+    ENDIF()
+    IF(CMAKE_MATCH_1 EQUAL 0)
+        MESSAGE(FATAL_ERROR "Seed 42 benchmark never ran ${_REGION}")
+    ENDIF()
+    MESSAGE("Seed 42 benchmark: ${CMAKE_MATCH_1} calls to ${_REGION}")
+ENDFOREACH()
@@ -665,7 +665,7 @@ void do_cmd_exchange(struct command *cmd)
 	struct monster *mon;
 	char m_name[80];
 
-	if (!player_active_ability(player, "Exchange Places")) {
+	if (!player_active_ability(player, PA_EXCHANGE_PLACES)) {
 		msg("You need the ability 'exchange places' to use this command.");
 		return;
 	}
@@ -138,6 +138,7 @@ typedef enum cmd_code {
 	CMD_WIZ_PEEK_NOISE_SCENT,
 	CMD_WIZ_PERFORM_EFFECT,
 	CMD_WIZ_PLAY_ITEM,
+	CMD_WIZ_PROFILE,
 	CMD_WIZ_PUSH_OBJECT,
 	CMD_WIZ_QUERY_FEATURE,
 	CMD_WIZ_QUERY_SQUARE_FLAG,
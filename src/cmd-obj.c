@@ -61,7 +61,7 @@ static int check_devices(struct object *obj)
 	int difficulty = obj->kind->level / 2;
 
 	/* Bonus to roll for 'channeling' ability */
-	if (player_active_ability(player, "Channeling")) {
+	if (player_active_ability(player, PA_CHANNELING)) {
 		score += 5;
 	}
 
@@ -360,7 +360,7 @@ void do_cmd_wield(struct command *cmd)
 			two_weapon = true;
 		}
 	}
-	if ((player_active_ability(player, "Two Weapon Fighting") || two_weapon) && 
+	if ((player_active_ability(player, PA_TWO_WEAPON_FIGHTING) || two_weapon) && 
 	    tval_is_melee_weapon(obj)) {
 		if (!of_has(obj->flags, OF_TWO_HANDED) &&
 			!of_has(obj->flags, OF_HAND_AND_A_HALF)) {
@@ -537,7 +537,7 @@ static void use_aux(struct command *cmd, struct object *obj, enum use use,
 
 	/* Check voice */
 	if (use == USE_VOICE) {
-		int voice_cost = player_active_ability(player, "Channeling") ? 10 : 20;
+		int voice_cost = player_active_ability(player, PA_CHANNELING) ? 10 : 20;
 
 		if (player->csp < voice_cost) {
 			event_signal(EVENT_INPUT_FLUSH);
@@ -21,6 +21,7 @@
 #include "cmds.h"
 #include "effects.h"
 #include "game-input.h"
+#include "game-world.h"
 #include "generate.h"
 #include "init.h"
 #include "mon-lore.h"
@@ -37,6 +38,7 @@
 #include "player-calcs.h"
 #include "player-timed.h"
 #include "player-util.h"
+#include "profile.h"
 #include "project.h"
 #include "target.h"
 #include "trap.h"
@@ -360,6 +362,7 @@ static void wiz_play_item_notify_changed(void)
 static void wiz_play_item_standard_upkeep(struct player *p, struct object *obj)
 {
 	if (object_is_carried(p, obj)) {
+		equip_bonuses_changed(p, obj);
 		p->upkeep->update |= (PU_BONUS | PU_INVEN);
 		p->upkeep->notice |= (PN_COMBINE);
 		p->upkeep->redraw |= (PR_INVEN | PR_EQUIP);
@@ -1297,7 +1300,7 @@ static void wiz_hack_map_peek_noise(struct chunk *c, void *closure,
  * wiz_hack_map() in order to peek at the scent.
  *
  * \param c is the chunk to access for data.
- * \param closure is a pointer to an integer with the desired scent level.
+ * \param closure is a pointer to an integer with the desired scent age.
  * \param grid is the location in the chunk.
  * \param show is dereferenced and set to true if grid has the desired scent.
  * Otherwise, it is dereferenced and set to false.
@@ -1307,7 +1310,7 @@ static void wiz_hack_map_peek_noise(struct chunk *c, void *closure,
 static void wiz_hack_map_peek_scent(struct chunk *c, void *closure,
 	struct loc grid, bool *show, uint8_t *color)
 {
-	if (c->scent.grids[grid.y][grid.x] == *((int*)closure)) {
+	if (get_scent(c, grid) == *((int*)closure)) {
 		*show = true;
 		*color = COLOUR_YELLOW;
 	} else {
@@ -1668,9 +1671,11 @@ void do_cmd_wiz_play_item(struct command *cmd)
 			release_ability_list(obj->abilities);
 			obj->abilities = NULL;
 
+			forget_artifact_object(obj);
 			object_copy(obj, orig_obj);
 			obj->prev = prev;
 			obj->next = next;
+			set_artifact_object(obj);
 		}
 
 		/* Release the preserved copy. */
@@ -1695,6 +1700,56 @@ void do_cmd_wiz_play_item(struct command *cmd)
 }
 
 
+/**
+ * Display the profiling counters, with the option to reset them or write
+ * them to profile.csv in the user directory (CMD_WIZ_PROFILE).  Takes no
+ * arguments from cmd.
+ */
+void do_cmd_wiz_profile(struct command *cmd)
+{
+	char buf[1024];
+	char c;
+	bool chosen;
+	int i;
+
+	if (!profile_is_enabled()) {
+		msg("Profiling not turned on in this build.");
+		return;
+	}
+
+	screen_save();
+
+	prt(format("%-18s %10s %12s %10s  %s", "Region", "Calls", "Total ms",
+		"us/call", "Description"), 0, 0);
+	for (i = 0; i < PROF_MAX; i++) {
+		const struct profile_counter *counter = &profile_counters[i];
+
+		prt(format("%-18s %10lu %12.1f %10.1f  %s",
+			profile_region_name(i), (unsigned long)counter->calls,
+			counter->nsec / 1.0e6,
+			counter->calls ? counter->nsec / 1.0e3 / counter->calls : 0.0,
+			profile_region_desc(i)), i + 2, 0);
+	}
+
+	chosen = get_com("[r]eset counters, [d]ump to profile.csv, or any other key? ",
+		&c);
+	screen_load();
+	if (!chosen) return;
+
+	if (c == 'r' || c == 'R') {
+		profile_reset();
+		msg("Profiling counters reset.");
+	} else if (c == 'd' || c == 'D') {
+		path_build(buf, sizeof(buf), ANGBAND_DIR_USER, "profile.csv");
+		if (profile_dump_csv(buf)) {
+			msg("Profiling counters written to %s.", buf);
+		} else {
+			msg("Could not write %s.", buf);
+		}
+	}
+}
+
+
 /**
  * Push objects from a selected grid (CMD_WIZ_PUSH_OBJECT).  Can take the
  * location from the argument, "point", of type point in cmd.
@@ -2125,6 +2180,7 @@ void do_cmd_wiz_reroll_item(struct command *cmd)
 		obj->abilities = NULL;
 
 		/* Copy over; pile information needs to be restored. */
+		forget_artifact_object(obj);
 		object_copy(obj, new);
 		obj->prev = prev;
 		obj->next = next;
@@ -2133,6 +2189,7 @@ void do_cmd_wiz_reroll_item(struct command *cmd)
 		obj->oidx = oidx;
 		obj->grid = grid;
 		obj->notice = notice;
+		set_artifact_object(obj);
 	}
 
 	/* Mark as cheat */
@@ -2529,6 +2586,7 @@ void do_cmd_wiz_tweak_item(struct command *cmd)
 	if (!get_string("Enter ego item: ", tmp_val, sizeof(tmp_val))) return;
 
 	/* Accept index or name */
+	forget_artifact_object(obj);
 	if (get_int_from_string(tmp_val, &val)) {
 		if (val >= 0 && val < z_info->e_max) {
 			obj->ego = &e_info[val];
@@ -2557,6 +2615,7 @@ void do_cmd_wiz_tweak_item(struct command *cmd)
 		obj->notice = notice;
 		ego_apply_magic(obj, player->depth);
 	}
+	set_artifact_object(obj);
 	wiz_display_item(obj, true, player);
 
 	/* Get artifact name */
@@ -2575,6 +2634,7 @@ void do_cmd_wiz_tweak_item(struct command *cmd)
 	}
 
 	/* Accept index or name */
+	forget_artifact_object(obj);
 	if (get_int_from_string(tmp_val, &val)) {
 		if (val > 0 && val < z_info->a_max) {
 			obj->artifact = &a_info[val];
@@ -2604,6 +2664,7 @@ void do_cmd_wiz_tweak_item(struct command *cmd)
 		obj->notice = notice;
 		copy_artifact_data(obj, obj->artifact);
 	}
+	set_artifact_object(obj);
 	wiz_display_item(obj, true, player);
 
 #define WIZ_TWEAK(attribute, name) do {\
@@ -111,6 +111,7 @@ void do_cmd_wiz_magic_map(struct command *cmd);
 void do_cmd_wiz_peek_noise_scent(struct command *cmd);
 void do_cmd_wiz_perform_effect(struct command *cmd);
 void do_cmd_wiz_play_item(struct command *cmd);
+void do_cmd_wiz_profile(struct command *cmd);
 void do_cmd_wiz_push_object(struct command *cmd);
 void do_cmd_wiz_query_feature(struct command *cmd);
 void do_cmd_wiz_query_square_flag(struct command *cmd);
@@ -35,6 +35,12 @@
 #include "songs.h"
 #include "trap.h"
 
+/**
+ * Most protection dice counted for a player: one per body slot, plus songs
+ * and abilities, with room to spare
+ */
+#define PROTECTION_DICE_MAX 32
+
 /**
  * Knock monster or player backwards
  */
@@ -244,7 +250,7 @@ static int concentration_bonus(struct player *p, struct loc grid)
 	int midx = square_monster(cave, grid) ? square_monster(cave, grid)->midx :0;
 	
 	/* Deal with 'concentration' ability */
-	if (player_active_ability(p, "Concentration") &&
+	if (player_active_ability(p, PA_CONCENTRATION) &&
 		(p->last_attack_m_idx == midx)) {
 		bonus = MIN(p->consecutive_attacks,
 					p->state.skill_use[SKILL_PERCEPTION] / 2);
@@ -269,7 +275,7 @@ static int focused_attack_bonus(struct player *p)
 	if (p->focused) {
 		p->focused = false;
 		
-		if (player_active_ability(p, "Focused Attack")) {
+		if (player_active_ability(p, PA_FOCUSED_ATTACK)) {
 			return (p->state.skill_use[SKILL_PERCEPTION] / 2);
 		}
 	}
@@ -286,7 +292,7 @@ static int master_hunter_bonus(struct player *p, struct monster *mon)
 	struct monster_lore *lore = get_lore(mon->race);
 
 	/* Master hunter bonus */
-	if (player_active_ability(p, "Master Hunter")) {
+	if (player_active_ability(p, PA_MASTER_HUNTER)) {
 		return MIN(lore->pkills, p->state.skill_use[SKILL_PERCEPTION] / 4);
 	}
 	return 0;
@@ -477,7 +483,7 @@ int stealth_melee_bonus(const struct monster *mon)
 {
 	int stealth_bonus = 0;
 		
-	if (player_active_ability(player, "Assassination")) {
+	if (player_active_ability(player, PA_ASSASSINATION)) {
 		if ((mon->alertness < ALERTNESS_ALERT) && monster_is_visible(mon) &&
 			!player->timed[TMD_CONFUSED]) {
 			stealth_bonus = player->state.skill_use[SKILL_STEALTH];
@@ -544,7 +550,7 @@ int overwhelming_att_mod(struct player *p, struct monster *mon)
 	}
 	
 	/* Adjust for crowd fighting ability */
-	if (player_active_ability(p, "Crowd Fighting")) {
+	if (player_active_ability(p, PA_CROWD_FIGHTING)) {
 		mod /= 2;
 	}
 	
@@ -624,32 +630,32 @@ int crit_bonus(struct player *p, int hit_result, int weight,
 		/* Changes to melee criticals */
 		if (skill_type == SKILL_MELEE) {
 			/* Can have improved criticals for melee */
-			if (player_active_ability(p, "Finesse")) {
+			if (player_active_ability(p, PA_FINESSE)) {
 				crit_separation -= 10;
 			}
 
 			/* Can have improved criticals for melee with one handed weapons */
-			if (player_active_ability(p, "Subtlety") && !thrown &&
+			if (player_active_ability(p, PA_SUBTLETY) && !thrown &&
 				!two_handed_melee(p) &&
 				!equipped_item_by_slot_name(p, "arm")) {
 				crit_separation -= 20;
 			}
 
 			/* Can have inferior criticals for melee */
-			if (player_active_ability(p, "Power")) {
+			if (player_active_ability(p, PA_POWER)) {
 				crit_separation += 10;
 			}
 		}
 
 		/* Can have improved criticals for archery */
 		if ((skill_type == SKILL_ARCHERY) &&
-			player_active_ability(p, "Precision")) {
+			player_active_ability(p, PA_PRECISION)) {
 			crit_separation -= 10;
 		}
 	} else {
 		/* When attacking the player... */
 		/* Resistance to criticals increases what they need for each bonus die*/
-		if (player_active_ability(p, "Critical Resistance")) {
+		if (player_active_ability(p, PA_CRITICAL_RESISTANCE)) {
 			crit_separation += (p->state.skill_use[SKILL_WILL] / 5) * 10;	
 		}
 	}
@@ -676,24 +682,28 @@ int crit_bonus(struct player *p, int hit_result, int weight,
 }
 
 /**
- * Roll the protection dice for all parts of the player's armour
+ * The protection dice for all parts of the player's armour, as (num, sides)
+ * pairs in the order they are rolled; returns the number of pairs
  */
-int protection_roll(struct player *p, int typ, bool melee, aspect prot_aspect)
+static int protection_dice(struct player *p, int typ, bool melee,
+		int dice[][2], int max)
 {
 	int i;
-	int prt = 0;
+	int n = 0;
 	int mult = 1;
 	int armour_weight = 0;
 	struct song *staying = lookup_song("Staying");
-	
+
 	/* Things that always count: */
-	if (player_is_singing(p, staying)) {
+	if (player_is_singing(p, staying) && (n < max)) {
 		int bonus = song_bonus(p, p->state.skill_use[SKILL_SONG], staying);
-		prt += damcalc(1, MAX(1, bonus), prot_aspect);
+		dice[n][0] = 1;
+		dice[n++][1] = MAX(1, bonus);
 	}
 	
-	if (player_active_ability(p, "Hardiness")) {
-		prt += damcalc(1, p->state.skill_use[SKILL_WILL] / 6, prot_aspect);
+	if (player_active_ability(p, PA_HARDINESS) && (n < max)) {
+		dice[n][0] = 1;
+		dice[n++][1] = p->state.skill_use[SKILL_WILL] / 6;
 	}
 	
 	/* Armour: */
@@ -712,29 +722,303 @@ int protection_roll(struct player *p, int typ, bool melee, aspect prot_aspect)
 		/* Fire and cold and generic 'hurt' all check the shield */
 		if (slot_type_is(p, i, EQUIP_SHIELD)) {
 			if ((typ == PROJ_HURT) || (typ == PROJ_FIRE) || (typ == PROJ_COLD)){
-				if (player_active_ability(p, "Blocking") &&
+				if (player_active_ability(p, PA_BLOCKING) &&
 					(!melee || ((p->previous_action[0] == ACTION_STAND) ||
 								((p->previous_action[0] == ACTION_NOTHING) &&
 								 (p->previous_action[1] == ACTION_STAND))))) {
 					mult = 2;
 				}
-				if (obj->pd > 0) {
-					prt += damcalc(obj->pd * mult, obj->ps, prot_aspect);
+				if ((obj->pd > 0) && (n < max)) {
+					dice[n][0] = obj->pd * mult;
+					dice[n++][1] = obj->ps;
 				}
 			}
 		} else if ((typ == PROJ_HURT) || (tval_is_jewelry(obj)))	{
 			/* Also add protection if damage is generic 'hurt' or it is
 			 * a ring or amulet slot */
-			if (obj->ps > 0) {
-				prt += damcalc(obj->pd, obj->ps, prot_aspect);
+			if ((obj->ps > 0) && (n < max)) {
+				dice[n][0] = obj->pd;
+				dice[n++][1] = obj->ps;
 			}
 		}
 	}
 
 	/* Heavy armour bonus */
-	if (player_active_ability(p, "Heavy Armour") && (typ == PROJ_HURT)) {
-		prt += damcalc(1, MIN(1, armour_weight / 150), prot_aspect);
+	if (player_active_ability(p, PA_HEAVY_ARMOUR) && (typ == PROJ_HURT) &&
+			(n < max)) {
+		dice[n][0] = 1;
+		dice[n++][1] = MIN(1, armour_weight / 150);
+	}
+
+	return n;
+}
+
+/**
+ * Roll the protection dice for all parts of the player's armour
+ */
+int protection_roll(struct player *p, int typ, bool melee, aspect prot_aspect)
+{
+	int dice[PROTECTION_DICE_MAX][2];
+	int i, n = protection_dice(p, typ, melee, dice, PROTECTION_DICE_MAX);
+	int prt = 0;
+
+	for (i = 0; i < n; i++) {
+		prt += damcalc(dice[i][0], dice[i][1], prot_aspect);
 	}
 
 	return prt;
 }
+
+/**
+ * ------------------------------------------------------------------------
+ * Exact odds
+ *
+ * These work out the chance of every outcome of the rolls above, so that
+ * expected damage and the like can be had without simulating many blows.
+ * Each follows the corresponding roll exactly, with RANDOMISE protection.
+ * ------------------------------------------------------------------------ */
+/**
+ * Make a distribution over min..max with every chance zero.
+ */
+struct combat_odds *odds_new(int min, int max)
+{
+	struct combat_odds *odds = mem_zalloc(sizeof(*odds));
+
+	assert(max >= min);
+	odds->min = min;
+	odds->count = max - min + 1;
+	odds->p = mem_zalloc(odds->count * sizeof(double));
+	return odds;
+}
+
+void odds_free(struct combat_odds *odds)
+{
+	if (!odds) return;
+	mem_free(odds->p);
+	mem_free(odds);
+}
+
+/**
+ * Chance of exactly the given value
+ */
+double odds_chance(const struct combat_odds *odds, int value)
+{
+	if ((value < odds->min) || (value >= odds->min + odds->count)) return 0.0;
+	return odds->p[value - odds->min];
+}
+
+/**
+ * Chance of a value greater than the one given
+ */
+double odds_chance_above(const struct combat_odds *odds, int value)
+{
+	double chance = 0.0;
+	int i;
+
+	for (i = MAX(value + 1 - odds->min, 0); i < odds->count; i++) {
+		chance += odds->p[i];
+	}
+	return chance;
+}
+
+double odds_mean(const struct combat_odds *odds)
+{
+	double mean = 0.0;
+	int i;
+
+	for (i = 0; i < odds->count; i++) {
+		mean += (odds->min + i) * odds->p[i];
+	}
+	return mean;
+}
+
+/**
+ * Distribution of the sum of two independent rolls
+ */
+struct combat_odds *odds_sum(const struct combat_odds *a,
+		const struct combat_odds *b)
+{
+	struct combat_odds *sum = odds_new(a->min + b->min,
+		a->min + b->min + a->count + b->count - 2);
+	int i, j;
+
+	for (i = 0; i < a->count; i++) {
+		if (a->p[i] == 0.0) continue;
+		for (j = 0; j < b->count; j++) {
+			sum->p[i + j] += a->p[i] * b->p[j];
+		}
+	}
+	return sum;
+}
+
+/**
+ * Distribution of damroll(num, sides)
+ */
+struct combat_odds *odds_dice(int num, int sides)
+{
+	struct combat_odds *odds = odds_new(0, 0);
+	int i;
+
+	odds->p[0] = 1.0;
+	if (sides <= 0) return odds;
+
+	for (i = 0; i < num; i++) {
+		struct combat_odds *die = odds_new(1, sides), *sum;
+		int j;
+
+		for (j = 0; j < sides; j++) {
+			die->p[j] = 1.0 / sides;
+		}
+		sum = odds_sum(odds, die);
+		odds_free(die);
+		odds_free(odds);
+		odds = sum;
+	}
+	return odds;
+}
+
+/**
+ * Distribution of one die, or of the worse of two if worse is set
+ */
+static struct combat_odds *odds_die(int sides, bool worse)
+{
+	struct combat_odds *odds = odds_new(1, sides);
+	int k;
+
+	for (k = 1; k <= sides; k++) {
+		if (worse) {
+			/* Both at least k, less both at least k + 1 */
+			odds->p[k - 1] = (double) ((sides + 1 - k) * (sides + 1 - k)
+				- (sides - k) * (sides - k)) / (sides * sides);
+		} else {
+			odds->p[k - 1] = 1.0 / sides;
+		}
+	}
+	return odds;
+}
+
+/**
+ * Distribution of (die + a) - (die + b)
+ */
+static struct combat_odds *odds_contest(int sides, int a, bool worse_a,
+		int b, bool worse_b)
+{
+	struct combat_odds *roll_a = odds_die(sides, worse_a);
+	struct combat_odds *roll_b = odds_die(sides, worse_b);
+	struct combat_odds *odds = odds_new(a - b + 1 - sides, a - b + sides - 1);
+	int i, j;
+
+	for (i = 0; i < sides; i++) {
+		for (j = 0; j < sides; j++) {
+			odds->p[i - j + sides - 1] += roll_a->p[i] * roll_b->p[j];
+		}
+	}
+	odds_free(roll_b);
+	odds_free(roll_a);
+	return odds;
+}
+
+/**
+ * Distribution of skill_check() for the final skill and difficulty; the
+ * worse flags are for a cursed player on that side
+ */
+struct combat_odds *skill_check_odds(int skill, int difficulty,
+		bool worse_skill, bool worse_difficulty)
+{
+	return odds_contest(10, skill, worse_skill, difficulty, worse_difficulty);
+}
+
+/**
+ * Distribution of hit_roll(); the worse flags are for a cursed player
+ */
+struct combat_odds *hit_roll_odds(int att, int evn, bool worse_att,
+		bool worse_evn)
+{
+	return odds_contest(20, att, worse_att, evn, worse_evn);
+}
+
+/**
+ * Distribution of protection_roll() with RANDOMISE
+ */
+struct combat_odds *protection_odds(struct player *p, int typ, bool melee)
+{
+	int dice[PROTECTION_DICE_MAX][2];
+	int i, n = protection_dice(p, typ, melee, dice, PROTECTION_DICE_MAX);
+	struct combat_odds *odds = odds_dice(0, 0);
+
+	for (i = 0; i < n; i++) {
+		struct combat_odds *roll = odds_dice(dice[i][0], dice[i][1]);
+		struct combat_odds *sum = odds_sum(odds, roll);
+
+		odds_free(roll);
+		odds_free(odds);
+		odds = sum;
+	}
+	return odds;
+}
+
+/**
+ * Distribution of the damage done by a blow, after protection, with misses
+ * counting as no damage.  This follows the player's melee, archery and
+ * throws (race set) and monster blows (race NULL): the hit roll, critical
+ * dice from crit_bonus(), the damage roll, and then the protection roll
+ * reduced to prt_percent percent.  If hit or crit are not NULL they are
+ * set to the chance of a hit and of a hit with at least one critical die.
+ */
+struct combat_odds *blow_odds(struct player *p, const struct blow_roll *blow,
+		double *hit, double *crit)
+{
+	struct combat_odds *rolls = hit_roll_odds(blow->att, blow->evn,
+		blow->worse_att, blow->worse_evn);
+	struct combat_odds *none = blow->prt ? NULL : odds_dice(0, 0);
+	const struct combat_odds *prt = blow->prt ? blow->prt : none;
+	struct combat_odds *damage = NULL, *net;
+	int max_dice = blow->dice, i, j, k;
+	double hit_chance = 0.0, crit_chance = 0.0;
+
+	/* Damage before protection, for each number of critical dice */
+	for (i = 0; i < rolls->count; i++) {
+		int result = rolls->min + i;
+		int dice;
+
+		if (result <= 0) continue;
+		dice = blow->crits ? crit_bonus(p, result, blow->weight, blow->race,
+			blow->skill_type, blow->thrown) : 0;
+		max_dice = MAX(max_dice, blow->dice + dice);
+	}
+	damage = odds_new(0, MAX(max_dice * MAX(blow->sides, 0), 0));
+	for (i = 0; i < rolls->count; i++) {
+		int result = rolls->min + i;
+		struct combat_odds *roll;
+		int dice;
+
+		if ((result <= 0) || (rolls->p[i] == 0.0)) continue;
+		dice = blow->crits ? crit_bonus(p, result, blow->weight, blow->race,
+			blow->skill_type, blow->thrown) : 0;
+		hit_chance += rolls->p[i];
+		if (dice > 0) crit_chance += rolls->p[i];
+		roll = odds_dice(blow->dice + dice, blow->sides);
+		for (j = 0; j < roll->count; j++) {
+			damage->p[roll->min + j] += rolls->p[i] * roll->p[j];
+		}
+		odds_free(roll);
+	}
+
+	/* Take off protection, a miss doing nothing */
+	net = odds_new(0, damage->count - 1);
+	net->p[0] = 1.0 - hit_chance;
+	for (j = 0; j < damage->count; j++) {
+		if (damage->p[j] == 0.0) continue;
+		for (k = 0; k < prt->count; k++) {
+			int taken = ((prt->min + k) * blow->prt_percent) / 100;
+			net->p[MAX(j - taken, 0)] += damage->p[j] * prt->p[k];
+		}
+	}
+
+	if (hit) *hit = hit_chance;
+	if (crit) *crit = crit_chance;
+	odds_free(none);
+	odds_free(damage);
+	odds_free(rolls);
+	return net;
+}
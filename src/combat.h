@@ -23,8 +23,37 @@
 
 struct source;
 struct monster;
+struct monster_race;
 struct player;
 
+/**
+ * The exact chance of each outcome of a roll: p[i] is the chance of min + i
+ */
+struct combat_odds {
+	int min;
+	int count;
+	double *p;
+};
+
+/**
+ * Everything that decides the outcome of one blow, shot or throw
+ */
+struct blow_roll {
+	int att;				/* Total attack score */
+	int evn;				/* Total evasion score */
+	bool worse_att;			/* Attacker takes the worse of two rolls */
+	bool worse_evn;			/* Defender takes the worse of two rolls */
+	int dice;				/* Damage dice before criticals */
+	int sides;
+	bool crits;				/* Whether critical hits add dice */
+	int weight;				/* Weight for critical hits */
+	const struct monster_race *race;	/* Race hit, or NULL for the player */
+	int skill_type;			/* Skill the player attacks with */
+	bool thrown;			/* Whether the weapon was thrown */
+	const struct combat_odds *prt;	/* Protection roll, or NULL for none */
+	int prt_percent;		/* Percentage of protection that counts */
+};
+
 bool knock_back(struct loc grid1, struct loc grid2);
 int skill_check(struct source attacker, int skill, int difficulty,
 				struct source defender);
@@ -39,5 +68,20 @@ int overwhelming_att_mod(struct player *p, struct monster *mon);
 int crit_bonus(struct player *p, int hit_result, int weight,
 			   const struct monster_race *race, int skill_type, bool thrown);
 int protection_roll(struct player *p, int typ, bool melee, aspect prot_aspect);
+struct combat_odds *odds_new(int min, int max);
+void odds_free(struct combat_odds *odds);
+double odds_chance(const struct combat_odds *odds, int value);
+double odds_chance_above(const struct combat_odds *odds, int value);
+double odds_mean(const struct combat_odds *odds);
+struct combat_odds *odds_sum(const struct combat_odds *a,
+		const struct combat_odds *b);
+struct combat_odds *odds_dice(int num, int sides);
+struct combat_odds *skill_check_odds(int skill, int difficulty,
+		bool worse_skill, bool worse_difficulty);
+struct combat_odds *hit_roll_odds(int att, int evn, bool worse_att,
+		bool worse_evn);
+struct combat_odds *protection_odds(struct player *p, int typ, bool melee);
+struct combat_odds *blow_odds(struct player *p, const struct blow_roll *blow,
+		double *hit, double *crit);
 
 #endif /* !COMBAT_H */
@@ -126,23 +126,23 @@ static bool close_chasm(struct loc grid, int power)
  */
 static void close_marked_chasms(void)
 {
-	struct loc grid;
-
-	/* Search the whole map */
-	for (grid.y = 0; grid.y < cave->height; grid.y++) {
-		for (grid.x = 0; grid.x < cave->width; grid.x++) {
-			/* Find all the marked chasms */
-			if (square_ischasm(cave, grid) && square_ismark(cave, grid)) {
-				/* Unmark and add floor */
-				square_unmark(cave, grid);
-				square_set_feat(cave, grid, FEAT_FLOOR);
-
-				/* Memorize */
-				square_memorize(cave, grid);
-				square_light_spot(cave, grid);
-			}
+	int i, n;
+	struct loc *chasms = cave_class_grids(cave, (1 << GRID_CLASS_CHASM), &n);
+
+	/* Find all the marked chasms */
+	for (i = 0; i < n; i++) {
+		struct loc grid = chasms[i];
+		if (square_ismark(cave, grid)) {
+			/* Unmark and add floor */
+			square_unmark(cave, grid);
+			square_set_feat(cave, grid, FEAT_FLOOR);
+
+			/* Memorize */
+			square_memorize(cave, grid);
+			square_light_spot(cave, grid);
 		}
 	}
+	mem_free(chasms);
 }
 
 /**
@@ -1013,98 +1013,101 @@ bool effect_handler_SONG_OF_FREEDOM(effect_handler_context_t *context)
 	int base_diff = player->depth ? player->depth / 2 : 10;
 	int score = song_bonus(player, player->state.skill_use[SKILL_SONG],
 						   lookup_song("Freedom"));
-	struct loc grid;
+	int i, n;
+	struct loc *grids = cave_class_grids(cave, (1 << GRID_CLASS_CHEST)
+		| (1 << GRID_CLASS_CHASM) | (1 << GRID_CLASS_TRAP)
+		| (1 << GRID_CLASS_DOOR) | (1 << GRID_CLASS_RUBBLE), &n);
 	bool closed_chasm = false;
 
-    /* Scan the map */
-    for (grid.y = 0; grid.y < cave->height; grid.y++) {
-        for (grid.x = 0; grid.x < cave->width; grid.x++) {
-			struct object *obj;
-			if (!square_in_bounds_fully(cave, grid)) continue;
-			obj = square_object(cave, grid);
-			if (obj && tval_is_chest(obj) && (obj->pval > 0)) {
-				/* Chest */
-				int diff = base_diff + 5 + flow_dist(cave->player_noise, grid);
-				if (skill_check(source_player(), score, diff, source_none())) {
-                        /* Disarm or Unlock */
-                        obj->pval = (0 - obj->pval);
-
-                        /* Identify */
-                        obj->known->pval = obj->pval;
-				}
-			} else if (square_ischasm(cave, grid)) {
-				/* Chasm */
-				int power = score - flow_dist(cave->player_noise, grid) - 5;
-                closed_chasm |= close_chasm(grid, power);
-			} else if (square_issecrettrap(cave, grid)) {
-				/* Invisible trap */
-				int diff = base_diff + 5 + flow_dist(cave->player_noise, grid);
-				if (skill_check(source_player(), score, diff, source_none())
-					> 0) {
-					square_destroy_trap(cave, grid);
-				}
-			} else if (square_isvisibletrap(cave, grid)) {
-				/* Visible trap */
-				int diff = base_diff + 5 + flow_dist(cave->player_noise, grid);
-				if (skill_check(source_player(), score, diff, source_none())
-					> 0) {
-					square_destroy_trap(cave, grid);
-					square_light_spot(cave, grid);
-				}
-			} else if (square_issecretdoor(cave, grid)) {
-				/* Secret door */
-				int diff = base_diff + flow_dist(cave->player_noise, grid);
-				if (skill_check(source_player(), score, diff, source_none())
-					> 0) {
-					place_closed_door(cave, grid);
-					if (square_isseen(cave, grid)) {
-						msg("You have found a secret door.");
-						disturb(player, false);
-					}
-				}
-			} else if (square_isjammeddoor(cave, grid)) {
-				/* Stuck door */
-				int diff = base_diff + flow_dist(cave->player_noise, grid);
-				int result = skill_check(source_player(), score, diff,
-										 source_none());
-				if (result > 0) {
-					int jam = square_door_jam_power(cave, grid) - result;
-					square_set_door_jam(cave, grid, MAX(jam, 0));
-				}
-			} else if (square_islockeddoor(cave, grid)) {
-				/* Locked door */
-				int diff = base_diff + flow_dist(cave->player_noise, grid);
-				int result = skill_check(source_player(), score, diff,
-										 source_none());
-				if (result > 0) {
-					int lock = square_door_lock_power(cave, grid) - result;
-					square_set_door_lock(cave, grid, MAX(lock, 0));
+	/* Scan the grids that might be affected, in map order */
+	for (i = 0; i < n; i++) {
+		struct loc grid = grids[i];
+		struct object *obj;
+		if (!square_in_bounds_fully(cave, grid)) continue;
+		obj = square_object(cave, grid);
+		if (obj && tval_is_chest(obj) && (obj->pval > 0)) {
+			/* Chest */
+			int diff = base_diff + 5 + flow_dist(cave->player_noise, grid);
+			if (skill_check(source_player(), score, diff, source_none())) {
+                    /* Disarm or Unlock */
+                    obj->pval = (0 - obj->pval);
+
+                    /* Identify */
+                    obj->known->pval = obj->pval;
+			}
+		} else if (square_ischasm(cave, grid)) {
+			/* Chasm */
+			int power = score - flow_dist(cave->player_noise, grid) - 5;
+            closed_chasm |= close_chasm(grid, power);
+		} else if (square_issecrettrap(cave, grid)) {
+			/* Invisible trap */
+			int diff = base_diff + 5 + flow_dist(cave->player_noise, grid);
+			if (skill_check(source_player(), score, diff, source_none())
+				> 0) {
+				square_destroy_trap(cave, grid);
+			}
+		} else if (square_isvisibletrap(cave, grid)) {
+			/* Visible trap */
+			int diff = base_diff + 5 + flow_dist(cave->player_noise, grid);
+			if (skill_check(source_player(), score, diff, source_none())
+				> 0) {
+				square_destroy_trap(cave, grid);
+				square_light_spot(cave, grid);
+			}
+		} else if (square_issecretdoor(cave, grid)) {
+			/* Secret door */
+			int diff = base_diff + flow_dist(cave->player_noise, grid);
+			if (skill_check(source_player(), score, diff, source_none())
+				> 0) {
+				place_closed_door(cave, grid);
+				if (square_isseen(cave, grid)) {
+					msg("You have found a secret door.");
+					disturb(player, false);
 				}
-			} else if (square_isrubble(cave, grid)) {
-				/* Rubble */
-                int d, noise_dist = 100;
-				int diff, result;
-
-                /* Check adjacent squares for valid noise distances, since
-				 * rubble is impervious to sound */
-                for (d = 0; d < 8; d++) {
-                    int dir = cycle[d];
-					int noise_dist_new = flow_dist(cave->player_noise,
-												   loc_sum(grid, ddgrid[dir]));
-					noise_dist = MIN(noise_dist, noise_dist_new);
-                }
-                noise_dist++;
-
-                diff = base_diff + 5 + noise_dist;
-                result = skill_check(source_player(), score, diff,
+			}
+		} else if (square_isjammeddoor(cave, grid)) {
+			/* Stuck door */
+			int diff = base_diff + flow_dist(cave->player_noise, grid);
+			int result = skill_check(source_player(), score, diff,
 									 source_none());
-                if (result > 0) {
-					square_set_feat(cave, grid, FEAT_FLOOR);
-                    player->upkeep->update |= (PU_UPDATE_VIEW | PU_MONSTERS);
-				}
+			if (result > 0) {
+				int jam = square_door_jam_power(cave, grid) - result;
+				square_set_door_jam(cave, grid, MAX(jam, 0));
+			}
+		} else if (square_islockeddoor(cave, grid)) {
+			/* Locked door */
+			int diff = base_diff + flow_dist(cave->player_noise, grid);
+			int result = skill_check(source_player(), score, diff,
+									 source_none());
+			if (result > 0) {
+				int lock = square_door_lock_power(cave, grid) - result;
+				square_set_door_lock(cave, grid, MAX(lock, 0));
+			}
+		} else if (square_isrubble(cave, grid)) {
+			/* Rubble */
+            int d, noise_dist = 100;
+			int diff, result;
+
+            /* Check adjacent squares for valid noise distances, since
+			 * rubble is impervious to sound */
+            for (d = 0; d < 8; d++) {
+                int dir = cycle[d];
+				int noise_dist_new = flow_dist(cave->player_noise,
+											   loc_sum(grid, ddgrid[dir]));
+				noise_dist = MIN(noise_dist, noise_dist_new);
+            }
+            noise_dist++;
+
+            diff = base_diff + 5 + noise_dist;
+            result = skill_check(source_player(), score, diff,
+								 source_none());
+            if (result > 0) {
+				square_set_feat(cave, grid, FEAT_FLOOR);
+                player->upkeep->update |= (PU_UPDATE_VIEW | PU_MONSTERS);
 			}
 		}
 	}
+	mem_free(grids);
 
     /* Then, if any chasms were marked to be closed, do the closing */
     if (closed_chasm) {
@@ -1122,30 +1125,30 @@ bool effect_handler_SONG_OF_BINDING(effect_handler_context_t *context)
 {
 	struct monster *mon = cave_monster(cave, context->origin.which.monster);
 	int song_skill = monster_sing(mon, lookup_song("Binding"));
-	struct loc grid;
-	int dist, result, resistance;
+	struct loc *doors;
+	int i, n, dist, result, resistance;
 
 	/* Use the monster noise flow to represent the song levels at each square */
-	cave->monster_noise.centre = mon->grid;
-    update_flow(cave, &cave->monster_noise, NULL);
-
-    /* Scan the map, closing doors */
-    for (grid.y = 0; grid.y < cave->height; grid.y++) {
-        for (grid.x = 0; grid.x < cave->width; grid.x++) {
-            if (!square_in_bounds_fully(cave, grid)) continue;
-
-            /* If there is no player/monster in the square, and it's a door,
-			* and the door isn't between the monster and the player */
-            if (!square_monster(cave, grid) && square_isdoor(cave, grid) &&
-				!((mon->grid.y <= grid.y) && (grid.y <= player->grid.y) &&
-				  (mon->grid.y <= grid.y) && (grid.y <= player->grid.y))) {
-				dist = 15 + flow_dist(cave->monster_noise, grid);
-				result = skill_check(source_monster(mon->midx), song_skill,
-									 dist, source_none());
-				square_set_door_lock(cave, grid, result);
-			}
+	update_noise_flow(cave, mon->grid);
+
+	/* Scan the doors, closing them */
+	doors = cave_class_grids(cave, (1 << GRID_CLASS_DOOR), &n);
+	for (i = 0; i < n; i++) {
+		struct loc grid = doors[i];
+		if (!square_in_bounds_fully(cave, grid)) continue;
+
+		/* If there is no player/monster in the square, and the door isn't
+		 * between the monster and the player */
+		if (!square_monster(cave, grid) &&
+			!((mon->grid.y <= grid.y) && (grid.y <= player->grid.y) &&
+			  (mon->grid.y <= grid.y) && (grid.y <= player->grid.y))) {
+			dist = 15 + flow_dist(cave->monster_noise, grid);
+			result = skill_check(source_monster(mon->midx), song_skill,
+								 dist, source_none());
+			square_set_door_lock(cave, grid, result);
 		}
-    }
+	}
+	mem_free(doors);
 
     /* Determine the player's resistance */
 	dist = flow_dist(cave->monster_noise, player->grid);
@@ -1210,8 +1213,7 @@ bool effect_handler_SONG_OF_OATHS(effect_handler_context_t *context)
 	int result, resistance = 15;
 
 	/* Use the monster noise flow to represent the song levels at each square */
-	cave->monster_noise.centre = mon->grid;
-    update_flow(cave, &cave->monster_noise, NULL);
+	update_noise_flow(cave, mon->grid);
 
 	/* Perform the skill check */
     result = skill_check(source_monster(mon->midx), song_skill, resistance,
@@ -1300,8 +1302,7 @@ bool effect_handler_NOISE(effect_handler_context_t *context)
 	bool player_centred = context->subtype ? true : false;
 	if (context->origin.what == SRC_MONSTER) {
 		struct monster *mon = cave_monster(cave, context->origin.which.monster);
-		cave->monster_noise.centre = mon->grid;
-		update_flow(cave, &cave->monster_noise, NULL);
+		update_noise_flow(cave, mon->grid);
 
 		/* Radius is used for monster making its own noise */
 		if (context->radius) mon->noise += context->radius;
@@ -1318,7 +1319,7 @@ bool effect_handler_CREATE_TRAPS(effect_handler_context_t *context)
 	int amount = effect_calculate_value(context);
 	while (amount--) {
 		struct loc grid;
-		cave_find(cave, &grid, square_isunseen);
+		cave_find_floor(cave, &grid, square_isunseen);
 		square_add_trap(cave, grid);
 	}
 	return true;
@@ -71,6 +71,7 @@ void free_effect(struct effect *source)
 	struct effect *e = source, *e_next;
 	while (e) {
 		e_next = e->next;
+		mem_free(e->code);
 		dice_free(e->dice);
 		if (e->msg) {
 			string_free(e->msg);
@@ -278,7 +279,7 @@ static int32_t effect_value_base_player_max_hp(void)
 static int32_t effect_value_base_player_will(void)
 {
 	int will = player->state.skill_use[SKILL_WILL];
-	if (player_active_ability(player, "Channeling")) {
+	if (player_active_ability(player, PA_CHANNELING)) {
 		will += 5;
 	}
 	return will;
@@ -323,6 +324,248 @@ expression_base_value_f effect_value_base_by_name(const char *name)
 	return NULL;
 }
 
+/**
+ * ------------------------------------------------------------------------
+ * Compiled effect chains
+ *
+ * The first time an effect chain is run it is lowered into a flat array of
+ * operations, with the effect handlers looked up, fixed dice parts folded to
+ * constants and expressions reduced to a base value call and arithmetic on
+ * an accumulator.  Running the array rolls the dice and calls the handlers
+ * in the same order, and with the same random numbers, as walking the chain.
+ * ------------------------------------------------------------------------ */
+/**
+ * Operations in a compiled effect chain
+ */
+enum {
+	EOP_END,	/* Stop */
+	EOP_BAD,	/* Reject an invalid effect */
+	EOP_SET,	/* Set part of the value to the operand */
+	EOP_BASE,	/* Load the accumulator from a base value function */
+	EOP_ADD,	/* Arithmetic on the accumulator */
+	EOP_MUL,
+	EOP_DIV,
+	EOP_NEG,
+	EOP_STORE,	/* Store the accumulator in part of the value */
+	EOP_ROLL,	/* Roll the value's dice, for the random numbers used */
+	EOP_CALL	/* Run the effect's handler */
+};
+
+struct effect_op {
+	uint8_t opcode;
+	uint8_t part;		/* Part of the value for EOP_SET and EOP_STORE */
+	bool set_ident;		/* Whether EOP_CALL passes back the handler's ident */
+	int32_t operand;
+	expression_base_value_f base;
+	effect_handler_f handler;
+	const struct effect *effect;
+};
+
+/**
+ * One handler call seen by effect_test_compiled()
+ */
+struct effect_trace {
+	uint16_t index;
+	random_value value;
+	bool set_ident;
+};
+
+#define EFFECT_TRACE_MAX 32
+
+static void set_value_part(random_value *value, int part, int32_t n)
+{
+	switch (part) {
+		case 0: value->base = n; break;
+		case 1: value->dice = n; break;
+		case 2: value->sides = n; break;
+		default: value->m_bonus = n; break;
+	}
+}
+
+static struct effect_op *add_op(struct effect_op **code, int *count,
+		int *size, int opcode)
+{
+	struct effect_op *op;
+
+	if (*count == *size) {
+		*size *= 2;
+		*code = mem_realloc(*code, *size * sizeof(**code));
+	}
+	op = &(*code)[(*count)++];
+	memset(op, 0, sizeof(*op));
+	op->opcode = opcode;
+	return op;
+}
+
+/**
+ * Lower an effect chain into a flat array of operations, ended by EOP_END.
+ */
+static struct effect_op *effect_compile(const struct effect *effect)
+{
+	static const uint8_t arith[] = {
+		EOP_END, EOP_ADD, EOP_ADD, EOP_MUL, EOP_DIV, EOP_NEG
+	};
+	int count = 0, size = 8;
+	struct effect_op *code = mem_alloc(size * sizeof(*code));
+	struct effect_op *op;
+	const struct effect *e;
+	bool first = true;
+
+	for (e = effect; e; e = e->next) {
+		if (!effect_valid(e)) {
+			add_op(&code, &count, &size, EOP_BAD);
+			break;
+		}
+
+		if (e->dice) {
+			int part, fixed[4];
+			bool constant = true;
+
+			for (part = 0; part < 4; part++) {
+				const expression_t *ex = dice_part(e->dice, part,
+					&fixed[part]);
+				size_t i, n;
+
+				if (ex && !expression_base_value(ex)) {
+					/* Nothing varies, so evaluate it now */
+					fixed[part] = expression_evaluate(ex);
+					ex = NULL;
+				}
+				if (!ex) {
+					op = add_op(&code, &count, &size, EOP_SET);
+					op->part = part;
+					op->operand = fixed[part];
+					continue;
+				}
+
+				constant = false;
+				op = add_op(&code, &count, &size, EOP_BASE);
+				op->base = expression_base_value(ex);
+				n = expression_operation_count(ex);
+				for (i = 0; i < n; i++) {
+					int16_t raw;
+					expression_operator_t oper =
+						expression_operation(ex, i, &raw);
+					int32_t operand = raw;
+
+					if (oper == OPERATOR_NONE || oper >= N_ELEMENTS(arith)) {
+						continue;
+					}
+
+					/* Subtractions become additions, and runs of them fold */
+					if (oper == OPERATOR_SUB) operand = -operand;
+					if (arith[oper] == EOP_ADD
+							&& code[count - 1].opcode == EOP_ADD) {
+						code[count - 1].operand += operand;
+						continue;
+					}
+					op = add_op(&code, &count, &size, arith[oper]);
+					op->operand = operand;
+				}
+				op = add_op(&code, &count, &size, EOP_STORE);
+				op->part = part;
+			}
+
+			/* Fixed dice that can't roll anything use no random numbers */
+			if (!constant || (fixed[1] > 0 && fixed[2] > 0)) {
+				add_op(&code, &count, &size, EOP_ROLL);
+			}
+		}
+
+		if (effects[e->index].handler) {
+			op = add_op(&code, &count, &size, EOP_CALL);
+			op->handler = effects[e->index].handler;
+			op->effect = e;
+
+			/* Don't identify by NOURISH unless it's the only effect */
+			op->set_ident = (e->index != EF_NOURISH) || (!e->next && first);
+			first = false;
+		}
+	}
+	add_op(&code, &count, &size, EOP_END);
+
+	return code;
+}
+
+/**
+ * Run a compiled effect chain; see effect_do() for the parameters.  If trace
+ * is not NULL, handler calls are recorded there instead of made.
+ */
+static bool effect_run(const struct effect_op *op, struct source origin,
+		struct object *obj, bool *ident, bool aware, int dir,
+		struct command *cmd, struct effect_trace *trace, int *n_trace)
+{
+	bool completed = false;
+	random_value value = { 0, 0, 0, 0 };
+	int32_t acc = 0;
+
+	for (;; op++) {
+		switch (op->opcode) {
+			case EOP_END:
+				return completed;
+			case EOP_BAD:
+				msg("Bad effect passed to effect_do(). Please report this bug.");
+				return false;
+			case EOP_SET:
+				set_value_part(&value, op->part, op->operand);
+				break;
+			case EOP_BASE:
+				acc = op->base();
+				break;
+			case EOP_ADD:
+				acc += op->operand;
+				break;
+			case EOP_MUL:
+				acc *= op->operand;
+				break;
+			case EOP_DIV:
+				acc /= op->operand;
+				break;
+			case EOP_NEG:
+				acc = -acc;
+				break;
+			case EOP_STORE:
+				set_value_part(&value, op->part, acc);
+				break;
+			case EOP_ROLL:
+				(void) damroll(value.dice, value.sides);
+				break;
+			case EOP_CALL: {
+				const struct effect *effect = op->effect;
+				effect_handler_context_t context = {
+					effect->index,
+					origin,
+					obj,
+					aware,
+					dir,
+					value,
+					effect->subtype,
+					effect->radius,
+					effect->other,
+					effect->msg,
+					*ident,
+					cmd
+				};
+
+				if (trace) {
+					if (*n_trace < EFFECT_TRACE_MAX) {
+						trace[*n_trace].index = effect->index;
+						trace[*n_trace].value = value;
+						trace[*n_trace].set_ident = op->set_ident;
+					}
+					(*n_trace)++;
+					break;
+				}
+				completed = op->handler(&context) || completed;
+				if (op->set_ident) {
+					*ident = context.ident;
+				}
+				break;
+			}
+		}
+	}
+}
+
 /**
  * ------------------------------------------------------------------------
  * Execution of effects
@@ -350,55 +593,94 @@ bool effect_do(struct effect *effect,
 		int dir,
 		struct command *cmd)
 {
-	bool completed = false;
-	bool first = true;
-	effect_handler_f handler;
-	random_value value = { 0, 0, 0, 0 };
+	if (!effect_valid(effect)) {
+		msg("Bad effect passed to effect_do(). Please report this bug.");
+		return false;
+	}
+
+	if (!effect->code) {
+		effect->code = effect_compile(effect);
+	}
+	return effect_run(effect->code, origin, obj, ident, aware, dir, cmd,
+		NULL, NULL);
+}
 
-	do {
-		int leftover = 1;
+/**
+ * Trace an effect chain the way effect_do() used to run it, by walking the
+ * chain and rolling each effect's dice, without calling the handlers.
+ */
+static int effect_trace_chain(const struct effect *effect,
+		struct effect_trace *trace, bool *bad)
+{
+	random_value value = { 0, 0, 0, 0 };
+	bool first = true;
+	int n = 0;
 
+	*bad = false;
+	for (; effect; effect = effect->next) {
 		if (!effect_valid(effect)) {
-			msg("Bad effect passed to effect_do(). Please report this bug.");
-			return false;
+			*bad = true;
+			break;
 		}
-
 		if (effect->dice != NULL)
 			(void) dice_roll(effect->dice, &value);
-
-		/* Handle the effect */
-		handler = effects[effect->index].handler;
-		if (handler != NULL) {
-			effect_handler_context_t context = {
-				effect->index,
-				origin,
-				obj,
-				aware,
-				dir,
-				value,
-				effect->subtype,
-				effect->radius,
-				effect->other,
-				effect->msg,
-				*ident,
-				cmd
-			};
-
-			completed = handler(&context) || completed;
-
-			/* Don't identify by NOURISH unless it's the only effect */
-			if ((effect->index != EF_NOURISH) || (!effect->next && first)) {
-				*ident = context.ident;
+		if (effects[effect->index].handler != NULL) {
+			if (n < EFFECT_TRACE_MAX) {
+				trace[n].index = effect->index;
+				trace[n].value = value;
+				trace[n].set_ident = (effect->index != EF_NOURISH)
+					|| (!effect->next && first);
 			}
+			n++;
 			first = false;
 		}
+	}
+	return n;
+}
 
-		/* Get the next effect, if there is one */
-		while (leftover-- && effect)
-			effect = effect->next;
-	} while (effect);
+/**
+ * Test that the compiled form of an effect chain makes the same handler
+ * calls, with the same values and random numbers, as walking the chain.
+ *
+ * \param effect is the effect chain
+ * \param seed is the seed for the quick random number generator
+ */
+bool effect_test_compiled(struct effect *effect, uint32_t seed)
+{
+	struct effect_trace expected[EFFECT_TRACE_MAX], got[EFFECT_TRACE_MAX];
+	bool old_quick = Rand_quick, bad, dummy = false;
+	uint32_t old_value = Rand_value, expected_rand;
+	struct effect_op *code = effect_compile(effect);
+	int n_expected, n_got = 0, i;
+	bool same = true;
+
+	Rand_quick = true;
+	Rand_value = seed;
+	n_expected = effect_trace_chain(effect, expected, &bad);
+	expected_rand = Rand_value;
+
+	Rand_value = seed;
+	if (bad) {
+		/* The bad effect message comes after any good effects */
+		struct effect_op *op = code;
+		while (op->opcode != EOP_BAD && op->opcode != EOP_END) op++;
+		same = op->opcode == EOP_BAD;
+		op->opcode = EOP_END;
+	}
+	(void) effect_run(code, source_none(), NULL, &dummy, true, 0, NULL, got,
+		&n_got);
+	same = same && (Rand_value == expected_rand) && (n_got == n_expected);
+	for (i = 0; same && i < MIN(n_got, EFFECT_TRACE_MAX); i++) {
+		same = (got[i].index == expected[i].index)
+			&& (got[i].set_ident == expected[i].set_ident)
+			&& !memcmp(&got[i].value, &expected[i].value,
+				sizeof(got[i].value));
+	}
 
-	return completed;
+	mem_free(code);
+	Rand_quick = old_quick;
+	Rand_value = old_value;
+	return same;
 }
 
 /**
@@ -437,5 +719,6 @@ void effect_simple(int index,
 	}
 
 	effect_do(&effect, origin, NULL, ident, true, dir, NULL);
+	mem_free(effect.code);
 	dice_free(effect.dice);
 }
@@ -52,6 +52,7 @@ bool effect_do(struct effect *effect,
 	bool aware,
 	int dir,
 	struct command *cmd);
+bool effect_test_compiled(struct effect *effect, uint32_t seed);
 void effect_simple(int index,
 	struct source origin,
 	const char *dice_string,
@@ -30,6 +30,18 @@ struct event_handler_entry
 
 static struct event_handler_entry *event_handlers[N_GAME_EVENTS];
 
+/**
+ * Map grids marked as changed but not yet passed on with EVENT_MAP, as the
+ * span of marked columns in each row; a row with x1 < 0 has none
+ */
+struct map_span {
+	int x0, x1;
+};
+
+static struct map_span *map_spans;
+static int map_span_rows;
+static int map_marked_top = -1, map_marked_bottom = -1;
+
 static void game_event_dispatch(game_event_type type, game_event_data *data)
 {
 	struct event_handler_entry *this = event_handlers[type];
@@ -107,6 +119,12 @@ void event_remove_all_handlers(void)
 	int type;
 	struct event_handler_entry *handler, *next;
 
+	mem_free(map_spans);
+	map_spans = NULL;
+	map_span_rows = 0;
+	map_marked_top = -1;
+	map_marked_bottom = -1;
+
 	for (type = 0; type < N_GAME_EVENTS; type++) {
 		handler = event_handlers[type];
 		while (handler) {
@@ -161,6 +179,90 @@ void event_signal_point(game_event_type type, int x, int y)
 }
 
 
+/**
+ * Mark a map grid as changed; marked grids are passed on together by
+ * event_flush_map()
+ */
+void event_mark_map(struct loc grid)
+{
+	struct map_span *span;
+
+	if (grid.x < 0 || grid.y < 0) return;
+
+	if (grid.y >= map_span_rows) {
+		int rows = MAX(grid.y + 1, 2 * map_span_rows), y;
+
+		map_spans = mem_realloc(map_spans, rows * sizeof(*map_spans));
+		for (y = map_span_rows; y < rows; y++) {
+			map_spans[y].x0 = INT_MAX;
+			map_spans[y].x1 = -1;
+		}
+		map_span_rows = rows;
+	}
+
+	span = &map_spans[grid.y];
+	span->x0 = MIN(span->x0, grid.x);
+	span->x1 = MAX(span->x1, grid.x);
+
+	if (map_marked_top < 0 || grid.y < map_marked_top) {
+		map_marked_top = grid.y;
+	}
+	map_marked_bottom = MAX(map_marked_bottom, grid.y);
+}
+
+/**
+ * Send EVENT_MAP for the grids marked since the last flush, one region for
+ * each run of rows with the same marked columns
+ */
+void event_flush_map(void)
+{
+	int top = map_marked_top, bottom = map_marked_bottom, y = top;
+
+	if (top < 0) return;
+	map_marked_top = -1;
+	map_marked_bottom = -1;
+
+	while (y <= bottom) {
+		struct map_span span = map_spans[y];
+		game_event_data data;
+
+		map_spans[y].x0 = INT_MAX;
+		map_spans[y].x1 = -1;
+		if (span.x1 < 0) {
+			y++;
+			continue;
+		}
+
+		data.region.top_left = loc(span.x0, y);
+		while (y < bottom && map_spans[y + 1].x0 == span.x0
+				&& map_spans[y + 1].x1 == span.x1) {
+			y++;
+			map_spans[y].x0 = INT_MAX;
+			map_spans[y].x1 = -1;
+		}
+		data.region.bottom_right = loc(span.x1, y);
+		y++;
+
+		game_event_dispatch(EVENT_MAP, &data);
+	}
+}
+
+/**
+ * Forget the marked grids, because the whole map is being redrawn or is
+ * about to be replaced
+ */
+void event_discard_map(void)
+{
+	int y;
+
+	for (y = map_marked_top; y >= 0 && y <= map_marked_bottom; y++) {
+		map_spans[y].x0 = INT_MAX;
+		map_spans[y].x1 = -1;
+	}
+	map_marked_top = -1;
+	map_marked_bottom = -1;
+}
+
 void event_signal_string(game_event_type type, const char *s)
 {
 	game_event_data data;
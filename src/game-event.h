@@ -126,6 +126,13 @@ typedef union
 {
 	struct loc point;
 
+	/* EVENT_MAP for a block of grids, unless the point is (-1, -1) */
+	struct
+	{
+		struct loc top_left;
+		struct loc bottom_right;
+	} region;
+
 	const char *string;
 
 	bool flag;
@@ -277,6 +284,9 @@ void event_signal_skillpoints(const int *points, const int *inc_points,
 	int remaining);
 
 void event_signal_point(game_event_type, int x, int y);
+void event_mark_map(struct loc grid);
+void event_flush_map(void);
+void event_discard_map(void);
 void event_signal_string(game_event_type, const char *s);
 void event_signal_message(game_event_type type, int t, const char *s);
 void event_signal_flag(game_event_type type, bool flag);
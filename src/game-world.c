@@ -36,6 +36,7 @@
 #include "player-quest.h"
 #include "player-timed.h"
 #include "player-util.h"
+#include "profile.h"
 #include "songs.h"
 #include "source.h"
 #include "target.h"
@@ -316,13 +317,19 @@ static void i_to_grid(int i, int w, struct loc *grid)
  *
  * Note that the noise is generated around the centre.
  * This is often the player, but can be a monster (for FLOW_MONSTER_NOISE)
+ *
+ * This is the straightforward version, one queue entry per grid; the game
+ * uses update_flow(), which gives the same results.
  */
-void update_flow(struct chunk *c, struct flow *flow, struct monster *mon)
+void update_flow_queue(struct chunk *c, struct flow *flow, struct monster *mon)
 {
 	struct loc next = flow->centre;
 	int y, x, d;
 	int value = 0;
-	struct queue *queue = q_new(c->height * c->width);
+	struct queue *queue;
+
+	PROFILE_START(update_flow);
+	queue = q_new(c->height * c->width);
 
 	/* Set all the grids to maximum */
 	for (y = 1; y < c->height - 1; y++) {
@@ -393,6 +400,280 @@ void update_flow(struct chunk *c, struct flow *flow, struct monster *mon)
 	}
 
 	q_free(queue);
+	PROFILE_STOP(update_flow);
+}
+
+/**
+ * Index of the lowest set bit of a non-zero word.
+ */
+static int flow_low_bit(uint64_t bits)
+{
+	static const uint8_t debruijn[64] = {
+		0, 1, 48, 2, 57, 49, 28, 3, 61, 58, 50, 42, 38, 29, 17, 4,
+		62, 55, 59, 36, 53, 51, 43, 22, 45, 39, 33, 30, 24, 18, 12, 5,
+		63, 47, 56, 27, 60, 41, 37, 16, 54, 35, 52, 21, 44, 32, 23, 11,
+		46, 26, 40, 15, 34, 20, 31, 10, 25, 14, 19, 9, 13, 8, 7, 6
+	};
+
+	return debruijn[((bits & (~bits + 1)) * 0x03f79d71b4cb0a89ULL) >> 58];
+}
+
+/**
+ * Calculate a flow, as update_flow_queue() does, a whole row at a time.
+ *
+ * A grid first reached while the grids at distance d are being expanded gets
+ * the value d plus its extra cost, whichever neighbour reaches it, so the
+ * grids reached at each step are those next to the grids expanded at that
+ * step, less those already reached or impassable.  The grids are kept as
+ * bitsets of 64 grids a word, so each step is a few shifts and ORs per row
+ * word.  Grids with no extra cost (most of them) are expanded at the next
+ * step; the few others (doors, rubble, glyphs and the like) wait on a list
+ * for the step matching their value, as they would on the queue.
+ *
+ * If heard is given, it gets a bit set (in the same layout, 64 grids a word)
+ * for every grid given a value, which is every grid whose monster had its
+ * target reset; some of those grids may still end up at z_info->flow_max.
+ */
+static void update_flow_aux(struct chunk *c, struct flow *flow,
+		struct monster *mon, uint64_t *heard)
+{
+	int w = c->width, h = c->height, words = (w + 63) / 64;
+	size_t size = (size_t) h * words * sizeof(uint64_t);
+	uint64_t *expand = mem_zalloc(size), *next = mem_zalloc(size);
+	uint64_t *reached = mem_zalloc(size), *known = mem_zalloc(size);
+	uint64_t *blocked = mem_zalloc(size), *spread = mem_zalloc(size);
+	uint64_t last_word = (w % 64) ? (((uint64_t) 1 << (w % 64)) - 1) : ~0ULL;
+	int16_t *cost = mem_alloc(h * w * sizeof(int16_t));
+	int *wait = mem_alloc(z_info->flow_max * sizeof(int));
+	int *wait_next = mem_alloc(h * w * sizeof(int));
+	bool *rows = mem_zalloc(h * sizeof(bool));
+	bool *next_rows = mem_zalloc(h * sizeof(bool));
+	int y, x, i, value, live = 0, waiting = 0;
+	struct loc centre = flow->centre;
+
+	PROFILE_START(update_flow);
+	for (value = 0; value < z_info->flow_max; value++) {
+		wait[value] = -1;
+	}
+
+	/* Set all the grids to maximum; the edges are left as they are */
+	for (y = 0; y < h; y++) {
+		for (x = 0; x < w; x++) {
+			if (y > 0 && y < h - 1 && x > 0 && x < w - 1) {
+				flow->grids[y][x] = z_info->flow_max;
+			} else if (flow->grids[y][x] < z_info->flow_max) {
+				reached[y * words + x / 64] |= (uint64_t) 1 << (x % 64);
+			}
+		}
+	}
+
+	if (loc_eq(centre, loc(0, 0))) {
+		quit("Flow has no centre!");
+	}
+
+	/* The centre is expanded first */
+	flow->grids[centre.y][centre.x] = 0;
+	reached[centre.y * words + centre.x / 64] |= (uint64_t) 1 << (centre.x % 64);
+	expand[centre.y * words + centre.x / 64] |= (uint64_t) 1 << (centre.x % 64);
+	rows[centre.y] = true;
+	live++;
+
+	/* Propagate outwards */
+	for (value = 1; value < z_info->flow_max; value++) {
+		uint64_t *swap;
+		bool *swap_rows;
+
+		/* Grids with extra cost whose turn has come */
+		for (i = wait[value]; i >= 0; i = wait_next[i]) {
+			expand[(i / w) * words + (i % w) / 64] |=
+				(uint64_t) 1 << ((i % w) % 64);
+			rows[i / w] = true;
+			live++;
+			waiting--;
+		}
+		if (!live && !waiting) break;
+
+		/* Spread the expanded grids sideways; rows with none are skipped */
+		for (y = 0; y < h; y++) {
+			uint64_t *row = expand + y * words, *out = spread + y * words;
+			if (!rows[y]) continue;
+			for (i = 0; i < words; i++) {
+				uint64_t left = (i > 0) ? row[i - 1] >> 63 : 0;
+				uint64_t right = (i < words - 1) ? row[i + 1] << 63 : 0;
+				out[i] = row[i] | (row[i] << 1) | left | (row[i] >> 1) | right;
+			}
+			out[words - 1] &= last_word;
+		}
+
+		/* Then up and down, to find the newly reached grids */
+		live = 0;
+		for (y = 0; y < h; y++) {
+			bool above = (y > 0) && rows[y - 1];
+			bool below = (y < h - 1) && rows[y + 1];
+
+			if (!rows[y] && !above && !below) continue;
+			for (i = 0; i < words; i++) {
+				int n = y * words + i;
+				uint64_t bits = rows[y] ? spread[n] : 0;
+
+				if (above) bits |= spread[n - words];
+				if (below) bits |= spread[n + words];
+				bits &= ~(reached[n] | blocked[n]);
+				if (!bits) continue;
+
+				/* Find the extra cost of grids not seen before */
+				while (bits & ~known[n]) {
+					uint64_t unseen = bits & ~known[n];
+					int b = flow_low_bit(unseen);
+					int g = y * w + i * 64 + b;
+					const struct square *sq = &c->squares[y][g % w];
+
+					/* Bare floor costs nothing extra, for noise or monsters */
+					known[n] |= (uint64_t) 1 << b;
+					if (sq->feat == FEAT_FLOOR && sq->mon <= 0 && !sq->trap) {
+						cost[g] = 0;
+					} else {
+						cost[g] = square_flow_cost(c, loc(g % w, y), mon);
+					}
+					if (cost[g] < 0) {
+						blocked[n] |= (uint64_t) 1 << b;
+						bits &= ~((uint64_t) 1 << b);
+					}
+				}
+
+				/* Save the flow values */
+				while (bits) {
+					int b = flow_low_bit(bits);
+					int g = y * w + i * 64 + b, f = value + cost[g];
+
+					bits &= bits - 1;
+					flow->grids[y][g % w] = f;
+					if (heard) heard[n] |= (uint64_t) 1 << b;
+					if (cost[g] == 0) {
+						/* Expanded at the next step */
+						reached[n] |= (uint64_t) 1 << b;
+						next[n] |= (uint64_t) 1 << b;
+						next_rows[y] = true;
+						live++;
+					} else if (f < z_info->flow_max) {
+						/* Expanded when the value is reached */
+						reached[n] |= (uint64_t) 1 << b;
+						wait_next[g] = wait[f];
+						wait[f] = g;
+						waiting++;
+					}
+
+					/* Monsters at this site need to re-consider their targets */
+					if (c->squares[y][g % w].mon > 0) {
+						struct monster *grid_mon = square_monster(c, loc(g % w, y));
+						if (grid_mon) grid_mon->target.grid = loc(0, 0);
+					}
+				}
+			}
+		}
+
+		/* Move on */
+		swap = expand;
+		expand = next;
+		next = swap;
+		swap_rows = rows;
+		rows = next_rows;
+		next_rows = swap_rows;
+		for (y = 0; y < h; y++) {
+			if (next_rows[y]) {
+				memset(next + y * words, 0, words * sizeof(uint64_t));
+				next_rows[y] = false;
+			}
+		}
+	}
+
+	mem_free(next_rows);
+	mem_free(rows);
+	mem_free(wait_next);
+	mem_free(wait);
+	mem_free(cost);
+	mem_free(spread);
+	mem_free(blocked);
+	mem_free(known);
+	mem_free(reached);
+	mem_free(next);
+	mem_free(expand);
+	PROFILE_STOP(update_flow);
+}
+
+/**
+ * Calculate a flow; see update_flow_aux()
+ */
+void update_flow(struct chunk *c, struct flow *flow, struct monster *mon)
+{
+	update_flow_aux(c, flow, mon, NULL);
+}
+
+/**
+ * Centre the monster noise flow on a grid.
+ *
+ * Noise only depends on the terrain, so the flows of the last few noise
+ * sources are kept and copied back while the terrain is unchanged; a fight
+ * full of shouts, songs and glowing weapons then needs one flow per source
+ * instead of one per sound.  Monsters reached by the noise still reconsider
+ * their targets, as update_flow() would have made them; which grids it
+ * reached is kept with each flow, as some of them are left at
+ * z_info->flow_max and can't be told apart by their value.
+ */
+void update_noise_flow(struct chunk *c, struct loc centre)
+{
+	struct flow *noise = &c->monster_noise;
+	struct flow *kept;
+	int words = (c->width + 63) / 64;
+	size_t size = (size_t) c->height * words * sizeof(uint64_t);
+	uint64_t *heard;
+	int i, y;
+
+	noise->centre = centre;
+	for (i = 0; i < NOISE_FLOW_CACHE; i++) {
+		kept = &c->noise_flows[i];
+		if ((c->noise_flow_stamp[i] == c->feat_stamp) &&
+			loc_eq(kept->centre, centre)) {
+			break;
+		}
+	}
+
+	if (i < NOISE_FLOW_CACHE) {
+		/* Heard before */
+		heard = c->noise_flow_heard[i];
+		for (y = 0; y < c->height; y++) {
+			memcpy(noise->grids[y], kept->grids[y],
+				c->width * sizeof(uint16_t));
+		}
+		for (i = 1; i < cave_monster_max(c); i++) {
+			struct monster *mon = cave_monster(c, i);
+			struct loc grid = mon->grid;
+
+			if (!mon->race) continue;
+			if (heard[grid.y * words + grid.x / 64]
+					& ((uint64_t) 1 << (grid.x % 64))) {
+				mon->target.grid = loc(0, 0);
+			}
+		}
+		return;
+	}
+
+	/* A new source, which replaces the oldest kept one */
+	i = c->noise_flow_next;
+	kept = &c->noise_flows[i];
+	if (!kept->grids) flow_new(c, kept);
+	if (!c->noise_flow_heard[i]) {
+		c->noise_flow_heard[i] = mem_alloc(size);
+	}
+	heard = c->noise_flow_heard[i];
+	memset(heard, 0, size);
+	update_flow_aux(c, noise, NULL, heard);
+	for (y = 0; y < c->height; y++) {
+		memcpy(kept->grids[y], noise->grids[y], c->width * sizeof(uint16_t));
+	}
+	kept->centre = centre;
+	c->noise_flow_stamp[i] = c->feat_stamp;
+	c->noise_flow_next = (i + 1) % NOISE_FLOW_CACHE;
 }
 
 /**
@@ -403,6 +684,56 @@ int flow_dist(struct flow flow, struct loc grid)
 	return flow.grids[grid.y][grid.x];
 }
 
+/**
+ * Which of the 25 grids of the scent stamp are in line of sight of its centre,
+ * indexed by the pattern of walls around the centre.  Lines of sight that
+ * short only ever pass through the eight grids next to the centre, so their
+ * pattern settles every one of them.
+ */
+static uint32_t scent_los_mask[256];
+static bool scent_los_known[256];
+
+/**
+ * Get the grids of the 5x5 scent stamp centred on 'centre' which are in line
+ * of sight of it, as bit (y * 5 + x) for stamp offset (x - 2, y - 2)
+ */
+static uint32_t scent_los(struct chunk *c, struct loc centre)
+{
+	struct loc offset = loc(2, 2);
+	bool whole = square_in_bounds(c, loc_diff(centre, offset)) &&
+		square_in_bounds(c, loc_sum(centre, offset));
+	uint32_t mask = 0;
+	int pattern = 0;
+	int d, y, x;
+
+	for (d = 0; d < 8; d++) {
+		struct loc grid = loc_sum(centre, ddgrid_ddd[d]);
+
+		if (!square_in_bounds(c, grid) || !square_isprojectable(c, grid)) {
+			pattern |= 1 << d;
+		}
+	}
+
+	/* Seen this pattern before */
+	if (whole && scent_los_known[pattern]) return scent_los_mask[pattern];
+
+	/* Work it out, remembering it unless the stamp is cut off by the edge */
+	for (y = 0; y < 5; y++) {
+		for (x = 0; x < 5; x++) {
+			struct loc grid = loc(centre.x + x - 2, centre.y + y - 2);
+
+			if (!square_in_bounds(c, grid)) continue;
+			if (los(c, centre, grid)) mask |= 1 << (y * 5 + x);
+		}
+	}
+	if (whole) {
+		scent_los_mask[pattern] = mask;
+		scent_los_known[pattern] = true;
+	}
+
+	return mask;
+}
+
 /**
  * Characters leave scent trails for perceptive monsters to track.
  *
@@ -411,13 +742,13 @@ int flow_dist(struct flow flow, struct loc grid)
  * current position, and monsters can use it to home in the character,
  * but not to run away.
  *
- * Scent is valued according to age.  When a character takes his turn,
- * scent is aged by one, and new scent of the current age is laid down.
- * Speedy characters leave more scent, true, but it also ages faster,
- * which makes it harder to hunt them down.
+ * Scent is valued according to age.  Each time a character takes his turn,
+ * the scent clock ticks and new scent is laid down, stamped with the time
+ * it was laid less its strength.  Speedy characters leave more scent, true,
+ * but it also ages faster, which makes it harder to hunt them down.
  *
- * Whenever the age count loops, most of the scent trail is erased and
- * the age of the remainder is recalculated.
+ * The age of scent is worked out from its stamp when it is read, so old
+ * scent never has to be cleared away.
  */
 static void update_scent(void)
 {
@@ -429,54 +760,32 @@ static void update_scent(void)
 		{  2, 1, 1, 1,   2},
 		{250, 2, 2, 2, 250},
 	};
+	uint32_t in_los = scent_los(cave, player->grid);
 
 	/* Scent becomes "younger" */
-	cave->scent_age--;
-
-	/* Loop the age and adjust scent values when necessary */
-	if (cave->scent_age <= 0) {
-		/* Update scent for all grids */
-		for (y = 1; y < cave->height - 1; y++) {
-			for (x = 1; x < cave->width - 1; x++) {
-				/* Ignore non-existent scent */
-				if (cave->scent.grids[y][x] == 0) continue;
-
-				/* Erase the earlier part of the previous cycle */
-				if (cave->scent.grids[y][x] > SMELL_STRENGTH) {
-					cave->scent.grids[y][x] = 0;
-				} else {
-					/* Reset the ages of the most recent scent */
-					cave->scent.grids[y][x] += 250 - SMELL_STRENGTH;
-				}
-			}
-		}
-
-		/* Reset the age value */
-		cave->scent_age = 250 - SMELL_STRENGTH;
-	}
+	cave->scent_turn++;
 
 	/* Lay down new scent around the player */
 	for (y = 0; y < 5; y++) {
 		for (x = 0; x < 5; x++) {
 			struct loc scent;
-			int new_scent = scent_strength[y][x];
+
+			/* Note grids that are too far away */
+			if (scent_strength[y][x] == 250) continue;
+
+			/* Grid must not be blocked by walls from the character */
+			if (!(in_los & (1 << (y * 5 + x)))) continue;
 
 			/* Initialize */
 			scent.y = y + player->grid.y - 2;
 			scent.x = x + player->grid.x - 2;
 
-			/* Ignore invalid or non-scent-carrying grids */
-			if (!square_in_bounds(cave, scent)) continue;
+			/* Ignore non-scent-carrying grids */
 			if (square_isnoscent(cave, scent)) continue;
 
-			/* Grid must not be blocked by walls from the character */
-			if (!los(cave, player->grid, loc(x, y))) continue;
-
-			/* Note grids that are too far away */
-			if (scent_strength[y][x] == 250) continue;
-
-			/* Mark the scent */
-			cave->scent.grids[scent.y][scent.x] = cave->scent_age + new_scent;
+			/* Mark the scent; the offset keeps stamps from being zero */
+			cave->scent[scent.y * cave->width + scent.x] =
+				cave->scent_turn + SMELL_STRENGTH - scent_strength[y][x];
 		}
 	}
 }
@@ -488,25 +797,24 @@ static void update_scent(void)
  */
 int get_scent(struct chunk *c, struct loc grid)
 {
-	int age;
-	int scent;
+	uint32_t stamp, age;
 
 	/* Check Bounds */
 	if (!square_in_bounds(c, grid)) return -1;
 
 	/* Sent trace? */
-	scent = c->scent.grids[grid.y][grid.x];
+	stamp = c->scent[grid.y * c->width + grid.x];
 
 	/* No scent at all */
-	if (!c->scent.grids[grid.y][grid.x]) return -1;
+	if (!stamp) return -1;
 
 	/* Get age of scent */
-	age = scent - c->scent_age;
+	age = c->scent_turn + SMELL_STRENGTH - stamp;
 
 	if (age > SMELL_STRENGTH) return -1;
 
 	/* Return the age of the scent */
-	return age;
+	return (int) age;
 }
 
 /**
@@ -914,6 +1222,9 @@ void on_new_level(void)
 {
 	int i;
 
+	/* Forget map changes that may belong to the last level */
+	event_discard_map();
+
 	/* Update noise and scent */
 	cave->player_noise.centre = player->grid;
 	update_flow(cave, &cave->player_noise, NULL);
@@ -977,6 +1288,7 @@ static void on_leave_level(void) {
 	notice_stuff(player);
 	update_stuff(player);
 	redraw_stuff(player);
+	event_discard_map();
 
 	/* Flush messages */
 	event_signal(EVENT_MESSAGE_FLUSH);
@@ -56,7 +56,9 @@ int turn_energy(int speed);
 int regen_amount(int turn_number, int max, int period);
 int health_level(int current, int max);
 void play_ambient_sound(void);
+void update_flow_queue(struct chunk *c, struct flow *flow, struct monster *mon);
 void update_flow(struct chunk *c, struct flow *flow, struct monster *mon);
+void update_noise_flow(struct chunk *c, struct loc centre);
 int flow_dist(struct flow flow, struct loc grid);
 int get_scent(struct chunk *c, struct loc grid);
 void process_world(struct chunk *c);
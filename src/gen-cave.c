@@ -93,24 +93,71 @@ static bool player_pass(struct chunk *c, struct loc grid, bool ignore_rubble)
 }
 
 /**
- * Floodfills access through the dungeon, marking all accessible squares true
+ * Find the representative of the set containing element i in a disjoint set
+ * forest, shortening the path as we go
  */
-static void flood_access(struct chunk *c, struct loc grid, bool **access,
-						 bool ignore_rubble)
+static int set_find(int *parent, int i)
 {
-	int i;
+	while (parent[i] != i) {
+		parent[i] = parent[parent[i]];
+		i = parent[i];
+	}
+	return i;
+}
 
-	/* First check the map bounds */
-	if (!square_in_bounds(c, grid)) return;
-	
-	access[grid.y][grid.x] = true;
-	for (i = 0; i < 8; i++) {
-		struct loc check = loc_sum(grid, ddgrid_ddd[i]);
-		if (player_pass(c, check, ignore_rubble) && !access[check.y][check.x]) {
-			flood_access(c, check, access, ignore_rubble);
+/**
+ * Merge the sets containing elements i and j in a disjoint set forest
+ */
+static void set_union(int *parent, int i, int j)
+{
+	i = set_find(parent, i);
+	j = set_find(parent, j);
+	if (i < j) {
+		parent[j] = i;
+	} else if (j < i) {
+		parent[i] = j;
+	}
+}
+
+/**
+ * Label the connected areas of the dungeon, so that two grids the player
+ * can pass between have the same representative in the returned forest.
+ *
+ * Each grid is joined with the neighbours already scanned, so one pass over
+ * the map does the job of a flood fill from every grid.  The player's grid
+ * is always counted as passable, since that's where any flood would start.
+ */
+static int *label_access(struct chunk *c, bool ignore_rubble)
+{
+	int *parent = mem_alloc(c->height * c->width * sizeof(int));
+	struct loc grid;
+
+	for (grid.y = 0; grid.y < c->height; grid.y++) {
+		for (grid.x = 0; grid.x < c->width; grid.x++) {
+			int n = grid.y * c->width + grid.x, i;
+
+			parent[n] = n;
+			if (!player_pass(c, grid, ignore_rubble) &&
+				!loc_eq(grid, player->grid)) {
+				continue;
+			}
+
+			/* Neighbours to the west, northwest, north and northeast */
+			for (i = 0; i < 4; i++) {
+				static const struct loc back[4] = {
+					{ -1, 0 }, { -1, -1 }, { 0, -1 }, { 1, -1 }
+				};
+				struct loc check = loc_sum(grid, back[i]);
+				if (!square_in_bounds(c, check)) continue;
+				if (player_pass(c, check, ignore_rubble) ||
+					loc_eq(check, player->grid)) {
+					set_union(parent, n, check.y * c->width + check.x);
+				}
+			}
 		}
 	}
-	return;
+
+	return parent;
 }
 
 /**
@@ -124,35 +171,29 @@ static bool check_connectivity(struct chunk *c)
 {
 	struct loc grid;
 	bool result = false;
-
-	/* Set the array used for checking connectivity */
-	bool **access = mem_zalloc(c->height * sizeof(bool*));
-	for (grid.y = 0; grid.y < c->height; grid.y++) {
-		access[grid.y] = mem_zalloc(c->width  * sizeof(bool));
-	}
+	int *access;
+	int start;
 
 	/* Make sure entire dungeon is connected (ignoring rubble) */
-	flood_access(c, player->grid, access, true);
+	access = label_access(c, true);
+	start = set_find(access, player->grid.y * c->width + player->grid.x);
 	for (grid.y = 0; grid.y < c->height; grid.y++) {
 		for (grid.x = 0; grid.x < c->width; grid.x++) {
-			if (player_pass(c, grid, true) && !access[grid.y][grid.x]) {
+			int n = grid.y * c->width + grid.x;
+			if (player_pass(c, grid, true) && (set_find(access, n) != start)) {
 				goto CLEANUP;
 			}
 		}
 	}
+	mem_free(access);
 
-	/* Reset the array used for checking connectivity */
-	for (grid.y = 0; grid.y < c->height; grid.y++) {
-		for (grid.x = 0; grid.x < c->width; grid.x++) {
-			access[grid.y][grid.x] = false;
-		}
-	}
-	
 	/* Make sure player can reach stairs without going through rubble */
-	flood_access(c, player->grid, access, false);
+	access = label_access(c, false);
+	start = set_find(access, player->grid.y * c->width + player->grid.x);
 	for (grid.y = 0; grid.y < c->height; grid.y++) {
 		for (grid.x = 0; grid.x < c->width; grid.x++) {
-			if (access[grid.y][grid.x] && square_isstairs(c, grid)) {
+			int n = grid.y * c->width + grid.x;
+			if (square_isstairs(c, grid) && (set_find(access, n) == start)) {
 				result = true;
 				goto CLEANUP;
 			}
@@ -160,53 +201,39 @@ static bool check_connectivity(struct chunk *c)
 	}
 
 CLEANUP:
-	for (grid.y = 0; grid.y < c->height; grid.y++) {
-		mem_free(access[grid.y]);
-	}
 	mem_free(access);
 
 	return result;
 }
 
 /**
- * Floodfills access through the *graph* of the dungeon
+ * Record that two rooms have been connected, merging their dungeon pieces
  */
-static void flood_piece(int n, int piece_num)
+static void join_rooms(int r1, int r2)
 {
-	int i;
-
-	dun->piece[n] = piece_num;
+	/* Tunnels not built between rooms are marked as room -1 */
+	if ((r1 < 0) || (r2 < 0)) return;
 
-	for (i = 0; i < dun->cent_n; i++) {
-		if (dun->connection[n][i] && (dun->piece[i] == 0)) {
-			flood_piece(i, piece_num);
-		}
-	}
-	return;
+	dun->connection[r1][r2] = true;
+	dun->connection[r2][r1] = true;
+	set_union(dun->piece_parent, r1, r2);
 }
 
+/**
+ * Label each room with the dungeon piece it is in, and count the pieces
+ */
 static int dungeon_pieces(void)
 {
-	int piece_num;
+	int pieces = 0;
 	int i;
 
-	/* First reset the pieces */
 	for (i = 0; i < dun->cent_n; i++) {
-		dun->piece[i] = 0;
-	}
-
-	for (piece_num = 1; piece_num <= dun->cent_n; piece_num++) {
-		/* Find the next room that doesn't belong to a piece */
-		for (i = 0; (i < dun->cent_n) && (dun->piece[i] != 0); i++);
-
-		if (i == dun->cent_n) {
-			break;
-		} else {
-			flood_piece(i, piece_num);
-		}
+		int root = set_find(dun->piece_parent, i);
+		dun->piece[i] = root + 1;
+		if (root == i) pieces++;
 	}
 
-	return (piece_num - 1);
+	return pieces;
 }
 
 /**
@@ -820,8 +847,7 @@ static bool connect_two_rooms(struct chunk *c, int r1, int r2, bool tentative,
 	}
 	
 	if (success) {
-		dun->connection[r1][r2] = true;
-		dun->connection[r2][r1] = true;	
+		join_rooms(r1, r2);
 	}
 	
 	return success;
@@ -874,10 +900,8 @@ static bool connect_room_to_corridor(struct chunk *c, int r)
 						TUNNEL_ROOM_TO_CORRIDOR);
 
 					/* Mark the new room connections */
-					dun->connection[r][r1] = true;
-					dun->connection[r1][r] = true;
-					dun->connection[r][r2] = true;
-					dun->connection[r2][r] = true;
+					join_rooms(r, r1);
+					join_rooms(r, r2);
 					success = true;
 				}
 			}
@@ -1180,7 +1204,7 @@ struct chunk *cave_gen(struct player *p)
 		int count = 100;
 
 		/* Find a suitable place */
-		while (cave_find(c, &grid, square_suits_start) && count--) {
+		while (cave_find_floor(c, &grid, square_suits_start) && count--) {
 			/* Out of sight of the player */
 			if (!los(c, p->grid, grid)) {
 				struct monster_group_info info = {0, 0};
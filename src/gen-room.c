@@ -51,38 +51,81 @@
  * ------------------------------------------------------------------------
  * Selection of random templates
  * ------------------------------------------------------------------------ */
+/**
+ * Check for a greater vault the player has already seen, which can't be
+ * chosen again
+ */
+static bool vault_is_used(const struct vault *v)
+{
+	return streq(v->typ, "Greater vault") && player->vaults[v->index];
+}
+
 /**
  * Chooses a vault of a particular kind at random.
  * \param depth the current depth, for vault bound checking
  * \param typ vault type
+ * \param forge whether the vault must contain a forge
  * \return a pointer to the vault template
  */
 struct vault *random_vault(int depth, const char *typ, bool forge)
 {
-	struct vault *v = vaults;
-	struct vault *r = NULL;
-	uint32_t rarity_sum = 0;
-	do {
-		if (streq(v->typ, typ) && (v->depth <= depth)) {
-			bool valid = v->rarity > 0;
-			/* Check if we need a forge and don't have one */
-			if (forge && !v->forge) {
-				valid = false;
-			}
-
-			/* Check if it's a greater vault we've already seen */
-			if (streq(v->typ, "Greater vault") && player->vaults[v->index]) {
-				valid = false;
-			}
+	const struct vault_list *list;
+	struct vault *v;
+	uint32_t pick, rarity_sum = 0;
+	int lo, hi, n, i;
 
-			if (valid) {
-				rarity_sum += v->rarity;
-				if (Rand_div(rarity_sum) < v->rarity) r = v;
-			}
+	for (list = vault_lists; list; list = list->next) {
+		if ((list->forge == forge) && streq(list->typ, typ)) break;
+	}
+	if (!list) return NULL;
+
+	/* The list is sorted by depth, so the ones allowed here come first */
+	lo = 0;
+	hi = list->count;
+	while (lo < hi) {
+		int mid = (lo + hi) / 2;
+		if (list->vaults[mid]->depth <= depth) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	n = lo;
+	if (!n) return NULL;
+
+	/* Choose by rarity using the running totals */
+	pick = Rand_div(list->total[n - 1]);
+	lo = 0;
+	hi = n - 1;
+	while (lo < hi) {
+		int mid = (lo + hi) / 2;
+		if (list->total[mid] > pick) {
+			hi = mid;
+		} else {
+			lo = mid + 1;
 		}
-		v = v->next;
-	} while(v);
-	return r;
+	}
+	v = list->vaults[lo];
+	if (!vault_is_used(v)) return v;
+
+	/*
+	 * Choose again from the vaults still available; together with the
+	 * first choice this keeps every one's chance in proportion to its rarity
+	 */
+	for (i = 0; i < n; i++) {
+		if (!vault_is_used(list->vaults[i])) {
+			rarity_sum += list->vaults[i]->rarity;
+		}
+	}
+	if (!rarity_sum) return NULL;
+	pick = Rand_div(rarity_sum);
+	for (i = 0; i < n; i++) {
+		v = list->vaults[i];
+		if (vault_is_used(v)) continue;
+		if (pick < v->rarity) return v;
+		pick -= v->rarity;
+	}
+	return NULL;
 }
 
 
@@ -308,6 +351,29 @@ void set_marked_granite(struct chunk *c, struct loc grid, int flag)
 	if (flag) generate_mark(c, grid.y, grid.x, grid.y, grid.x, flag);
 }
 
+/**
+ * Find where a cell of a vault goes in the chunk
+ * \param v pointer to the vault template
+ * \param cell the cell
+ * \param centre the room centre
+ * \param flip whether to flip the vault diagonally
+ * \param flip_v whether to reflect the vault vertically
+ * \param flip_h whether to reflect the vault horizontally
+ */
+static struct loc vault_cell_grid(const struct vault *v,
+		const struct vault_cell *cell, struct loc centre, bool flip,
+		bool flip_v, bool flip_h)
+{
+	int ay = flip_v ? v->hgt - 1 - cell->y : cell->y;
+	int ax = flip_h ? v->wid - 1 - cell->x : cell->x;
+
+	/* Flip diagonally if requested */
+	if (flip) {
+		return loc(centre.x - (v->hgt / 2) + ay, centre.y - (v->wid / 2) + ax);
+	}
+	return loc(centre.x - (v->wid / 2) + ax, centre.y - (v->hgt / 2) + ay);
+}
+
 /**
  * Build a vault from its string representation.
  * \param c the chunk the room is being built in
@@ -317,27 +383,15 @@ void set_marked_granite(struct chunk *c, struct loc grid, int flag)
  */
 bool build_vault(struct chunk *c, struct loc centre, struct vault *v, bool flip)
 {
-	const char *data = v->text;
-	int x, y;
-	const char *t;
+	int i;
 	bool flip_v = false;
 	bool flip_h = false;
 
 	assert(c);
 
 	/* Check that the vault doesn't contain invalid things for its depth */
-	for (t = data, y = 0; y < v->hgt; y++) {	
-		for (x = 0; x < v->wid; x++, t++) {
-			/* Barrow wights can't be deeper than level 12 */
-			if ((*t == 'W') && (c->depth > 12)) {
-				return false;
-			}
-
-            /* Chasms can't occur at 950 ft */
-			if ((*t == '7') && (c->depth >= z_info->dun_depth - 1)) {
-				return false;
-			}
-		}
+	if (c->depth > v->max_depth) {
+		return false;
 	}
 
     /* Reflections */
@@ -349,415 +403,369 @@ bool build_vault(struct chunk *c, struct loc centre, struct vault *v, bool flip)
     }
 
 	/* Place dungeon features and objects */
-	for (t = data, y = 0; y < v->hgt && *t; y++) {
-		int ay = flip_v ? v->hgt - 1 - y : y;
-		for (x = 0; x < v->wid && *t; x++, t++) {
-			int ax = flip_h ? v->wid - 1 - x : x;
-			struct loc grid;
-
-			/* Extract the location, flipping diagonally if requested */
-            if (flip) {
-                grid.x = centre.x - (v->hgt / 2) + ay;
-                grid.y = centre.y - (v->wid / 2) + ax;
-            } else {
-				grid.x = centre.x - (v->wid / 2) + ax;
-				grid.y = centre.y - (v->hgt / 2) + ay;
-			}
-
-			/* Skip non-grids */
-			if (*t == ' ') continue;
+	for (i = 0; i < v->n_cells; i++) {
+		struct loc grid = vault_cell_grid(v, &v->cells[i], centre, flip,
+			flip_v, flip_h);
+
+		/* Lay down a floor */
+		square_set_feat(c, grid, FEAT_FLOOR);
+
+		/* Debugging assertion */
+		assert(square_isempty(c, grid));
+
+		/* Part of a vault */
+		sqinfo_on(square(c, grid)->info, SQUARE_ROOM);
+		sqinfo_on(square(c, grid)->info, SQUARE_VAULT);
+
+		/* Analyze the grid */
+		switch (v->cells[i].sym) {
+			/* Outer outside granite wall */
+		case '$': set_marked_granite(c, grid, SQUARE_WALL_OUTER); break;
+			/* Inner or non-tunnelable outside granite wall */
+		case '#': set_marked_granite(c, grid, SQUARE_WALL_INNER); break;
+			/* Quartz vein */
+		case '%': square_set_feat(c, grid, FEAT_QUARTZ); break;
+			/* Rubble */
+		case ':': square_set_feat(c, grid, FEAT_RUBBLE); break;
+			/* Glyph of warding */
+		case ';': square_add_glyph(c, grid, GLYPH_WARDING); break;
+			/* Stairs */
+		case '<': square_set_feat(c, grid, FEAT_LESS); break;
+		case '>': square_set_feat(c, grid, FEAT_MORE); break;
+			/* Visible door */
+		case '+': place_closed_door(c, grid); break;
+			/* Secret door */
+		case 's': place_secret_door(c, grid); break;
+			/* Trap */
+		case '^': if (one_in_(2)) square_add_trap(c, grid); break;
+			/* Forge */
+		case '0': place_forge(c, grid); break;
+			/* Chasm */
+		case '7': square_set_feat(c, grid, FEAT_CHASM); break;
 
-			/* Lay down a floor */
-			square_set_feat(c, grid, FEAT_FLOOR);
+		}
+	}
 
-			/* Debugging assertion */
-			assert(square_isempty(c, grid));
 
-			/* Part of a vault */
-			sqinfo_on(square(c, grid)->info, SQUARE_ROOM);
-			sqinfo_on(square(c, grid)->info, SQUARE_VAULT);
-
-			/* Analyze the grid */
-			switch (*t) {
-				/* Outer outside granite wall */
-			case '$': set_marked_granite(c, grid, SQUARE_WALL_OUTER); break;
-				/* Inner or non-tunnelable outside granite wall */
-			case '#': set_marked_granite(c, grid, SQUARE_WALL_INNER); break;
-				/* Quartz vein */
-			case '%': square_set_feat(c, grid, FEAT_QUARTZ); break;
-				/* Rubble */
-			case ':': square_set_feat(c, grid, FEAT_RUBBLE); break;
-				/* Glyph of warding */
-			case ';': square_add_glyph(c, grid, GLYPH_WARDING); break;
-				/* Stairs */
-			case '<': square_set_feat(c, grid, FEAT_LESS); break;
-			case '>': square_set_feat(c, grid, FEAT_MORE); break;
-				/* Visible door */
-			case '+': place_closed_door(c, grid); break;
-				/* Secret door */
-			case 's': place_secret_door(c, grid); break;
-				/* Trap */
-			case '^': if (one_in_(2)) square_add_trap(c, grid); break;
-				/* Forge */
-			case '0': place_forge(c, grid); break;
-				/* Chasm */
-			case '7': square_set_feat(c, grid, FEAT_CHASM); break;
+	/* Place regular dungeon monsters and objects */
+	for (i = 0; i < v->n_cells; i++) {
+		struct loc grid = vault_cell_grid(v, &v->cells[i], centre, flip,
+			flip_v, flip_h);
+		struct monster_group_info info = { 0, 0 };
+
+		/* Analyze the symbol */
+		switch (v->cells[i].sym)
+		{
+			/* A monster from 1 level deeper */
+			case '1': {
+				pick_and_place_monster(c, grid, c->depth + 1, true, true,
+										   ORIGIN_DROP_VAULT);
+				break;
+			}
 
+			/* A monster from 2 levels deeper */
+			case '2': {
+				pick_and_place_monster(c, grid, c->depth + 2, true, true,
+										   ORIGIN_DROP_VAULT);
+				break;
 			}
-		}
-	}
 
+			/* A monster from 3 levels deeper */
+			case '3': {
+				pick_and_place_monster(c, grid, c->depth + 3, true, true,
+										   ORIGIN_DROP_VAULT);
+				break;
+			}
 
-	/* Place regular dungeon monsters and objects */
-	for (t = data, y = 0; y < v->hgt && *t; y++) {
-		int ay = flip_v ? v->hgt - 1 - y : y;
-		for (x = 0; x < v->wid && *t; x++, t++) {
-			int ax = flip_h ? v->wid - 1 - x : x;
-			struct loc grid;
-			struct monster_group_info info = { 0, 0 };
-
-			/* Extract the location, flipping diagonally if requested */
-            if (flip) {
-                grid.x = centre.x - (v->hgt / 2) + ay;
-                grid.y = centre.y - (v->wid / 2) + ax;
-            } else {
-				grid.x = centre.x - (v->wid / 2) + ax;
-				grid.y = centre.y - (v->hgt / 2) + ay;
+			/* A monster from 4 levels deeper */
+			case '4': {
+				pick_and_place_monster(c, grid, c->depth + 4, true, true,
+										   ORIGIN_DROP_VAULT);
+				break;
 			}
 
-			/* Hack -- skip "non-grids" */
-			if (*t == ' ') continue;
-
-			/* Analyze the symbol */
-			switch (*t)
-			{
-				/* A monster from 1 level deeper */
-				case '1': {
-					pick_and_place_monster(c, grid, c->depth + 1, true, true,
-											   ORIGIN_DROP_VAULT);
-					break;
-				}
+			/* An object from 1-4 levels deeper */
+			case '*': {
+				place_object(c, grid, c->depth + randint1(4), false, false,
+							 ORIGIN_VAULT, lookup_drop("not useless"));
+				break;
+			}
 
-				/* A monster from 2 levels deeper */
-				case '2': {
-					pick_and_place_monster(c, grid, c->depth + 2, true, true,
-											   ORIGIN_DROP_VAULT);
-					break;
-				}
+			/* A good object from 1-4 levels deeper */
+			case '&': {
+				place_object(c, grid, c->depth + randint1(4), true, false,
+							 ORIGIN_VAULT, lookup_drop("not useless"));
+				break;
+			}
 
-				/* A monster from 3 levels deeper */
-				case '3': {
-					pick_and_place_monster(c, grid, c->depth + 3, true, true,
-											   ORIGIN_DROP_VAULT);
-					break;
-				}
+			/* A chest from 4 levels deeper */
+			case '~': {
+				int depth = c->depth ? c->depth + 4 : z_info->dun_depth;
+				place_object(c, grid, depth, false, false,
+							 ORIGIN_VAULT, lookup_drop("chest"));
+				break;
+			}
 
-				/* A monster from 4 levels deeper */
-				case '4': {
-					pick_and_place_monster(c, grid, c->depth + 4, true, true,
-											   ORIGIN_DROP_VAULT);
-					break;
-				}
+			/* A skeleton */
+			case 'S': {
+				/* Make a skeleton 1/2 of the time */
+				if (one_in_(2)) {
+					struct object *obj = object_new();
+					int sval;
+					struct object_kind *kind;
+
+					if (one_in_(3)) {
+						sval = lookup_sval(TV_USELESS, "Human Skeleton");
+					} else {
+						sval = lookup_sval(TV_USELESS, "Elf Skeleton");
+					}
+					kind = lookup_kind(TV_USELESS, sval);
 
-				/* An object from 1-4 levels deeper */
-				case '*': {
-					place_object(c, grid, c->depth + randint1(4), false, false,
-								 ORIGIN_VAULT, lookup_drop("not useless"));
-					break;
-				}
+					/* Prepare the item */
+					object_prep(obj, kind, c->depth, RANDOMISE);
 
-				/* A good object from 1-4 levels deeper */
-				case '&': {
-					place_object(c, grid, c->depth + randint1(4), true, false,
-								 ORIGIN_VAULT, lookup_drop("not useless"));
-					break;
+					/* Drop it in the dungeon */
+					drop_near(c, &obj, 0, grid, false, false);
 				}
+				break;
+			}
 
-				/* A chest from 4 levels deeper */
-				case '~': {
-					int depth = c->depth ? c->depth + 4 : z_info->dun_depth;
-					place_object(c, grid, depth, false, false,
-								 ORIGIN_VAULT, lookup_drop("chest"));
-					break;
+			/* Monster and/or object from 1 level deeper */
+			case '?': {
+				int r = randint1(3);
+				
+				if (r <= 2) {
+					pick_and_place_monster(c, grid, c->depth + 1, true,
+										   true, ORIGIN_DROP_VAULT);
 				}
-
-				/* A skeleton */
-				case 'S': {
-					/* Make a skeleton 1/2 of the time */
-					if (one_in_(2)) {
-						struct object *obj = object_new();
-						int sval;
-						struct object_kind *kind;
-
-						if (one_in_(3)) {
-							sval = lookup_sval(TV_USELESS, "Human Skeleton");
-						} else {
-							sval = lookup_sval(TV_USELESS, "Elf Skeleton");
-						}
-						kind = lookup_kind(TV_USELESS, sval);
-
-						/* Prepare the item */
-						object_prep(obj, kind, c->depth, RANDOMISE);
-
-						/* Drop it in the dungeon */
-						drop_near(c, &obj, 0, grid, false, false);
-					}
-					break;
+				if (r >= 2) {
+					place_object(c, grid, c->depth + 1, false, false,
+								 ORIGIN_VAULT, NULL);
 				}
+				break;
+			}
 
-				/* Monster and/or object from 1 level deeper */
-				case '?': {
-					int r = randint1(3);
-					
-					if (r <= 2) {
-						pick_and_place_monster(c, grid, c->depth + 1, true,
-											   true, ORIGIN_DROP_VAULT);
-					}
-					if (r >= 2) {
-						place_object(c, grid, c->depth + 1, false, false,
-									 ORIGIN_VAULT, NULL);
-					}
-					break;
-				}
 
+			/* Carcharoth */
+			case 'C': {
+				place_new_monster_one(c, grid, lookup_monster("Carcharoth"),
+									  true, true, info,
+									  ORIGIN_DROP_VAULT);
+				break;
+			}
+			
+			/* silent watcher */
+			case 'H': {
+				place_new_monster_one(c, grid,
+									  lookup_monster("Silent watcher"),
+									  true, false, info,
+									  ORIGIN_DROP_VAULT);
+				break;
+			}
 
-				/* Carcharoth */
-				case 'C': {
-					place_new_monster_one(c, grid, lookup_monster("Carcharoth"),
-										  true, true, info,
-										  ORIGIN_DROP_VAULT);
-					break;
-				}
+			/* easterling spy */
+			case '@': {
+				place_new_monster_one(c, grid,
+									  lookup_monster("Easterling spy"),
+									  true, false, info,
+									  ORIGIN_DROP_VAULT);
+				break;
+			}
 				
-				/* silent watcher */
-				case 'H': {
-					place_new_monster_one(c, grid,
-										  lookup_monster("Silent watcher"),
-										  true, false, info,
-										  ORIGIN_DROP_VAULT);
-					break;
-				}
+			/* orc champion */
+			case 'o': {
+				place_new_monster_one(c, grid,
+									  lookup_monster("Orc champion"), true,
+									  false, info, ORIGIN_DROP_VAULT);
+				break;
+			}
 
-				/* easterling spy */
-				case '@': {
-					place_new_monster_one(c, grid,
-										  lookup_monster("Easterling spy"),
-										  true, false, info,
-										  ORIGIN_DROP_VAULT);
-					break;
-				}
-					
-				/* orc champion */
-				case 'o': {
-					place_new_monster_one(c, grid,
-										  lookup_monster("Orc champion"), true,
-										  false, info, ORIGIN_DROP_VAULT);
-					break;
-				}
+			/* orc captain */
+			case 'O': {
+				place_new_monster_one(c, grid,
+									  lookup_monster("Orc captain"), true,
+									  false, info, ORIGIN_DROP_VAULT);
+				break;
+			}
 
-				/* orc captain */
-				case 'O': {
-					place_new_monster_one(c, grid,
-										  lookup_monster("Orc captain"), true,
-										  false, info, ORIGIN_DROP_VAULT);
-					break;
-				}
+			/* cat warrior */
+			case 'f': {
+				place_new_monster_one(c, grid,
+									  lookup_monster("Cat warrior"), true,
+									  false, info, ORIGIN_DROP_VAULT);
+				break;
+			}
 
-				/* cat warrior */
-				case 'f': {
-					place_new_monster_one(c, grid,
-										  lookup_monster("Cat warrior"), true,
-										  false, info, ORIGIN_DROP_VAULT);
-					break;
-				}
+			/* cat assassin */
+			case 'F': {
+				place_new_monster_one(c, grid,
+									  lookup_monster("Cat assassin"), true,
+									  false, info, ORIGIN_DROP_VAULT);
+				break;
+			}
+				
+			/* troll guard */
+			case 'T': {
+				place_new_monster_one(c, grid,
+									  lookup_monster("Troll guard"), true,
+									  false, info, ORIGIN_DROP_VAULT);
+				break;
+			}
 
-				/* cat assassin */
-				case 'F': {
-					place_new_monster_one(c, grid,
-										  lookup_monster("Cat assassin"), true,
-										  false, info, ORIGIN_DROP_VAULT);
-					break;
-				}
-					
-				/* troll guard */
-				case 'T': {
-					place_new_monster_one(c, grid,
-										  lookup_monster("Troll guard"), true,
-										  false, info, ORIGIN_DROP_VAULT);
-					break;
-				}
+			/* barrow wight */
+			case 'W': {
+				place_new_monster_one(c, grid,
+									  lookup_monster("Barrow wight"), true,
+									  false, info, ORIGIN_DROP_VAULT);
+				break;
+			}
+			
+			/* dragon */
+			case 'd': {
+				place_monster_by_flag(c, grid, RF_DRAGON, -1, true,
+									  c->depth + 4, false);
+				break;
+			}
 
-				/* barrow wight */
-				case 'W': {
-					place_new_monster_one(c, grid,
-										  lookup_monster("Barrow wight"), true,
-										  false, info, ORIGIN_DROP_VAULT);
-					break;
-				}
+			/* young cold drake */
+			case 'y': {
+				place_new_monster_one(c, grid,
+									  lookup_monster("Young cold-drake"),
+									  true, false, info,
+									  ORIGIN_DROP_VAULT);
+				break;
+			}
 				
-				/* dragon */
-				case 'd': {
-					place_monster_by_flag(c, grid, RF_DRAGON, -1, true,
-										  c->depth + 4, false);
-					break;
-				}
-
-				/* young cold drake */
-				case 'y': {
-					place_new_monster_one(c, grid,
-										  lookup_monster("Young cold-drake"),
-										  true, false, info,
-										  ORIGIN_DROP_VAULT);
-					break;
-				}
-					
-				/* young fire drake */
-				case 'Y': {
-					place_new_monster_one(c, grid,
-									  lookup_monster("Young fire-drake"),
-									  true, false, info, ORIGIN_DROP_VAULT);
-					break;
-				}
-					
-				/* Spider */
-				case 'M': {
-					place_monster_by_flag(c, grid, RF_SPIDER, -1, true,
-										  c->depth + rand_range(1, 4), false);
-					break;
-				}
+			/* young fire drake */
+			case 'Y': {
+				place_new_monster_one(c, grid,
+								  lookup_monster("Young fire-drake"),
+								  true, false, info, ORIGIN_DROP_VAULT);
+				break;
+			}
 				
-				/* Vampire */
-				case 'v': {
-					place_monster_by_letter(c, grid, 'v', true,
-											c->depth + rand_range(1, 4));
-					break;
-				}
-
-                /* Archer */
-				case 'a': {
-					place_monster_by_flag(c, grid, RSF_ARROW1, RSF_ARROW2, true,
-										  c->depth + 1, true);
-					break;
-				}
+			/* Spider */
+			case 'M': {
+				place_monster_by_flag(c, grid, RF_SPIDER, -1, true,
+									  c->depth + rand_range(1, 4), false);
+				break;
+			}
+			
+			/* Vampire */
+			case 'v': {
+				place_monster_by_letter(c, grid, 'v', true,
+										c->depth + rand_range(1, 4));
+				break;
+			}
 
-                /* Flier */
-				case 'b': {
-					place_monster_by_flag(c, grid, RF_FLYING, -1, true,
-										  c->depth + 1, false);
-					break;
-				}
+            /* Archer */
+			case 'a': {
+				place_monster_by_flag(c, grid, RSF_ARROW1, RSF_ARROW2, true,
+									  c->depth + 1, true);
+				break;
+			}
 
-				/* Wolf */
-				case 'c': {
-					place_monster_by_flag(c, grid, RF_WOLF, -1, true,
-										  c->depth + rand_range(1, 4), false);
-					break;
-				}
-					
-				/* Rauko */
-				case 'r': {
-					place_monster_by_flag(c, grid, RF_RAUKO, -1, true,
-										  c->depth + rand_range(1, 4), false);
-					break;
-				}
-					
-                /* Aldor */
-				case 'A': {
-					place_new_monster_one(c, grid, lookup_monster("Aldor"),
-										  true, true, info,
-										  ORIGIN_DROP_VAULT);
-					break;
-				}
-                    
-				/* Glaurung */
-				case 'D': {
-					place_new_monster_one(c, grid, lookup_monster("Glaurung"),
-										  true, true, info,
-										  ORIGIN_DROP_VAULT);
-					break;
-				}
+            /* Flier */
+			case 'b': {
+				place_monster_by_flag(c, grid, RF_FLYING, -1, true,
+									  c->depth + 1, false);
+				break;
+			}
 
-				/* Gothmog */
-				case 'R': {
-					place_new_monster_one(c, grid, lookup_monster("Gothmog"),
-										  true, true, info,
-										  ORIGIN_DROP_VAULT);
-					break;
-				}
-					
-				/* Ungoliant */
-				case 'U': {
-					place_new_monster_one(c, grid, lookup_monster("Ungoliant"),
-										  true, true, info,
-										  ORIGIN_DROP_VAULT);
-					break;
-				}
+			/* Wolf */
+			case 'c': {
+				place_monster_by_flag(c, grid, RF_WOLF, -1, true,
+									  c->depth + rand_range(1, 4), false);
+				break;
+			}
+				
+			/* Rauko */
+			case 'r': {
+				place_monster_by_flag(c, grid, RF_RAUKO, -1, true,
+									  c->depth + rand_range(1, 4), false);
+				break;
+			}
+				
+            /* Aldor */
+			case 'A': {
+				place_new_monster_one(c, grid, lookup_monster("Aldor"),
+									  true, true, info,
+									  ORIGIN_DROP_VAULT);
+				break;
+			}
+                
+			/* Glaurung */
+			case 'D': {
+				place_new_monster_one(c, grid, lookup_monster("Glaurung"),
+									  true, true, info,
+									  ORIGIN_DROP_VAULT);
+				break;
+			}
 
-				/* Gorthaur */
-				case 'G': {
-					place_new_monster_one(c, grid, lookup_monster("Gorthaur"),
-										  true, true, info,
-										  ORIGIN_DROP_VAULT);
-					break;
-				}
-					
-				/* Morgoth */
-				case 'V': {
-					place_new_monster_one(c, grid, lookup_monster("Morgoth, Lord of Darkness"),
-										  true, true, info,
-										  ORIGIN_DROP_VAULT);
-					break;
-				}
+			/* Gothmog */
+			case 'R': {
+				place_new_monster_one(c, grid, lookup_monster("Gothmog"),
+									  true, true, info,
+									  ORIGIN_DROP_VAULT);
+				break;
+			}
+				
+			/* Ungoliant */
+			case 'U': {
+				place_new_monster_one(c, grid, lookup_monster("Ungoliant"),
+									  true, true, info,
+									  ORIGIN_DROP_VAULT);
+				break;
 			}
 
+			/* Gorthaur */
+			case 'G': {
+				place_new_monster_one(c, grid, lookup_monster("Gorthaur"),
+									  true, true, info,
+									  ORIGIN_DROP_VAULT);
+				break;
+			}
+				
+			/* Morgoth */
+			case 'V': {
+				place_new_monster_one(c, grid, lookup_monster("Morgoth, Lord of Darkness"),
+									  true, true, info,
+									  ORIGIN_DROP_VAULT);
+				break;
+			}
 		}
 	}
 
-	for (t = data, y = 0; y < v->hgt && *t; y++) {
-		int ay = flip_v ? v->hgt - 1 - y : y;
-		for (x = 0; x < v->wid && *t; x++, t++) {
-			int ax = flip_h ? v->wid - 1 - x : x;
-			struct loc grid;
-			int mult;
-
-			/* Extract the location, flipping diagonally if requested */
-            if (flip) {
-                grid.x = centre.x - (v->hgt / 2) + ay;
-                grid.y = centre.y - (v->wid / 2) + ax;
-            } else {
-				grid.x = centre.x - (v->wid / 2) + ax;
-				grid.y = centre.y - (v->hgt / 2) + ay;
-			}
-
-			/* Hack -- skip "non-grids" */
-			if (*t == ' ') continue;
+	for (i = 0; i < v->n_cells; i++) {
+		struct loc grid = vault_cell_grid(v, &v->cells[i], centre, flip,
+			flip_v, flip_h);
+		int mult;
 
-            /* Some vaults are always lit */
-            if (roomf_has(v->flags, ROOMF_LIGHT)) {
-                sqinfo_on(square(c, grid)->info, SQUARE_GLOW);
-            }
+        /* Some vaults are always lit */
+        if (roomf_has(v->flags, ROOMF_LIGHT)) {
+            sqinfo_on(square(c, grid)->info, SQUARE_GLOW);
+        }
 
-            /* Traps are usually 5 times as likely in vaults,
-			 * but are 10 times as likely if the TRAPS flag is set */
-            mult = roomf_has(v->flags, ROOMF_TRAPS) ? 10 : 5;
-
-            /* Another chance to place traps, with 4 times the normal chance
-			 * so traps in interesting rooms and vaults are a total of 5 times
-			 * more likely */
-            if (randint1(1000) <= trap_placement_chance(c, grid) * (mult - 1)) {
-                square_add_trap(c, grid);
-            } else if (roomf_has(v->flags, ROOMF_WEBS) && one_in_(20)) {
-				/* Webbed vaults also have a large chance of receiving webs */
-                square_add_web(c, grid);
-
-                /* Hide it half the time */
-                if (one_in_(2)) {
-					struct trap *trap = square_trap(c, grid);
-                    trf_on(trap->flags, TRF_INVISIBLE);
-                }
+        /* Traps are usually 5 times as likely in vaults,
+		 * but are 10 times as likely if the TRAPS flag is set */
+        mult = roomf_has(v->flags, ROOMF_TRAPS) ? 10 : 5;
+
+        /* Another chance to place traps, with 4 times the normal chance
+		 * so traps in interesting rooms and vaults are a total of 5 times
+		 * more likely */
+        if (randint1(1000) <= trap_placement_chance(c, grid) * (mult - 1)) {
+            square_add_trap(c, grid);
+        } else if (roomf_has(v->flags, ROOMF_WEBS) && one_in_(20)) {
+			/* Webbed vaults also have a large chance of receiving webs */
+            square_add_web(c, grid);
+
+            /* Hide it half the time */
+            if (one_in_(2)) {
+				struct trap *trap = square_trap(c, grid);
+                trf_on(trap->flags, TRF_INVISIBLE);
             }
         }
-    }
+	}
 
 	return true;
 }
@@ -142,6 +142,50 @@ int *cave_find_init(struct loc top_left, struct loc bottom_right)
 }
 
 
+/**
+ * Set up to locate a floor square in a rectangular region of a chunk.
+ *
+ * \param c is the chunk to search.
+ * \param top_left is the upper left corner of the rectangle to be searched.
+ * \param bottom_right is the lower right corner of the rectangle to be
+ * searched.
+ * \return the state for the search, as for cave_find_init().
+ *
+ * Only the chunk's floor grids are candidates, unless the rectangle is
+ * smaller than the list of them, so every floor grid in the rectangle is
+ * equally likely to come up next and other grids needn't be checked.
+ */
+int *cave_find_init_floor(struct chunk *c, struct loc top_left,
+		struct loc bottom_right)
+{
+	struct loc diff = loc_diff(bottom_right, top_left);
+	int n = (diff.y < 0 || diff.x < 0) ? 0 : (diff.x + 1) * (diff.y + 1);
+	int *state;
+	int i;
+
+	if (n <= c->floor_count) return cave_find_init(top_left, bottom_right);
+
+	state = mem_alloc((5 + c->floor_count) * sizeof(*state));
+	state[1] = diff.x + 1;
+	state[2] = top_left.x;
+	state[3] = top_left.y;
+	state[4] = 0;
+	n = 0;
+	for (i = 0; i < c->floor_count; i++) {
+		int y = c->floor_grids[i] / c->width;
+		int x = c->floor_grids[i] % c->width;
+		if (y < top_left.y || y > bottom_right.y || x < top_left.x
+				|| x > bottom_right.x) {
+			continue;
+		}
+		state[5 + n] = (y - top_left.y) * state[1] + x - top_left.x;
+		n++;
+	}
+	state[0] = n;
+	return state;
+}
+
+
 /**
  * Reset a search created by cave_find_init() to start again from fresh.
  *
@@ -230,6 +274,48 @@ bool cave_find(struct chunk *c, struct loc *grid, square_predicate pred)
 }
 
 
+/**
+ * Locate a square in a rectangle which satisfies a predicate that only ever
+ * holds for floor squares.
+ *
+ * \param c current chunk
+ * \param grid found grid
+ * \param top_left top left grid of rectangle
+ * \param bottom_right bottom right grid of rectangle
+ * \param pred square_predicate specifying what we're looking for
+ * \return success
+ */
+bool cave_find_floor_in_range(struct chunk *c, struct loc *grid,
+		struct loc top_left, struct loc bottom_right,
+		square_predicate pred)
+{
+	int *state = cave_find_init_floor(c, top_left, bottom_right);
+	bool found = false;
+
+	while (!found && cave_find_get_grid(grid, state)) {
+		found = pred(c, *grid);
+	}
+	mem_free(state);
+	return found;
+}
+
+
+/**
+ * Locate a square in the dungeon which satisfies a predicate that only ever
+ * holds for floor squares.
+ * \param c current chunk
+ * \param grid found grid
+ * \param pred square_predicate specifying what we're looking for
+ * \return success
+ */
+bool cave_find_floor(struct chunk *c, struct loc *grid, square_predicate pred)
+{
+	struct loc top_left = loc(0, 0);
+	struct loc bottom_right = loc(c->width - 1, c->height - 1);
+	return cave_find_floor_in_range(c, grid, top_left, bottom_right, pred);
+}
+
+
 /**
  * Locate an empty square for 0 <= y < ymax, 0 <= x < xmax.
  * \param c current chunk
@@ -238,7 +324,7 @@ bool cave_find(struct chunk *c, struct loc *grid, square_predicate pred)
  */
 bool find_empty(struct chunk *c, struct loc *grid)
 {
-	return cave_find(c, grid, square_isempty);
+	return cave_find_floor(c, grid, square_isempty);
 }
 
 
@@ -253,7 +339,7 @@ bool find_empty(struct chunk *c, struct loc *grid)
 bool find_empty_range(struct chunk *c, struct loc *grid, struct loc top_left,
 	struct loc bottom_right)
 {
-	return cave_find_in_range(c, grid, top_left, bottom_right,
+	return cave_find_floor_in_range(c, grid, top_left, bottom_right,
 		square_isempty);
 }
 
@@ -563,7 +649,7 @@ void alloc_stairs(struct chunk *c, int feat, int num)
 		bool first = (i == 0);
 
 		/* Find a suitable grid */
-		cave_find(c, &grid, square_suits_stairs);
+		cave_find_floor(c, &grid, square_suits_stairs);
 		place_stairs(c, grid, first, feat);
 		assert(square_isstairs(c, grid) || (!first && square_isshaft(c, grid)));
 		++i;
@@ -710,15 +796,16 @@ int trap_placement_chance(struct chunk *c, struct loc grid)
  */
 void place_traps(struct chunk *c)
 {
-    struct loc grid;
-
-	/* scan the map */
-	for (grid.y = 0; grid.y < c->height; grid.y++) {
-		for (grid.x = 0; grid.x < c->width; grid.x++) {
-            /* Randomly determine whether to place a trap based on the above */
-            if (randint1(1000) <= trap_placement_chance(c, grid)) {
-                square_add_trap(c, grid);
-            }
+	int i;
+
+	/* Only floor grids can have a chance; placing traps leaves them floor */
+	for (i = 0; i < c->floor_count; i++) {
+		struct loc grid = loc(c->floor_grids[i] % c->width,
+			c->floor_grids[i] / c->width);
+
+		/* Randomly determine whether to place a trap based on the above */
+		if (randint1(1000) <= trap_placement_chance(c, grid)) {
+			square_add_trap(c, grid);
 		}
 	}
 }
@@ -740,7 +827,7 @@ int alloc_object(struct chunk *c, int set, int typ, int num, int depth,
 						 uint8_t origin)
 {
 	int nrem = num;
-	int *state = cave_find_init(loc(1, 1),
+	int *state = cave_find_init_floor(c, loc(1, 1),
 		loc(c->width - 2, c->height - 2));
 	struct loc grid;
 
@@ -46,6 +46,7 @@
 #include "player-history.h"
 #include "player-quest.h"
 #include "player-util.h"
+#include "profile.h"
 #include "trap.h"
 #include "z-queue.h"
 #include "z-type.h"
@@ -54,6 +55,7 @@
  * Array of pit types
  */
 struct vault *vaults;
+struct vault_list *vault_lists;
 static struct cave_profile *cave_profiles;
 struct dun_data *dun;
 struct room_template *room_templates;
@@ -405,9 +407,86 @@ static errr run_parse_vault(struct parser *p) {
 	return parse_file_quit_not_found(p, "vault");
 }
 
+/**
+ * Record the non-blank grids of a vault and how deep its contents allow
+ */
+static void finish_vault_layout(struct vault *v)
+{
+	int x, y, n = 0;
+	const char *t = v->text;
+
+	v->max_depth = 255;
+	v->cells = mem_zalloc(v->hgt * v->wid * sizeof(*v->cells));
+	for (y = 0; y < v->hgt; y++) {
+		for (x = 0; x < v->wid; x++, t++) {
+			if (*t == ' ') continue;
+
+			/* Barrow wights can't be deeper than level 12 */
+			if (*t == 'W') v->max_depth = MIN(v->max_depth, 12);
+
+			/* Chasms can't occur at 950 ft */
+			if (*t == '7') {
+				v->max_depth = MIN(v->max_depth, z_info->dun_depth - 2);
+			}
+
+			v->cells[n].x = x;
+			v->cells[n].y = y;
+			v->cells[n].sym = *t;
+			n++;
+		}
+	}
+	v->n_cells = n;
+}
+
+/**
+ * Add a vault to the list for its type, making the list if needed
+ */
+static void add_vault_to_list(struct vault *v, bool forge)
+{
+	struct vault_list *list;
+
+	for (list = vault_lists; list; list = list->next) {
+		if ((list->forge == forge) && streq(list->typ, v->typ)) break;
+	}
+	if (!list) {
+		list = mem_zalloc(sizeof(*list));
+		list->typ = v->typ;
+		list->forge = forge;
+		list->next = vault_lists;
+		vault_lists = list;
+	}
+	list->vaults = mem_realloc(list->vaults,
+		(list->count + 1) * sizeof(*list->vaults));
+	list->vaults[list->count++] = v;
+}
+
+/**
+ * Sort a vault list by depth and total up its rarities
+ */
+static void finish_vault_list(struct vault_list *list)
+{
+	int i, j;
+
+	/* Insertion sort, so vaults of the same depth keep their order */
+	for (i = 1; i < list->count; i++) {
+		struct vault *v = list->vaults[i];
+		for (j = i; (j > 0) && (list->vaults[j - 1]->depth > v->depth); j--) {
+			list->vaults[j] = list->vaults[j - 1];
+		}
+		list->vaults[j] = v;
+	}
+
+	list->total = mem_zalloc(list->count * sizeof(*list->total));
+	for (i = 0; i < list->count; i++) {
+		list->total[i] = (i ? list->total[i - 1] : 0)
+			+ list->vaults[i]->rarity;
+	}
+}
+
 static errr finish_parse_vault(struct parser *p) {
 	uint32_t rarity_denom = 1;
 	struct vault *v;
+	struct vault_list *list;
 
 	vaults = parser_priv(p);
 	parser_destroy(p);
@@ -459,17 +538,38 @@ static errr finish_parse_vault(struct parser *p) {
 		}
 	}
 
+	for (v = vaults; v; v = v->next) {
+		finish_vault_layout(v);
+		if (v->rarity > 0) {
+			add_vault_to_list(v, false);
+			if (v->forge) add_vault_to_list(v, true);
+		}
+	}
+	for (list = vault_lists; list; list = list->next) {
+		finish_vault_list(list);
+	}
+
 	return 0;
 }
 
 static void cleanup_vault(void)
 {
 	struct vault *v, *next;
+	struct vault_list *list, *list_next;
+
+	for (list = vault_lists; list; list = list_next) {
+		list_next = list->next;
+		mem_free(list->vaults);
+		mem_free(list->total);
+		mem_free(list);
+	}
+	vault_lists = NULL;
 	for (v = vaults; v; v = next) {
 		next = v->next;
 		mem_free(v->name);
 		mem_free(v->typ);
 		mem_free(v->text);
+		mem_free(v->cells);
 		mem_free(v);
 	}
 }
@@ -636,6 +736,7 @@ static void cleanup_dun_data(struct dun_data *dd)
 	mem_free(dd->cent);
 	mem_free(dd->corner);
 	mem_free(dd->piece);
+	mem_free(dd->piece_parent);
 	for (i = 0; i < z_info->level_room_max; ++i) {
 		mem_free(dd->connection[i]);
 	}
@@ -661,6 +762,8 @@ static struct chunk *cave_generate(struct player *p)
 	int i, tries = 0;
 	struct chunk *chunk = NULL;
 
+	PROFILE_START(cave_generate);
+
 	/* Generate */
 	for (tries = 0; tries < 100 && error; tries++) {
 		int y, x;
@@ -679,6 +782,10 @@ static struct chunk *cave_generate(struct player *p)
 		dun->corner = mem_zalloc(z_info->level_room_max
 								 * sizeof(struct rectangle));
 		dun->piece = mem_zalloc(z_info->level_room_max * sizeof(int));
+		dun->piece_parent = mem_zalloc(z_info->level_room_max * sizeof(int));
+		for (i = 0; i < z_info->level_room_max; i++) {
+			dun->piece_parent[i] = i;
+		}
 		dun->tunn1 = mem_zalloc(z_info->dungeon_hgt * sizeof(int*));
 		dun->tunn2 = mem_zalloc(z_info->dungeon_hgt * sizeof(int*));
 		for (y = 0; y < z_info->dungeon_hgt; y++) {
@@ -750,6 +857,7 @@ static struct chunk *cave_generate(struct player *p)
 	/* Clear stair creation */
 	p->upkeep->create_stair = FEAT_NONE;
 
+	PROFILE_STOP(cave_generate);
 	return chunk;
 }
 
@@ -799,18 +907,15 @@ void prepare_next_level(struct player *p)
 
 	/* Generate a new level */
 	cave = cave_generate(p);
+	path_cache_terrain_changed();
 	event_signal_flag(EVENT_GEN_LEVEL_END, true);
 
 	/* Note any forges generated, done here in case generation fails earlier */
-	for (y = 0; y < cave->height; y++) {
-		for (x = 0; x < cave->width; x++) {
-			if (square_isforge(cave, loc(x, y))) {
-				/* Reset the time since the last forge when an interesting room
-				 * with a forge is generated */
-				player->forge_drought = 0;
-				player->forge_count++;
-			}
-		}
+	if (cave->grid_lists[GRID_CLASS_FORGE].count) {
+		/* Reset the time since the last forge when an interesting room
+		 * with a forge is generated */
+		player->forge_drought = 0;
+		player->forge_count += cave->grid_lists[GRID_CLASS_FORGE].count;
 	}
 
 	/* The dungeon is ready */
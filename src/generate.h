@@ -87,6 +87,9 @@ struct dun_data {
     /*!< Array (cent_n elements) of what dungeon piece each room is in */
     int *piece;
 
+    /*!< Disjoint set forest of rooms, joined as they are connected */
+    int *piece_parent;
+
 	/*!< Array of connections between rooms */
 	bool **connection;
 
@@ -152,6 +155,15 @@ struct room_profile {
 /*
  * Information about vault generation
  */
+/**
+ * A grid of a vault which isn't blank
+ */
+struct vault_cell {
+	uint8_t x;					/*!< Column in the vault's text */
+	uint8_t y;					/*!< Row in the vault's text */
+	char sym;					/*!< Symbol in the vault's text */
+};
+
 struct vault {
     struct vault *next; 		/*!< Pointer to next vault template */
 
@@ -165,6 +177,22 @@ struct vault {
     uint8_t depth;				/*!< Vault depth */
     uint32_t rarity;				/*!< Vault rarity */
     bool forge;					/*!< Is there a forge in it? */
+    int max_depth;				/*!< Deepest level its contents allow */
+    struct vault_cell *cells;	/*!< Non-blank grids, in text order */
+    int n_cells;				/*!< Number of non-blank grids */
+};
+
+/**
+ * Vaults of one type with non-zero rarity, sorted by depth, for choosing
+ * one at random
+ */
+struct vault_list {
+	struct vault_list *next;
+	const char *typ;			/*!< Vault type */
+	bool forge;					/*!< Only the vaults with forges */
+	int count;					/*!< Number of vaults */
+	struct vault **vaults;		/*!< The vaults, shallowest first */
+	uint32_t *total;			/*!< Sum of rarities up to each vault */
 };
 
 
@@ -180,6 +208,7 @@ struct vault {
 
 extern struct dun_data *dun;
 extern struct vault *vaults;
+extern struct vault_list *vault_lists;
 extern struct room_template *room_templates;
 
 /* generate.c */
@@ -220,12 +249,18 @@ bool room_build(struct chunk *c, struct room_profile profile);
 extern uint8_t get_angle_to_grid[41][41];
 
 int *cave_find_init(struct loc top_left, struct loc bottom_right);
+int *cave_find_init_floor(struct chunk *c, struct loc top_left,
+	struct loc bottom_right);
 void cave_find_reset(int *state);
 bool cave_find_get_grid(struct loc *grid, int *state);
 
 bool cave_find_in_range(struct chunk *c, struct loc *grid, struct loc top_left,
 	struct loc bottom_right, square_predicate pred);
 bool cave_find(struct chunk *c, struct loc *grid, square_predicate pred);
+bool cave_find_floor_in_range(struct chunk *c, struct loc *grid,
+	struct loc top_left, struct loc bottom_right, square_predicate pred);
+bool cave_find_floor(struct chunk *c, struct loc *grid,
+	square_predicate pred);
 bool find_empty(struct chunk *c, struct loc *grid);
 bool find_empty_range(struct chunk *c, struct loc *grid, struct loc top_left,
 					  struct loc bottom_right);
@@ -0,0 +1,18 @@
+/**
+ * \file list-grid-classes.h
+ * \brief Classes of grid that each chunk keeps a list of
+ *
+ * A grid may be in any number of classes.  The lists follow changes of
+ * terrain, traps and floor objects, so that effects which only care about
+ * a few kinds of grid need not search the whole level.
+ */
+
+/*          symbol          descr */
+GRID_CLASS(DOOR,			"doors of any kind, secret ones included")
+GRID_CLASS(SECRET_DOOR,		"secret doors")
+GRID_CLASS(TRAP,			"grids with traps, door locks and jams included")
+GRID_CLASS(CHASM,			"chasms")
+GRID_CLASS(RUBBLE,			"rubble")
+GRID_CLASS(CHEST,			"grids with a chest among their objects")
+GRID_CLASS(FORGE,			"forges")
+GRID_CLASS(STAIR,			"staircases")
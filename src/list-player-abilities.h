@@ -0,0 +1,86 @@
+/**
+ * \file list-player-abilities.h
+ * \brief player abilities
+ *
+ * Every ability name in lib/gamedata/ability.txt needs an entry here; an
+ * ability appearing in several skills (such as Dexterity) shares one entry.
+ * The order has no meaning outside the running game and may be changed.
+ */
+PA(POWER,				"Power")
+PA(FINESSE,				"Finesse")
+PA(THROWING_MASTERY,	"Throwing Mastery")
+PA(POLEARM_MASTERY,		"Polearm Mastery")
+PA(CHARGE,				"Charge")
+PA(FOLLOW_THROUGH,		"Follow-Through")
+PA(ZONE_OF_CONTROL,		"Zone of Control")
+PA(SUBTLETY,			"Subtlety")
+PA(MOMENTUM,			"Momentum")
+PA(RAPID_ATTACK,		"Rapid Attack")
+PA(TWO_WEAPON_FIGHTING,	"Two Weapon Fighting")
+PA(KNOCK_BACK,			"Knock Back")
+PA(WHIRLWIND_ATTACK,	"Whirlwind Attack")
+PA(STRENGTH,			"Strength")
+PA(CAREFUL_SHOT,		"Careful Shot")
+PA(PRECISION,			"Precision")
+PA(POINT_BLANK_ARCHERY,	"Point Blank Archery")
+PA(VERSATILITY,			"Versatility")
+PA(CRIPPLING_SHOT,		"Crippling Shot")
+PA(FLAMING_ARROWS,		"Flaming Arrows")
+PA(RAPID_FIRE,			"Rapid Fire")
+PA(DEXTERITY,			"Dexterity")
+PA(DODGING,				"Dodging")
+PA(BLOCKING,			"Blocking")
+PA(PARRY,				"Parry")
+PA(CROWD_FIGHTING,		"Crowd Fighting")
+PA(LEAPING,				"Leaping")
+PA(SPRINTING,			"Sprinting")
+PA(FLANKING,			"Flanking")
+PA(HEAVY_ARMOUR,		"Heavy Armour")
+PA(RIPOSTE,				"Riposte")
+PA(CONTROLLED_RETREAT,	"Controlled Retreat")
+PA(DISGUISE,			"Disguise")
+PA(ASSASSINATION,		"Assassination")
+PA(CRUEL_BLOW,			"Cruel Blow")
+PA(OPPORTUNIST,			"Opportunist")
+PA(EXCHANGE_PLACES,		"Exchange Places")
+PA(VANISH,				"Vanish")
+PA(EYE_FOR_DETAIL,		"Eye for Detail")
+PA(FOCUSED_ATTACK,		"Focused Attack")
+PA(KEEN_SENSES,			"Keen Senses")
+PA(ITEM_LORE,			"Item Lore")
+PA(CONCENTRATION,		"Concentration")
+PA(BANE,				"Bane")
+PA(LORE_MASTER,			"Lore-Master")
+PA(LISTEN,				"Listen")
+PA(MASTER_HUNTER,		"Master Hunter")
+PA(GRACE,				"Grace")
+PA(CHANNELING,			"Channeling")
+PA(MIND_OVER_BODY,		"Mind Over Body")
+PA(CURSE_BREAKING,		"Curse Breaking")
+PA(INNER_LIGHT,			"Inner Light")
+PA(CLARITY,				"Clarity")
+PA(HARDINESS,			"Hardiness")
+PA(POISON_RESISTANCE,	"Poison Resistance")
+PA(STRENGTH_IN_ADVERSITY,	"Strength in Adversity")
+PA(CRITICAL_RESISTANCE,	"Critical Resistance")
+PA(MAJESTY,				"Majesty")
+PA(CONSTITUTION,		"Constitution")
+PA(WEAPONSMITH,			"Weaponsmith")
+PA(ARMOURSMITH,			"Armoursmith")
+PA(JEWELLER,			"Jeweller")
+PA(ENCHANTMENT,			"Enchantment")
+PA(ARTISTRY,			"Artistry")
+PA(ARTIFICE,			"Artifice")
+PA(MASTERPIECE,			"Masterpiece")
+PA(SONG_OF_ELBERETH,	"Song of Elbereth")
+PA(SONG_OF_SLAYING,		"Song of Slaying")
+PA(SONG_OF_SILENCE,		"Song of Silence")
+PA(SONG_OF_FREEDOM,		"Song of Freedom")
+PA(SONG_OF_THE_TREES,	"Song of the Trees")
+PA(SONG_OF_AULE,		"Song of Aule")
+PA(SONG_OF_STAYING,		"Song of Staying")
+PA(SONG_OF_LORIEN,		"Song of Lorien")
+PA(SONG_OF_ESTE,		"Song of Este")
+PA(SONG_OF_SHARPNESS,	"Song of Sharpness")
+PA(SONG_OF_MASTERY,		"Song of Mastery")
+PA(WOVEN_THEMES,		"Woven Themes")
@@ -0,0 +1,25 @@
+/**
+ * \file list-profile-regions.h
+ * \brief Code regions timed by the profiling counters
+ *
+ * Fields:
+ * name - region name, used as the PROF_ suffix and in reports
+ * description - what the region covers
+ */
+/* name					description */
+PROF(update_flow,		"monster pathfinding and noise flows")
+PROF(update_view,		"player field of view")
+PROF(update_fire,		"player field of fire")
+PROF(calc_lighting,		"light levels of grids in view")
+PROF(light_room,		"lighting and darkening whole rooms")
+PROF(project,			"projections and their effects")
+PROF(process_monsters,	"all monster turns")
+PROF(monster_turn,		"single monster turns")
+PROF(update_monsters,	"monster visibility")
+PROF(calc_bonuses,		"player state calculation")
+PROF(handle_stuff,		"player update and redraw")
+PROF(cave_generate,		"level generation")
+PROF(savefile_save,		"writing the savefile")
+PROF(term_fresh,		"terminal refresh")
+PROF(path_cache_hit,	"sight and projection paths found in the cache")
+PROF(path_cache_miss,	"sight and projection paths traced afresh")
@@ -310,6 +310,9 @@ static bool rd_monster(struct chunk *c, struct monster *mon)
 		assert(obj->oidx);
 		assert(c->objects[obj->oidx] == NULL);
 		c->objects[obj->oidx] = obj;
+		if (c == cave) {
+			set_artifact_object(obj);
+		}
 	}
 
 	/* Read group info */
@@ -720,6 +723,7 @@ int rd_player(void)
 			instance->active = true;
 		}
 	}
+	player_update_active_abilities(player);
 
 	/* Read the action list */
 	for (i = 0; i < MAX_ACTION; i++) {
@@ -1136,6 +1140,7 @@ int rd_gear(void)
 		obj->known = known_obj;
 		player->upkeep->total_weight +=
 			obj->number * obj->weight;
+		set_artifact_object(obj);
 	}
 
 	calc_inventory(player);
@@ -1265,6 +1270,10 @@ static int rd_objects_aux(struct chunk *c)
 			break;
 		if (square_in_bounds_fully(c, obj->grid)) {
 			pile_insert_end(&c->squares[obj->grid.y][obj->grid.x].obj, obj);
+			square_note_pile(c, obj->grid);
+			if (c == cave) {
+				set_artifact_object(obj);
+			}
 		}
 		assert(obj->oidx);
 		assert(c->objects[obj->oidx] == NULL);
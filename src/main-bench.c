@@ -0,0 +1,619 @@
+/**
+ * \file main-bench.c
+ * \brief Pseudo-UI for headless gameplay benchmarks (borrows from main-stats.c)
+ *
+ * Copyright (c) 2026 Angband contributors
+ *
+ * This work is free software; you can redistribute it and/or modify it
+ * under the terms of either:
+ *
+ * a) the GNU General Public License as published by the Free Software
+ *    Foundation, version 2, or
+ *
+ * b) the "Angband licence":
+ *    This software may be copied and distributed for educational, research,
+ *    and not for profit purposes provided that this copyright and statement
+ *    are included in all such copies.  Other copyrights may also apply.
+ */
+
+#include "angband.h"
+
+#ifdef USE_BENCH
+
+#include "buildid.h"
+#include "cave.h"
+#include "cmd-core.h"
+#include "game-event.h"
+#include "game-input.h"
+#include "game-world.h"
+#include "generate.h"
+#include "init.h"
+#include "main.h"
+#include "mon-util.h"
+#include "monster.h"
+#include "player.h"
+#include "player-birth.h"
+#include "player-calcs.h"
+#include "player-timed.h"
+#include "player-util.h"
+#include "profile.h"
+#include "ui-game.h"
+#include "ui-output.h"
+
+/**
+ * Player commands the autoplayer spends exploring a level before it starts
+ * looking for a way down, and before it gives up and descends anyway
+ */
+#define BENCH_EXPLORE		200
+#define BENCH_GIVE_UP		1000
+
+/**
+ * Commands in a row which may pass without using any game time before the
+ * benchmark forces the player to hold
+ */
+#define BENCH_MAX_STUCK		100
+
+static uint32_t seed = 1;
+static int32_t num_turns = 10000;
+static bool quiet = false;
+static const char *script_name = NULL;
+static const char *output_name = NULL;
+static int running_bench = 0;
+
+static ang_file *script = NULL;
+static int auto_cmds = 0;
+static int bench_dir = 0;
+static int level_cmds = 0;
+static int levels = 0;
+static uint32_t player_cmds = 0;
+
+/**
+ * Script commands and the game commands they map to
+ */
+static const struct {
+	const char *name;
+	cmd_code code;
+	bool needs_dir;
+} bench_cmds[] = {
+	{ "walk", CMD_WALK, true },
+	{ "run", CMD_RUN, true },
+	{ "alter", CMD_ALTER, true },
+	{ "open", CMD_OPEN, true },
+	{ "close", CMD_CLOSE, true },
+	{ "tunnel", CMD_TUNNEL, true },
+	{ "disarm", CMD_DISARM, true },
+	{ "hold", CMD_HOLD, false },
+	{ "down", CMD_GO_DOWN, false },
+	{ "up", CMD_GO_UP, false },
+};
+
+/**
+ * Skip autosaves on level change, and count the levels
+ */
+static void bench_new_level(game_event_type type, game_event_data *data,
+		void *user)
+{
+	player->upkeep->autosave = false;
+	level_cmds = 0;
+	bench_dir = 0;
+	levels++;
+}
+
+/**
+ * Queue the next command from the script.  Returns false if the script has
+ * finished or has handed control to the autoplayer.
+ */
+static bool bench_script_command(void)
+{
+	char buf[1024];
+
+	while (script && file_getl(script, buf, sizeof(buf))) {
+		char *name = strtok(buf, " ");
+		char *arg = strtok(NULL, " ");
+		size_t i;
+
+		if (!name || name[0] == '#') continue;
+
+		/* Let the autoplayer have some commands */
+		if (streq(name, "auto")) {
+			auto_cmds = arg ? atoi(arg) : 1;
+			return false;
+		}
+
+		if (streq(name, "pathfind")) {
+			char *arg2 = strtok(NULL, " ");
+
+			if (!arg || !arg2) {
+				printf("bench: pathfind needs x and y\n");
+				continue;
+			}
+			cmdq_push(CMD_PATHFIND);
+			cmd_set_arg_point(cmdq_peek(), "point",
+				loc(atoi(arg), atoi(arg2)));
+			return true;
+		}
+
+		for (i = 0; i < N_ELEMENTS(bench_cmds); i++) {
+			if (streq(name, bench_cmds[i].name)) break;
+		}
+		if (i == N_ELEMENTS(bench_cmds)) {
+			printf("bench: bad script command '%s'\n", name);
+			continue;
+		}
+		if (bench_cmds[i].needs_dir && !arg) {
+			printf("bench: %s needs a direction\n", name);
+			continue;
+		}
+
+		cmdq_push(bench_cmds[i].code);
+		if (bench_cmds[i].needs_dir) {
+			cmd_set_arg_direction(cmdq_peek(), "direction", atoi(arg));
+		}
+		return true;
+	}
+
+	/* Out of script, the autoplayer takes over */
+	if (script) {
+		file_close(script);
+		script = NULL;
+	}
+	return false;
+}
+
+/**
+ * Whether the autoplayer is willing to step in direction 'dir'
+ */
+static bool bench_can_step(int dir)
+{
+	struct loc grid = loc_sum(player->grid, ddgrid[dir]);
+
+	if (!square_in_bounds_fully(cave, grid)) return false;
+	if (square_ischasm(cave, grid)) return false;
+	if (square_isvisibletrap(cave, grid)) return false;
+	return square_ispassable(cave, grid) || square_iscloseddoor(cave, grid);
+}
+
+/**
+ * Find a visible monster next to the player, returning its direction
+ */
+static int bench_monster_dir(void)
+{
+	int d;
+
+	for (d = 0; d < 8; d++) {
+		struct loc grid = loc_sum(player->grid, ddgrid_ddd[d]);
+		struct monster *mon = square_monster(cave, grid);
+
+		if (mon && monster_is_visible(mon)) return ddd[d];
+	}
+
+	return 0;
+}
+
+/**
+ * Find the nearest down staircase the player knows about
+ */
+static bool bench_find_stairs(struct loc *stairs)
+{
+	int y, x, best = -1;
+
+	for (y = 1; y < cave->height - 1; y++) {
+		for (x = 1; x < cave->width - 1; x++) {
+			struct loc grid = loc(x, y);
+			int d;
+
+			if (!square_isdownstairs(player->cave, grid)) continue;
+			d = distance(player->grid, grid);
+			if (best < 0 || d < best) {
+				best = d;
+				*stairs = grid;
+			}
+		}
+	}
+
+	return best >= 0;
+}
+
+/**
+ * Queue a command chosen by the autoplayer: fight anything adjacent, wander
+ * around the level for a while, then head for the stairs.
+ */
+static void bench_auto_command(void)
+{
+	struct loc stairs;
+	int dir = bench_monster_dir(), tries;
+
+	if (auto_cmds > 0) auto_cmds--;
+
+	/* Fight */
+	if (dir) {
+		cmdq_push(CMD_WALK);
+		cmd_set_arg_direction(cmdq_peek(), "direction", dir);
+		return;
+	}
+
+	/* Descend */
+	if (level_cmds > BENCH_EXPLORE) {
+		if (square_isdownstairs(cave, player->grid)) {
+			cmdq_push(CMD_GO_DOWN);
+			return;
+		}
+		if (level_cmds > BENCH_GIVE_UP) {
+			int next = dungeon_get_next_level(player, player->depth, 1);
+
+			dungeon_change_level(player, MIN(next, z_info->dun_depth - 1));
+			cmdq_push(CMD_HOLD);
+			return;
+		}
+		if (level_cmds % 20 == 0 && bench_find_stairs(&stairs)) {
+			cmdq_push(CMD_PATHFIND);
+			cmd_set_arg_point(cmdq_peek(), "point", stairs);
+			return;
+		}
+	}
+
+	/* Explore, keeping to one direction until blocked or bored */
+	if (!bench_dir || one_in_(8) || !bench_can_step(bench_dir)) {
+		bench_dir = 0;
+		for (tries = 0; tries < 16 && !bench_dir; tries++) {
+			dir = ddd[randint0(8)];
+			if (bench_can_step(dir)) bench_dir = dir;
+		}
+	}
+
+	if (!bench_dir) {
+		cmdq_push(CMD_HOLD);
+	} else if (square_iscloseddoor(cave,
+			loc_sum(player->grid, ddgrid[bench_dir]))) {
+		cmdq_push(CMD_OPEN);
+		cmd_set_arg_direction(cmdq_peek(), "direction", bench_dir);
+	} else {
+		cmdq_push(CMD_WALK);
+		cmd_set_arg_direction(cmdq_peek(), "direction", bench_dir);
+	}
+}
+
+/**
+ * Answer yes to every confirmation (attacking barehanded, stepping on a known
+ * trap and so on) except cheat_live's offer to die
+ */
+static bool bench_get_check(const char *prompt)
+{
+	return !prefix(prompt, "Die?");
+}
+
+/**
+ * Keep the character going for the whole run; cheat_live catches anything
+ * this misses
+ */
+static void bench_sustain_player(void)
+{
+	if (player->chp < player->mhp / 2) {
+		player->chp = player->mhp;
+		player->upkeep->redraw |= (PR_HP);
+	}
+	if (player->timed[TMD_FOOD] < PY_FOOD_ALERT) {
+		player_set_timed(player, TMD_FOOD, PY_FOOD_FULL - 1, false, false);
+	}
+}
+
+/**
+ * Write 'str' as a quoted JSON string, or null if there isn't one
+ */
+static void bench_json_string(FILE *f, const char *str)
+{
+	if (!str) {
+		fputs("null", f);
+		return;
+	}
+
+	fputc('"', f);
+	for (; *str; str++) {
+		unsigned char c = (unsigned char)*str;
+
+		if (c == '"' || c == '\\') {
+			fprintf(f, "\\%c", c);
+		} else if (c < 0x20) {
+			fprintf(f, "\\u%04x", c);
+		} else {
+			fputc(c, f);
+		}
+	}
+	fputc('"', f);
+}
+
+/**
+ * Write the results as JSON
+ */
+static void bench_report(FILE *f, int32_t turns, uint64_t nsec)
+{
+	double secs = nsec / 1.0e9;
+	int i;
+
+	fprintf(f, "{\n");
+	fprintf(f, "  \"build\": ");
+	bench_json_string(f, buildid);
+	fprintf(f, ",\n");
+	fprintf(f, "  \"seed\": %lu,\n", (unsigned long)seed);
+	fprintf(f, "  \"script\": ");
+	bench_json_string(f, script_name);
+	fprintf(f, ",\n");
+	fprintf(f, "  \"profiling\": %s,\n",
+		profile_is_enabled() ? "true" : "false");
+	fprintf(f, "  \"game_turns\": %ld,\n", (long)turns);
+	fprintf(f, "  \"player_commands\": %lu,\n", (unsigned long)player_cmds);
+	fprintf(f, "  \"levels\": %d,\n", levels);
+	fprintf(f, "  \"final_depth\": %d,\n", player->depth);
+	fprintf(f, "  \"died\": %s,\n", player->is_dead ? "true" : "false");
+	fprintf(f, "  \"seconds\": %.6f,\n", secs);
+	fprintf(f, "  \"turns_per_second\": %.1f,\n",
+		secs > 0 ? turns / secs : 0.0);
+	fprintf(f, "  \"regions\": {");
+	for (i = 0; i < PROF_MAX; i++) {
+		struct profile_counter *counter = &profile_counters[i];
+		double ms = counter->nsec / 1.0e6;
+
+		fprintf(f, "%s\n    \"%s\": { \"calls\": %lu, \"ms\": %.3f, "
+			"\"us_per_call\": %.3f, \"share\": %.4f }", i ? "," : "",
+			profile_region_name(i), (unsigned long)counter->calls, ms,
+			counter->calls ? ms * 1000.0 / counter->calls : 0.0,
+			nsec ? (double)counter->nsec / nsec : 0.0);
+	}
+	fprintf(f, "\n  }\n}\n");
+}
+
+static errr run_bench(void)
+{
+	int32_t start_turn;
+	uint64_t start, elapsed;
+	int stuck = 0;
+
+	if (script_name) {
+		script = file_open(script_name, MODE_READ, -1);
+		if (!script) quit_fmt("Couldn't open script %s", script_name);
+	}
+
+	/* Make a character, with a deterministic random number generator */
+	Rand_quick = false;
+	Rand_state_init(seed);
+	if (!player_make_simple(NULL, NULL, NULL, "Bench")) {
+		quit("Couldn't make a character");
+	}
+	OPT(player, auto_more) = true;
+	OPT(player, cheat_live) = true;
+	get_check_hook = bench_get_check;
+	player->upkeep->autosave = false;
+	event_add_handler(EVENT_NEW_LEVEL_DISPLAY, bench_new_level, NULL);
+
+	prepare_next_level(player);
+	on_new_level();
+	levels = 0;
+
+	/*
+	 * textui_init() hides the map until ui_enter_world() shows it, and the
+	 * benchmark never goes through that; without this, no monster would
+	 * ever be seen, and so never fought
+	 */
+	while (screen_save_depth > 0) screen_save_depth--;
+
+	if (!quiet) {
+		printf("Running %ld game turns with seed %lu...\n", (long)num_turns,
+			(unsigned long)seed);
+		fflush(stdout);
+	}
+
+	/* Only time the run itself */
+	profile_reset();
+	start_turn = turn;
+	start = profile_now();
+
+	while (turn - start_turn < num_turns && !player->is_dead) {
+		int32_t before = turn;
+
+		if (stuck >= BENCH_MAX_STUCK) {
+			cmdq_push(CMD_HOLD);
+		} else if (auto_cmds > 0 || !bench_script_command()) {
+			bench_auto_command();
+		}
+		player_cmds++;
+		level_cmds++;
+
+		run_game_loop();
+		bench_sustain_player();
+
+		stuck = (turn == before) ? stuck + 1 : 0;
+	}
+
+	elapsed = profile_now() - start;
+
+	if (output_name) {
+		FILE *f = fopen(output_name, "w");
+
+		if (!f) quit_fmt("Couldn't write %s", output_name);
+		bench_report(f, turn - start_turn, elapsed);
+		fclose(f);
+	} else {
+		bench_report(stdout, turn - start_turn, elapsed);
+	}
+
+	if (script) file_close(script);
+	event_remove_handler(EVENT_NEW_LEVEL_DISPLAY, bench_new_level, NULL);
+	cleanup_angband();
+	quit(NULL);
+	exit(0);
+}
+
+typedef struct term_data term_data;
+struct term_data {
+	term t;
+};
+
+static term_data td;
+typedef struct {
+	int key;
+	errr (*func)(int v);
+} term_xtra_func;
+
+static void term_init_bench(term *t) {
+	return;
+}
+
+static void term_nuke_bench(term *t) {
+	return;
+}
+
+static errr term_xtra_clear(int v) {
+	return 0;
+}
+
+static errr term_xtra_noise(int v) {
+	return 0;
+}
+
+static errr term_xtra_fresh(int v) {
+	return 0;
+}
+
+static errr term_xtra_shape(int v) {
+	return 0;
+}
+
+static errr term_xtra_alive(int v) {
+	return 0;
+}
+
+static errr term_xtra_event(int v) {
+	/* Anything asking for input during the run gets cancelled */
+	if (running_bench) {
+		Term_keypress(ESCAPE, 0);
+		return 0;
+	}
+	running_bench = 1;
+	return run_bench();
+}
+
+static errr term_xtra_flush(int v) {
+	return 0;
+}
+
+static errr term_xtra_delay(int v) {
+	return 0;
+}
+
+static errr term_xtra_react(int v) {
+	return 0;
+}
+
+static term_xtra_func xtras[] = {
+	{ TERM_XTRA_CLEAR, term_xtra_clear },
+	{ TERM_XTRA_NOISE, term_xtra_noise },
+	{ TERM_XTRA_FRESH, term_xtra_fresh },
+	{ TERM_XTRA_SHAPE, term_xtra_shape },
+	{ TERM_XTRA_ALIVE, term_xtra_alive },
+	{ TERM_XTRA_EVENT, term_xtra_event },
+	{ TERM_XTRA_FLUSH, term_xtra_flush },
+	{ TERM_XTRA_DELAY, term_xtra_delay },
+	{ TERM_XTRA_REACT, term_xtra_react },
+	{ 0, NULL },
+};
+
+static errr term_xtra_bench(int n, int v) {
+	int i;
+	for (i = 0; xtras[i].func; i++) {
+		if (xtras[i].key == n) {
+			return xtras[i].func(v);
+		}
+	}
+	return 0;
+}
+
+static errr term_curs_bench(int x, int y) {
+	return 0;
+}
+
+static errr term_wipe_bench(int x, int y, int n) {
+	return 0;
+}
+
+static errr term_text_bench(int x, int y, int n, int a, const wchar_t *s) {
+	return 0;
+}
+
+static void term_data_link(int i) {
+	term *t = &td.t;
+
+	term_init(t, 80, 24, 256);
+
+	/* Ignore some actions for efficiency and safety */
+	t->never_bored = true;
+	t->never_frosh = true;
+
+	t->init_hook = term_init_bench;
+	t->nuke_hook = term_nuke_bench;
+
+	t->xtra_hook = term_xtra_bench;
+	t->curs_hook = term_curs_bench;
+	t->wipe_hook = term_wipe_bench;
+	t->text_hook = term_text_bench;
+
+	t->data = &td;
+
+	Term_activate(t);
+
+	angband_term[i] = t;
+}
+
+const char help_bench[] = "Benchmark mode, subopts -q(uiet) -sSEED -tTURNS -cSCRIPT -oOUTPUT";
+
+/**
+ * Usage:
+ *
+ * angband -mbench -- [-q] [-sSEED] [-tTURNS] [-cSCRIPT] [-oOUTPUT]
+ *
+ *   -q        Quiet mode (turn off progress messages)
+ *   -sSEED    Seed for the random number generator (default: 1)
+ *   -tTURNS   Run for TURNS game turns (default: 10000)
+ *   -cSCRIPT  Play the commands in SCRIPT before handing over to the
+ *             autoplayer.  Each line is one of walk, run, alter, open, close,
+ *             tunnel or disarm followed by a direction; hold, down or up;
+ *             pathfind followed by x and y; or auto followed by a number of
+ *             commands to let the autoplayer choose.  Lines starting with #
+ *             are ignored.
+ *   -oOUTPUT  Write the JSON results to OUTPUT rather than standard output
+ */
+errr init_bench(int argc, char *argv[]) {
+	int i;
+
+	/* Skip over argv[0] */
+	for (i = 1; i < argc; i++) {
+		if (streq(argv[i], "-q")) {
+			quiet = true;
+			continue;
+		}
+		if (prefix(argv[i], "-s")) {
+			seed = strtoul(&argv[i][2], NULL, 10);
+			continue;
+		}
+		if (prefix(argv[i], "-t")) {
+			num_turns = atoi(&argv[i][2]);
+			continue;
+		}
+		if (prefix(argv[i], "-c")) {
+			script_name = &argv[i][2];
+			continue;
+		}
+		if (prefix(argv[i], "-o")) {
+			output_name = &argv[i][2];
+			continue;
+		}
+		printf("init-bench: bad argument '%s'\n", argv[i]);
+	}
+
+	/* Don't touch the player's savefile */
+	savefile[0] = '\0';
+
+	term_data_link(0);
+	return 0;
+}
+
+#endif /* USE_BENCH */
@@ -21,6 +21,10 @@
 #include "buildid.h"
 #include "cmds.h"
 #include "cave.h"
+#include "cmd-core.h"
+#include "game-event.h"
+#include "player-util.h"
+#include "profile.h"
 #include "ui-command.h"
 #include "ui-display.h"
 #include "ui-prefs.h"
@@ -164,6 +168,24 @@ static term_data data[MAX_TERM_DATA];
 /* Number of initialized "term" structures */
 static int active = 0;
 
+/**
+ * Output is composited: every window is staged with wnoutrefresh() and the
+ * terminal only gets written by the one doupdate() in gcu_flush().  That
+ * happens once per EVENT_REFRESH, and before anything which leaves the
+ * screen on show (waiting for a key, or a delay).  'frame_pending' notes
+ * staged output which has not been sent yet.
+ */
+static bool frame_pending = false;
+
+/**
+ * Shortest time between frames while running, resting or repeating a
+ * command, in nanoseconds; 0 for no limit
+ */
+static uint64_t frame_interval = 0;
+
+/* When the last frame was sent */
+static uint64_t frame_last = 0;
+
 #ifdef A_COLOR
 
 /**
@@ -219,6 +241,17 @@ static int bg_color = COLOR_BLACK;
 #define PAIR_CYAN_CYAN 14
 #define PAIR_BLACK_BLACK 15
 
+/**
+ * The colours last given to each colour pair and colour number.  Redefining
+ * a pair makes curses repaint every cell drawn with it, so init_pair() and
+ * init_color() are only called when something actually changes.
+ */
+#define MAX_CACHED_PAIR (2 * BASIC_COLORS)
+static bool pair_cached[MAX_CACHED_PAIR];
+static short pair_cache[MAX_CACHED_PAIR][2];
+static bool color_cached[BASIC_COLORS];
+static short color_cache[BASIC_COLORS][3];
+
 #endif
 
 /**
@@ -289,6 +322,43 @@ static void keymap_game_prepare(void) {
 }
 
 
+/**
+ * Stage a window for the next frame
+ */
+static void gcu_stage(WINDOW *win) {
+	wnoutrefresh(win);
+	frame_pending = true;
+}
+
+
+/**
+ * Send everything staged since the last frame to the terminal at once
+ */
+static void gcu_flush(void) {
+	if (!frame_pending) return;
+	doupdate();
+	frame_pending = false;
+	if (frame_interval) frame_last = profile_now();
+}
+
+
+/**
+ * End a game frame.  While the game carries on without the player, frames
+ * arriving faster than the cap allows are left staged, to go out with the
+ * next one.
+ */
+static void gcu_refresh(game_event_type type, game_event_data *data,
+		void *user) {
+	if (frame_interval && frame_pending && player &&
+			(player->upkeep->running || player_is_resting(player) ||
+			cmd_get_nrepeats() > 0) &&
+			profile_now() - frame_last < frame_interval) {
+		return;
+	}
+	gcu_flush();
+}
+
+
 /**
  * Suspend/Resume
  */
@@ -343,16 +413,19 @@ const char help_gcu[] = "Text mode, subopts\n"
 	"              -B     Use brighter bold characters\n"
 	"              -D     Use terminal default background color\n"
 	"              -K     Keep terminal's color table when changing colors\n"
-	"              -nN    Use N terminals (up to 6)";
+	"              -nN    Use N terminals (up to 6)\n"
+	"              -fN    Draw at most N frames a second when running";
 
 /**
  * Usage:
  *
- * narsil -mgcu -- [-B] [-D] [-nN]
+ * narsil -mgcu -- [-B] [-D] [-nN] [-fN]
  *
  *   -B      Use brighter bold characters
  *   -D      Use terminal default background color
  *   -nN     Use N terminals (up to 6)
+ *   -fN     Draw at most N frames a second when running, resting or
+ *           repeating a command
  */
 
 #ifdef MSYS2_ENCODING_WORKAROUND
@@ -795,11 +868,13 @@ static errr Term_xtra_gcu_event(int v) {
 	if (v) {
 		/* Wait for a keypress; use halfdelay(1) so if the user takes more */
 		/* than 0.2 seconds we get a chance to do updates. */
+		gcu_flush();
 		halfdelay(2);
 		i = getch();
 		while (i == ERR) {
 			i = getch();
 			idle_update();
+			gcu_flush();
 		}
 		cbreak();
 	} else {
@@ -949,6 +1024,42 @@ static errr Term_xtra_gcu_event(int v) {
 	return (0);
 }
 
+#ifdef A_COLOR
+/**
+ * Define a colour pair, unless it already has those colours
+ */
+static void gcu_init_pair(int pair, int fg, int bg) {
+	if (pair < MAX_CACHED_PAIR) {
+		if (pair_cached[pair] && pair_cache[pair][0] == fg &&
+				pair_cache[pair][1] == bg) {
+			return;
+		}
+		pair_cached[pair] = true;
+		pair_cache[pair][0] = fg;
+		pair_cache[pair][1] = bg;
+	}
+	init_pair(pair, fg, bg);
+}
+
+/**
+ * Define a colour, unless it already has those components
+ */
+static void gcu_init_color(int color, int r, int g, int b) {
+	if (color < BASIC_COLORS) {
+		if (color_cached[color] && color_cache[color][0] == r &&
+				color_cache[color][1] == g &&
+				color_cache[color][2] == b) {
+			return;
+		}
+		color_cached[color] = true;
+		color_cache[color][0] = r;
+		color_cache[color][1] = g;
+		color_cache[color][2] = b;
+	}
+	init_color(color, r, g, b);
+}
+#endif
+
 static int scale_color(int i, int j, int scale) {
 	return (angband_color_table[i][j] * (scale - 1) + 127) / 255;
 }
@@ -999,9 +1110,9 @@ static void handle_extended_color_tables(void) {
 			bg_color = create_color(COLOUR_DARK, scale);
 			for (i = 0; i < BASIC_COLORS; i++) {
 				int fg = create_color(i, scale);
-				init_pair(i + 1, fg, bg_color);
+				gcu_init_pair(i + 1, fg, bg_color);
 				colortable[i] = COLOR_PAIR(i + 1) | isbold;
-				init_pair(BASIC_COLORS + i, fg, fg);
+				gcu_init_pair(BASIC_COLORS + i, fg, fg);
 				same_colortable[i] =
 					COLOR_PAIR(BASIC_COLORS + i) | isbold;
 			}
@@ -1012,13 +1123,13 @@ static void handle_extended_color_tables(void) {
 				 * Scale components to a range of 0 - 1000 per
 				 * init_color()'s documentation.
 				 */
-				init_color(i,
+				gcu_init_color(i,
 					(angband_color_table[i][1] * 1001) / 256,
 					(angband_color_table[i][2] * 1001) / 256,
 					(angband_color_table[i][3] * 1001) / 256);
-				init_pair(i + 1, i, bg_color);
+				gcu_init_pair(i + 1, i, bg_color);
 				colortable[i] = COLOR_PAIR(i + 1) | isbold;
-				init_pair(BASIC_COLORS + i, i, i);
+				gcu_init_pair(BASIC_COLORS + i, i, i);
 				same_colortable[i] =
 					COLOR_PAIR(BASIC_COLORS + i) | isbold;
 			}
@@ -1040,7 +1151,7 @@ static void handle_extended_color_tables(void) {
 
 			if (getbkgd(stdscr) != term0_bkg) {
 				wbkgd(stdscr, term0_bkg);
-				wrefresh(stdscr);
+				gcu_stage(stdscr);
 			}
 		}
 	}
@@ -1062,8 +1173,8 @@ static errr Term_xtra_gcu(int n, int v) {
 		/* Make a noise */
 		case TERM_XTRA_NOISE: PLATFORM_WRITE(1, "\007", 1); return 0;
 
-		/* Flush the Curses buffer */
-		case TERM_XTRA_FRESH: wrefresh(td->win); return 0;
+		/* Stage the window; the frame goes out later in one doupdate() */
+		case TERM_XTRA_FRESH: gcu_stage(td->win); return 0;
 
 #ifdef USE_CURS_SET
 		/* Change the cursor visibility */
@@ -1080,7 +1191,10 @@ static errr Term_xtra_gcu(int n, int v) {
 		case TERM_XTRA_FLUSH: while (!Term_xtra_gcu_event(false)); return 0;
 
 		/* Delay */
-		case TERM_XTRA_DELAY: if (v > 0) usleep(1000 * v); return 0;
+		case TERM_XTRA_DELAY:
+			gcu_flush();
+			if (v > 0) usleep(1000 * v);
+			return 0;
 
 		/* React to events */
 		case TERM_XTRA_REACT: handle_extended_color_tables(); return 0;
@@ -1298,6 +1412,9 @@ errr init_gcu(int argc, char **argv) {
 			use_default_background = true;
 		} else if (streq(argv[i], "-K")) {
 			keep_terminal_colors = true;
+		} else if (prefix(argv[i], "-f")) {
+			int fps = atoi(&argv[i][2]);
+			frame_interval = (fps > 0) ? 1000000000 / fps : 0;
 		}
 	}
 
@@ -1321,6 +1438,13 @@ errr init_gcu(int argc, char **argv) {
 	/* Activate hooks */
 	quit_aux = hook_quit;
 
+	/*
+	 * Send each game frame out in one go.  Handlers run newest first, so
+	 * this runs after the refresh the display code adds on entering the
+	 * world.
+	 */
+	event_add_handler(EVENT_REFRESH, gcu_refresh, NULL);
+
 	/* Require standard size screen */
 	if (LINES < MIN_TERM0_LINES || COLS < MIN_TERM0_COLS) 
 		quit("Angband needs at least an 80x24 'curses' screen");
@@ -1340,23 +1464,23 @@ errr init_gcu(int argc, char **argv) {
 	if (can_use_color) {
 		/* Prepare the color pairs */
 		/* PAIR_WHITE (pair 0) is *always* WHITE on BLACK */
-		init_pair(PAIR_RED, COLOR_RED, bg_color);
-		init_pair(PAIR_GREEN, COLOR_GREEN, bg_color);
-		init_pair(PAIR_YELLOW, COLOR_YELLOW, bg_color);
-		init_pair(PAIR_BLUE, COLOR_BLUE, bg_color);
-		init_pair(PAIR_MAGENTA, COLOR_MAGENTA, bg_color);
-		init_pair(PAIR_CYAN, COLOR_CYAN, bg_color);
-		init_pair(PAIR_BLACK, COLOR_BLACK, bg_color);
+		gcu_init_pair(PAIR_RED, COLOR_RED, bg_color);
+		gcu_init_pair(PAIR_GREEN, COLOR_GREEN, bg_color);
+		gcu_init_pair(PAIR_YELLOW, COLOR_YELLOW, bg_color);
+		gcu_init_pair(PAIR_BLUE, COLOR_BLUE, bg_color);
+		gcu_init_pair(PAIR_MAGENTA, COLOR_MAGENTA, bg_color);
+		gcu_init_pair(PAIR_CYAN, COLOR_CYAN, bg_color);
+		gcu_init_pair(PAIR_BLACK, COLOR_BLACK, bg_color);
 
 		/* These pairs are used for drawing solid walls */
-		init_pair(PAIR_WHITE_WHITE, COLOR_WHITE, COLOR_WHITE);
-		init_pair(PAIR_RED_RED, COLOR_RED, COLOR_RED);
-		init_pair(PAIR_GREEN_GREEN, COLOR_GREEN, COLOR_GREEN);
-		init_pair(PAIR_YELLOW_YELLOW, COLOR_YELLOW, COLOR_YELLOW);
-		init_pair(PAIR_BLUE_BLUE, COLOR_BLUE, COLOR_BLUE);
-		init_pair(PAIR_MAGENTA_MAGENTA, COLOR_MAGENTA, COLOR_MAGENTA);
-		init_pair(PAIR_CYAN_CYAN, COLOR_CYAN, COLOR_CYAN);
-		init_pair(PAIR_BLACK_BLACK, COLOR_BLACK, COLOR_BLACK);
+		gcu_init_pair(PAIR_WHITE_WHITE, COLOR_WHITE, COLOR_WHITE);
+		gcu_init_pair(PAIR_RED_RED, COLOR_RED, COLOR_RED);
+		gcu_init_pair(PAIR_GREEN_GREEN, COLOR_GREEN, COLOR_GREEN);
+		gcu_init_pair(PAIR_YELLOW_YELLOW, COLOR_YELLOW, COLOR_YELLOW);
+		gcu_init_pair(PAIR_BLUE_BLUE, COLOR_BLUE, COLOR_BLUE);
+		gcu_init_pair(PAIR_MAGENTA_MAGENTA, COLOR_MAGENTA, COLOR_MAGENTA);
+		gcu_init_pair(PAIR_CYAN_CYAN, COLOR_CYAN, COLOR_CYAN);
+		gcu_init_pair(PAIR_BLACK_BLACK, COLOR_BLACK, COLOR_BLACK);
 
 		/* Prepare the colors */
 		colortable[COLOUR_DARK]     = (COLOR_PAIR(PAIR_BLACK));
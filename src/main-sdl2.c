@@ -268,10 +268,36 @@ static const char g_ascii_codepoints_for_cache[] =
  * displays, anyway) */
 #define ASCII_CACHE_SIZE \
 		(N_ELEMENTS(g_ascii_codepoints_for_cache) - 1)
+/* Anything else is rendered on first use into a grid of slots in one more
+ * texture; when the grid is full, the glyph drawn longest ago gives up its slot */
+#define GLYPH_ATLAS_COLS 16
+#define GLYPH_ATLAS_ROWS 16
+#define GLYPH_ATLAS_SLOTS (GLYPH_ATLAS_COLS * GLYPH_ATLAS_ROWS)
+#define GLYPH_ATLAS_BUCKETS 64
+struct glyph_slot {
+	uint32_t codepoint;
+	/* atlas clock when the glyph was last drawn */
+	uint32_t stamp;
+	/* next slot + 1 in the same hash bucket; 0 ends the chain */
+	int next;
+	/* the font has nothing to show for this codepoint */
+	bool blank;
+	SDL_Rect rect;
+};
+struct glyph_atlas {
+	SDL_Texture *texture;
+	struct glyph_slot slots[GLYPH_ATLAS_SLOTS];
+	/* first slot + 1 for each hash bucket; 0 if empty */
+	int buckets[GLYPH_ATLAS_BUCKETS];
+	/* number of slots handed out so far */
+	int used;
+	uint32_t clock;
+};
 struct font_cache {
 	SDL_Texture *texture;
 	/* it wastes some space... so what? */
 	SDL_Rect rects[ASCII_CACHE_SIZE];
+	struct glyph_atlas atlas;
 };
 /* 0 is also a valid codepoint, of course... that's just for finding bugs */
 #define IS_CACHED_ASCII_CODEPOINT(c) \
@@ -919,10 +945,86 @@ static void render_utf8_string(const struct window *window,
 	SDL_DestroyTexture(src_texture);
 }
 
+/* finds the atlas slot for a codepoint, rendering the glyph into the slot
+ * (and so changing the render target back to dst_texture) if it isn't there
+ * yet; returns NULL if the font can't render the codepoint */
+static const struct glyph_slot *get_atlas_glyph(const struct window *window,
+		struct font *font, SDL_Texture *dst_texture, uint32_t codepoint)
+{
+	struct glyph_atlas *atlas = &font->cache.atlas;
+	int bucket = (int) (codepoint % GLYPH_ATLAS_BUCKETS);
+	struct glyph_slot *slot;
+	int i;
+
+	for (i = atlas->buckets[bucket]; i != 0; i = slot->next) {
+		slot = &atlas->slots[i - 1];
+		if (slot->codepoint == codepoint) {
+			slot->stamp = ++atlas->clock;
+			return slot->blank ? NULL : slot;
+		}
+	}
+
+	if (atlas->used < GLYPH_ATLAS_SLOTS) {
+		i = atlas->used++;
+	} else {
+		/* evict the least recently drawn glyph */
+		i = 0;
+		for (int j = 1; j < GLYPH_ATLAS_SLOTS; j++) {
+			if (atlas->slots[j].stamp < atlas->slots[i].stamp) {
+				i = j;
+			}
+		}
+
+		int *link = &atlas->buckets[atlas->slots[i].codepoint
+				% GLYPH_ATLAS_BUCKETS];
+		while (*link != i + 1) {
+			link = &atlas->slots[*link - 1].next;
+		}
+		*link = atlas->slots[i].next;
+	}
+
+	slot = &atlas->slots[i];
+	slot->codepoint = codepoint;
+	slot->stamp = ++atlas->clock;
+	slot->next = atlas->buckets[bucket];
+	atlas->buckets[bucket] = i + 1;
+	slot->rect.x = (i % GLYPH_ATLAS_COLS) * font->ttf.glyph.w;
+	slot->rect.y = (i / GLYPH_ATLAS_COLS) * font->ttf.glyph.h;
+	slot->rect.w = font->ttf.glyph.w;
+	slot->rect.h = font->ttf.glyph.h;
+
+	/* wipe whatever was there before; glyphs are rendered in white */
+	SDL_Color white = {0xFF, 0xFF, 0xFF, 0};
+	render_fill_rect(window, atlas->texture, &slot->rect, &white);
+	white.a = 0xFF;
+
+	slot->blank = true;
+	SDL_Surface *surface = TTF_RenderGlyph_Blended(font->ttf.handle,
+			(Uint16) codepoint, white);
+	if (surface != NULL) {
+		SDL_Texture *texture =
+			SDL_CreateTextureFromSurface(window->renderer, surface);
+		if (texture != NULL) {
+			SDL_Rect src = {0, 0, surface->w, surface->h};
+			SDL_Rect dst = slot->rect;
+
+			crop_rects(&src, &dst);
+			SDL_RenderCopy(window->renderer, texture, &src, &dst);
+			SDL_DestroyTexture(texture);
+			slot->blank = false;
+		}
+		SDL_FreeSurface(surface);
+	}
+
+	SDL_SetRenderTarget(window->renderer, dst_texture);
+
+	return slot->blank ? NULL : slot;
+}
+
 /* this function is typically called in a loop, so for efficiency it doesn't
  * SetRenderTarget; caller must do it (but it does SetTextureColorMod) */
 static void render_glyph_mono(const struct window *window,
-		const struct font *font, SDL_Texture *dst_texture,
+		struct font *font, SDL_Texture *dst_texture,
 		int x, int y, const SDL_Color *fg, uint32_t codepoint)
 {
 	if (codepoint == ' ') {
@@ -941,23 +1043,20 @@ static void render_glyph_mono(const struct window *window,
 		SDL_RenderCopy(window->renderer,
 				font->cache.texture, &font->cache.rects[codepoint], &dst);
 	} else {
-		SDL_Surface *surface = TTF_RenderGlyph_Blended(font->ttf.handle,
-				(Uint16) codepoint, *fg);
-		if (surface == NULL) {
+		const struct glyph_slot *slot =
+			get_atlas_glyph(window, font, dst_texture, codepoint);
+		if (slot == NULL) {
 			return;
 		}
 
-		SDL_Texture *texture = SDL_CreateTextureFromSurface(window->renderer, surface);
-		assert(texture != NULL);
-
-		SDL_Rect src = {0, 0, surface->w, surface->h};
+		SDL_Rect src = slot->rect;
 
 		crop_rects(&src, &dst);
 
-		SDL_RenderCopy(window->renderer, texture, &src, &dst);
+		SDL_SetTextureColorMod(font->cache.atlas.texture, fg->r, fg->g, fg->b);
 
-		SDL_FreeSurface(surface);
-		SDL_DestroyTexture(texture);
+		SDL_RenderCopy(window->renderer,
+				font->cache.atlas.texture, &src, &dst);
 	}
 }
 
@@ -4709,6 +4808,13 @@ static void make_font_cache(const struct window *window, struct font *font)
 		SDL_FreeSurface(surface);
 		SDL_DestroyTexture(texture);
 	}
+
+	/* the rest is filled in as glyphs are needed */
+	font->cache.atlas.texture = make_subwindow_texture(window,
+			GLYPH_ATLAS_COLS * glyph_w, GLYPH_ATLAS_ROWS * glyph_h);
+	assert(font->cache.atlas.texture != NULL);
+	white.a = 0;
+	render_clear(window, font->cache.atlas.texture, &white);
 }
 
 static struct font *make_font(const struct window *window,
@@ -4808,6 +4914,9 @@ static void free_font(struct font *font)
 	if (font->cache.texture != NULL) {
 		SDL_DestroyTexture(font->cache.texture);
 	}
+	if (font->cache.atlas.texture != NULL) {
+		SDL_DestroyTexture(font->cache.atlas.texture);
+	}
 
 	mem_free(font);
 }
@@ -6222,6 +6331,10 @@ static void init_systems(void)
 
 	SDL_StartTextInput();
 	SDL_SetHint(SDL_HINT_VIDEO_MINIMIZE_ON_FOCUS_LOSS, "0");
+#ifdef SDL_HINT_RENDER_BATCHING
+	/* let the renderer queue up the glyph copies for a row */
+	SDL_SetHint(SDL_HINT_RENDER_BATCHING, "1");
+#endif
 #ifdef SDL_HINT_POLL_SENTINEL
 	SDL_SetHint(SDL_HINT_POLL_SENTINEL, "0");
 #endif
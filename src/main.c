@@ -87,6 +87,10 @@ static const struct module modules[] =
 	{ "stats", help_stats, init_stats },
 #endif /* USE_STATS */
 
+#ifdef USE_BENCH
+	{ "bench", help_bench, init_bench },
+#endif /* USE_BENCH */
+
 #ifdef USE_SPOIL
 	{ "spoil", help_spoil, init_spoil },
 #endif
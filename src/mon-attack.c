@@ -105,11 +105,9 @@ static int choose_ranged_attack(struct monster *mon)
 	int best_spell, best_spell_rating = 0;
 	int i;
 
-	/* Extract the racial spell flags */
-	rsf_copy(f, mon->race->spell_flags);
-
-	/* Remove spells that cost too much or have unfulfilled conditions */
-	remove_bad_spells(mon, f);
+	/* Racial spells, less those that cost too much or have unfulfilled
+	 * conditions */
+	monster_usable_spells(mon, f);
 
 	/* No spells left */
 	if (!rsf_count(f)) return 0;
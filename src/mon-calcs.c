@@ -38,6 +38,7 @@
 #include "player-timed.h"
 #include "player-util.h"
 #include "player.h"
+#include "profile.h"
 #include "project.h"
 #include "songs.h"
 
@@ -214,12 +215,12 @@ void calc_morale(struct monster *mon)
 	/* Reduce morale for the Majesty ability */
     difference = MAX(player->state.skill_use[SKILL_WILL]
 					 - monster_skill(mon, SKILL_WILL), 0);
-	if (player_active_ability(player, "Majesty")) {
+	if (player_active_ability(player, PA_MAJESTY)) {
 		morale -= difference / 2 * 10;
 	}
 
 	/* Reduce morale for the Bane ability */
-	if (player_active_ability(player, "Bane")) {
+	if (player_active_ability(player, PA_BANE)) {
 		morale -= player_bane_bonus(player, mon) * 10;
 	}
 
@@ -500,7 +501,7 @@ static void listen(struct chunk *c, struct player *p, struct monster *mon)
 	mon->noise = 0;
 
 	/* Must have the listen skill */
-	if (!player_active_ability(p, "Listen")) return;
+	if (!player_active_ability(p, PA_LISTEN)) return;
 
 	/* Must not be visible */
 	if (monster_is_visible(mon)) return;
@@ -704,7 +705,7 @@ void update_mon(struct monster *mon, struct chunk *c, bool full)
 					do_invisible = true;
 
 					/* Keen senses */
-					if (player_active_ability(player, "Keen Senses")) {
+					if (player_active_ability(player, PA_KEEN_SENSES)) {
 						/* Makes things a bit easier */
 						difficulty -= 5;
 					}
@@ -849,6 +850,8 @@ void update_monsters(bool full)
 {
 	int i;
 
+	PROFILE_START(update_monsters);
+
 	/* Update each (live) monster */
 	for (i = 1; i < cave_monster_max(cave); i++) {
 		struct monster *mon = cave_monster(cave, i);
@@ -857,6 +860,8 @@ void update_monsters(bool full)
 		if (mon->race)
 			update_mon(mon, cave, full);
 	}
+
+	PROFILE_STOP(update_monsters);
 }
 
 /**
@@ -338,7 +338,7 @@ void monster_group_new_wandering_flow(struct chunk *c, struct monster *mon,
 		if (rf_has(race->flags, RF_SMART) &&
 			!rf_has(race->flags, RF_TERRITORIAL) &&
 			(player->depth != z_info->dun_depth) && one_in_(5) &&
-			cave_find(c, &grid, square_isstairs) &&
+			cave_find_class(c, &grid, GRID_CLASS_STAIR) &&
 			!square_isplayer(c, grid) && !square_isvault(c, grid)) {
 			/* Sometimes intelligent monsters want to pick a staircase and leave
 			 * the level */
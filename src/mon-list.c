@@ -18,6 +18,7 @@
  */
 
 #include "game-world.h"
+#include "init.h"
 #include "mon-desc.h"
 #include "mon-list.h"
 #include "mon-move.h"
@@ -44,6 +45,7 @@ monster_list_t *monster_list_new(void)
 	}
 
 	list->entries_size = size;
+	list->race_entry = mem_zalloc(z_info->r_max * sizeof(uint16_t));
 
 	return list;
 }
@@ -61,6 +63,7 @@ void monster_list_free(monster_list_t *list)
 		list->entries = NULL;
 	}
 
+	mem_free(list->race_entry);
 	mem_free(list);
 	list = NULL;
 }
@@ -113,9 +116,14 @@ static bool monster_list_can_update(const monster_list_t *list)
 /**
  * Zero out the contents of a monster list. If needed, this function will
  * reallocate the entry list if the number of monsters has changed.
+ *
+ * The races already in the list stay where they are, so that after the next
+ * collection the list is still mostly in order.
  */
 void monster_list_reset(monster_list_t *list)
 {
+	int i;
+
 	if (list == NULL || list->entries == NULL)
 		return;
 
@@ -125,10 +133,16 @@ void monster_list_reset(monster_list_t *list)
 		list->entries_size = cave_monster_max(cave);
 	}
 
-	memset(list->entries, 0, list->entries_size * sizeof(monster_list_entry_t));
+	for (i = 0; i < list->distinct_entries; i++) {
+		struct monster_race *race = list->entries[i].race;
+		memset(&list->entries[i], 0, sizeof(monster_list_entry_t));
+		list->entries[i].race = race;
+	}
+	memset(list->entries + list->distinct_entries, 0,
+		(list->entries_size - list->distinct_entries)
+		* sizeof(monster_list_entry_t));
 	memset(list->total_entries, 0, MONSTER_LIST_SECTION_MAX * sizeof(uint16_t));
 	memset(list->total_monsters, 0, MONSTER_LIST_SECTION_MAX * sizeof(uint16_t));
-	list->distinct_entries = 0;
 	list->creation_turn = 0;
 	list->sorted = false;
 }
@@ -138,7 +152,7 @@ void monster_list_reset(monster_list_t *list)
  */
 void monster_list_collect(monster_list_t *list)
 {
-	int i;
+	int i, n = 0;
 
 	if (list == NULL || list->entries == NULL)
 		return;
@@ -150,7 +164,7 @@ void monster_list_collect(monster_list_t *list)
 	for (i = 1; i < cave_monster_max(cave); i++) {
 		struct monster *mon = cave_monster(cave, i);
 		monster_list_entry_t *entry = NULL;
-		int j, field;
+		int field;
 		bool los = false;
 
 		/* Only consider visible, known monsters */
@@ -158,19 +172,13 @@ void monster_list_collect(monster_list_t *list)
 			continue;
 
 		/* Find or add a list entry. */
-		for (j = 0; j < (int)list->entries_size; j++) {
-			if (list->entries[j].race == NULL) {
-				/* We found an empty slot, so add this race here. */
-				entry = &list->entries[j];
-				memset(entry, 0, sizeof(monster_list_entry_t));
-				entry->race = mon->race;
-				break;
-			}
-			else if (list->entries[j].race == mon->race) {
-				/* We found a matching race and we'll use that. */
-				entry = &list->entries[j];
-				break;
-			}
+		if (list->race_entry[mon->race->ridx]) {
+			entry = &list->entries[list->race_entry[mon->race->ridx] - 1];
+		} else if (list->distinct_entries < list->entries_size) {
+			entry = &list->entries[list->distinct_entries++];
+			memset(entry, 0, sizeof(monster_list_entry_t));
+			entry->race = mon->race;
+			list->race_entry[mon->race->ridx] = list->distinct_entries;
 		}
 
 		if (entry == NULL)
@@ -200,11 +208,26 @@ void monster_list_collect(monster_list_t *list)
 		entry->dy[field] = mon->grid.y - player->grid.y;
 	}
 
-	/* Collect totals for easier calculations of the list. */
-	for (i = 0; i < (int)list->entries_size; i++) {
-		if (list->entries[i].race == NULL)
+	/* Drop races no longer seen, keeping the rest in order */
+	for (i = 0; i < list->distinct_entries; i++) {
+		monster_list_entry_t *entry = &list->entries[i];
+
+		if (!entry->count[MONSTER_LIST_SECTION_LOS] &&
+			!entry->count[MONSTER_LIST_SECTION_ESP]) {
+			list->race_entry[entry->race->ridx] = 0;
 			continue;
+		}
+		list->entries[n++] = *entry;
+		list->race_entry[entry->race->ridx] = n;
+	}
+	if (n < list->distinct_entries) {
+		memset(list->entries + n, 0,
+			(list->distinct_entries - n) * sizeof(monster_list_entry_t));
+	}
+	list->distinct_entries = n;
 
+	/* Collect totals for easier calculations of the list. */
+	for (i = 0; i < list->distinct_entries; i++) {
 		if (list->entries[i].count[MONSTER_LIST_SECTION_LOS] > 0)
 			list->total_entries[MONSTER_LIST_SECTION_LOS]++;
 
@@ -215,7 +238,6 @@ void monster_list_collect(monster_list_t *list)
 			list->entries[i].count[MONSTER_LIST_SECTION_LOS];
 		list->total_monsters[MONSTER_LIST_SECTION_ESP] +=
 			list->entries[i].count[MONSTER_LIST_SECTION_ESP];
-		list->distinct_entries++;
 	}
 
 	list->creation_turn = turn;
@@ -292,7 +314,13 @@ void monster_list_sort(monster_list_t *list,
 	if (elements <= 1)
 		return;
 
-	sort(list->entries, MIN(elements, list->entries_size), sizeof(list->entries[0]), compare);
+	sort_insertion(list->entries, MIN(elements, list->entries_size),
+		sizeof(list->entries[0]), compare);
+
+	/* Entries have moved, so note where each race is now */
+	for (elements = 0; elements < list->distinct_entries; elements++) {
+		list->race_entry[list->entries[elements].race->ridx] = elements + 1;
+	}
 	list->sorted = true;
 }
 
@@ -44,6 +44,7 @@ typedef struct monster_list_s {
 	bool sorted;
 	uint16_t total_entries[MONSTER_LIST_SECTION_MAX];
 	uint16_t total_monsters[MONSTER_LIST_SECTION_MAX];
+	uint16_t *race_entry; /* One more than the entry for each race, or 0 */
 } monster_list_t;
 
 monster_list_t *monster_list_new(void);
@@ -1398,7 +1398,7 @@ bool pick_and_place_monster_on_stairs(struct chunk *c, struct player *p,
 	if (in_tutorial() || p->game_type > 0)	return false;
 
 	/* Get a stair location */
-	if (!cave_find(c, &stair, square_isstairs))	return false;
+	if (!cave_find_class(c, &stair, GRID_CLASS_STAIR)) return false;
 
 	/* Default the new location to this location */
 	grid = stair;
@@ -1547,9 +1547,11 @@ bool pick_and_place_distant_monster(struct chunk *c, struct player *p,
 	assert(c);
 
 	/* Find a legal, distant, unoccupied, space */
+	if (!c->floor_count) attempts_left = 1;
 	while (--attempts_left) {
-		/* Pick a location */
-		grid = loc(randint0(c->width), randint0(c->height));
+		/* Pick a location; only floor grids can be empty */
+		int n = c->floor_grids[randint0(c->floor_count)];
+		grid = loc(n % c->width, n / c->width);
 
 		/* Require "naked" floor grid */
 		if (!square_isempty(c, grid)) continue;
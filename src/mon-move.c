@@ -52,6 +52,7 @@
 #include "player-calcs.h"
 #include "player-timed.h"
 #include "player-util.h"
+#include "profile.h"
 #include "project.h"
 #include "songs.h"
 #include "trap.h"
@@ -1006,8 +1007,7 @@ static bool get_move_retreat(struct monster *mon, struct loc *tgrid)
 		/* The 'score to beat' as the score for the monster's current square */
 		dist = distance_squared(mon->grid, player->grid);
 		best_score += dist;
-		if (projectable(cave, mon->grid, player->grid, PROJECT_STOP) &&
-			(mon->cdis > 1)) {
+		if (monster_target_path(mon, PROJECT_STOP) && (mon->cdis > 1)) {
 			best_score += 100;
 		}
 
@@ -1752,8 +1752,7 @@ static bool get_move(struct monster *mon, struct loc *tgrid, bool *fear,
 	if ((!*fear) && (mon->cdis <= 3) && square_isview(cave, mon->grid) &&
 		(rf_has(race->flags, RF_FRIENDS) || rf_has(race->flags, RF_FRIEND))) {
 		/* Only if we do not have a clean path to player */
-		if (projectable(cave, mon->grid, player->grid, PROJECT_CHCK)
-			!= PROJECT_PATH_CLEAR) {
+		if (monster_target_path(mon, PROJECT_CHCK) != PROJECT_PATH_CLEAR) {
 			start = randint0(8);
 
 			/* Find a random empty square next to the player to head for */
@@ -3601,7 +3600,7 @@ static void process_monster_recover(struct monster *mon)
 	if (!los(cave, mon->grid, player->grid) &&
 		(mon->alertness >= ALERTNESS_ALERT) && 
 	    (mon->stance != STANCE_FLEEING) && (mon->race->sleep > 0)) {
-		int bonus = player_active_ability(player, "Vanish") ? 15 : 25;
+		int bonus = player_active_ability(player, PA_VANISH) ? 15 : 25;
 		int result = skill_check(source_monster(mon->midx), 
 		                         monster_skill(mon, SKILL_PERCEPTION) + bonus,
 		                         player->state.skill_use[SKILL_STEALTH] +
@@ -3644,6 +3643,8 @@ void process_monsters(int minimum_energy)
 	/* If time is stopped, no monsters can move */
 	if (OPT(player, cheat_timestop)) return;
 
+	PROFILE_START(process_monsters);
+
 	/* Regenerate hitpoints and mana every 100 game turns */
 	if (turn % 10 == 0)
 		regen = true;
@@ -3705,7 +3706,9 @@ void process_monsters(int minimum_energy)
 		cave->mon_current = i;
 
 		/* The monster takes its turn */
+		PROFILE_START(monster_turn);
 		monster_turn(mon);
+		PROFILE_STOP(monster_turn);
 
 		/* Monster is no longer current */
 		cave->mon_current = -1;
@@ -3714,6 +3717,8 @@ void process_monsters(int minimum_energy)
 	/* Update monster visibility after this */
 	/* XXX This may not be necessary */
 	player->upkeep->update |= PU_MONSTERS;
+
+	PROFILE_STOP(process_monsters);
 }
 
 /**
@@ -172,8 +172,7 @@ void message_warning(struct monster *mon)
 	add_monster_message(mon, msg_code, false);
 
 	/* Hard not to notice */
-	cave->monster_noise.centre = mon->grid;
-	update_flow(cave, &cave->monster_noise, NULL);
+	update_noise_flow(cave, mon->grid);
 	monsters_hear(false, false, -10);
 
 	/* Makes monster noise too */
@@ -17,6 +17,7 @@
  */
 #include "angband.h"
 #include "effects.h"
+#include "game-world.h"
 #include "init.h"
 #include "mon-attack.h"
 #include "mon-desc.h"
@@ -231,8 +232,68 @@ static void spell_message(struct monster *mon,
 	msgt(spell->msgt, "%s", buf);
 }
 
+/**
+ * Get the monster's decision for this turn, starting it afresh if it was
+ * made on another turn or anything it depends on has changed.
+ */
+static struct monster_decision *monster_decision(struct monster *mon)
+{
+	struct monster_decision *decision = &mon->decision;
+
+	if ((decision->turn != turn) || !loc_eq(decision->grid, mon->grid) ||
+			!loc_eq(decision->target, player->grid) ||
+			(decision->mana != mon->mana) ||
+			(decision->stance != mon->stance)) {
+		decision->turn = turn;
+		decision->grid = mon->grid;
+		decision->target = player->grid;
+		decision->mana = mon->mana;
+		decision->stance = mon->stance;
+		decision->path = -1;
+		decision->check = -1;
+		decision->spells_known = false;
+	}
+	return decision;
+}
+
+/**
+ * Whether a monster can project to its target, as projectable() with flg,
+ * which must be PROJECT_STOP or PROJECT_CHCK.  The answer is kept for the
+ * rest of the monster's turn.
+ */
+int monster_target_path(struct monster *mon, int flg)
+{
+	struct monster_decision *decision = monster_decision(mon);
+	int *path = (flg == PROJECT_STOP) ? &decision->path : &decision->check;
+
+	assert((flg == PROJECT_STOP) || (flg == PROJECT_CHCK));
+	if (*path < 0) {
+		*path = projectable(cave, mon->grid, decision->target, flg);
+	}
+	return *path;
+}
+
+/**
+ * Fill in the spells a monster could sensibly cast at its target this turn;
+ * see remove_bad_spells().
+ */
+void monster_usable_spells(struct monster *mon, bitflag f[RSF_SIZE])
+{
+	struct monster_decision *decision = monster_decision(mon);
+
+	if (!decision->spells_known) {
+		rsf_copy(decision->spells, mon->race->spell_flags);
+		remove_bad_spells(mon, decision->spells);
+		decision->spells_known = true;
+	}
+	rsf_copy(f, decision->spells);
+}
+
 /**
  * Return the chance of a monster casting a spell this turn
+ *
+ * A monster with no line of fire to its target has nothing to cast, so
+ * gets no chance; that saves choosing among its spells to find that out.
  */
 int monster_cast_chance(struct monster *mon)
 {
@@ -253,6 +314,11 @@ int monster_cast_chance(struct monster *mon)
 	/* Stunned monsters use ranged attacks half as often. */
 	if (mon->m_timed[MON_TMD_STUN]) chance /= 2;
 
+	/* Nothing to aim at */
+	if (chance && (monster_target_path(mon, PROJECT_STOP) == PROJECT_PATH_NO)) {
+		chance = 0;
+	}
+
 	return chance;
 }
 
@@ -408,14 +474,13 @@ static void monster_get_target_dist_grid(struct monster *mon, int *dist,
 void remove_bad_spells(struct monster *mon, bitflag f[RSF_SIZE])
 {
 	int tdist;
-	struct loc tgrid;
 	int path, i;
 
 	/* Get distance from the player */
-	monster_get_target_dist_grid(mon, &tdist, &tgrid);
+	monster_get_target_dist_grid(mon, &tdist, NULL);
 
 	/* Do we have the player in sight at all? */
-	path = projectable(cave, mon->grid, tgrid, PROJECT_STOP);
+	path = monster_target_path(mon, PROJECT_STOP);
 	if (path == PROJECT_PATH_NO) {
 		rsf_wipe(f);
 		return;
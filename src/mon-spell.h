@@ -60,6 +60,8 @@ enum mon_spell_type {
 
 /** Functions **/
 const struct monster_spell *monster_spell_by_index(int index);
+int monster_target_path(struct monster *mon, int flg);
+void monster_usable_spells(struct monster *mon, bitflag f[RSF_SIZE]);
 int monster_cast_chance(struct monster *mon);
 void do_mon_spell(int index, struct monster *mon, bool seen);
 void remove_bad_spells(struct monster *mon, bitflag f[RSF_SIZE]);
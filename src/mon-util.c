@@ -412,7 +412,7 @@ void monster_swap(struct loc grid1, struct loc grid2)
 	square_light_spot(cave, grid2);
 
 	/* Deal with set polearm attacks */
-	if (player_active_ability(player, "Polearm Mastery") && m1_is_monster) {
+	if (player_active_ability(player, PA_POLEARM_MASTERY) && m1_is_monster) {
 		player_polearm_passive_attack(player, grid1, grid2);
 	}
 
@@ -578,7 +578,7 @@ void monsters_hear(bool player_centered, bool main_roll, int difficulty)
 			}
 
 			/* Bonus reduced if the player has 'disguise' */
-			if (player_active_ability(player, "Disguise")) {
+			if (player_active_ability(player, PA_DISGUISE)) {
 				m_perception += (open_squares + combat_sight_bonus) / 2;
 			} else {
 				m_perception += open_squares + combat_sight_bonus;
@@ -1133,6 +1133,7 @@ bool monster_carry(struct chunk *c, struct monster *mon, struct object *obj)
 		player->cave->objects[obj->oidx] = obj->known;
 	}
 	pile_insert(&mon->held_obj, obj);
+	set_artifact_object(obj);
 
 	/* Result */
 	return true;
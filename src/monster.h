@@ -286,6 +286,23 @@ enum monster_group_role {
 	MON_GROUP_MEMBER
 };
 
+/**
+ * What a monster has worked out about attacking its target this turn; made
+ * afresh on a new turn or when the monster, its target, its mana or its
+ * stance change.  A path of -1 means it has not been traced yet.
+ */
+struct monster_decision {
+	int32_t turn;			/* Game turn the decision was made, or 0 */
+	struct loc grid;		/* Where the monster was */
+	struct loc target;		/* Where its target was */
+	uint8_t mana;			/* The monster's mana */
+	uint8_t stance;			/* The monster's stance */
+	int path;				/* projectable() to the target, stopping */
+	int check;				/* projectable() to the target, checking */
+	bool spells_known;		/* Whether spells has been filled in */
+	bitflag spells[RSF_SIZE];	/* Spells worth casting */
+};
+
 /**
  * Monster group info
  */
@@ -421,6 +438,7 @@ struct monster {
 	struct player_state known_pstate;	/* Known player state */
 
 	struct target target;			/* Monster target */
+	struct monster_decision decision;	/* Ranged attack decision this turn */
 
 	struct monster_group_info group_info; /* Monster group details */
 	struct flow flow;			/* Monster pathfinding flow */
@@ -41,6 +41,7 @@ enum {
 	CHEST_NEEDLE_LOSE_STR = 0x20
 };
 
+extern struct chest_trap *chest_traps;
 extern struct file_parser chest_trap_parser;
 
 const char *chest_trap_name(const struct object *obj);
@@ -431,7 +431,7 @@ static size_t obj_desc_charges(const struct object *obj, char *buf, size_t max,
 	if (!tval_can_have_charges(obj)) return end;
 
 	/* Wands and staffs have charges, others may be charging */
-	if (aware || player_active_ability(player, "Channeling")) {
+	if (aware || player_active_ability(player, PA_CHANNELING)) {
 		strnfcat(buf, max, &end, " (%d charge%s)", obj->pval,
 				 PLURAL(obj->pval));
 	} else if ((obj->used > 0) && !(obj->notice & OBJ_NOTICE_EMPTY)) {
@@ -401,7 +401,7 @@ bool minus_ac(struct player *p)
 				obj->ps--;
 			}
 
-			p->upkeep->update |= (PU_BONUS);
+			equip_bonuses_changed(p, obj);
 			p->upkeep->redraw |= (PR_EQUIP);
 		}
 
@@ -481,6 +481,7 @@ void gear_insert_end(struct player *p, struct object *obj)
 {
 	pile_insert_end(&p->gear, obj);
 	pile_insert_end(&p->gear_k, obj->known);
+	set_artifact_object(obj);
 }
 
 /**
@@ -617,7 +618,7 @@ bool handle_stickied_removal(struct player *p, struct object *obj)
 		return false;
 	}
 
-	if (player_active_ability(player, "Curse Breaking")) {
+	if (player_active_ability(player, PA_CURSE_BREAKING)) {
 		msg("With a great strength of will, you break the curse!");
 		uncurse_object(obj);
 		return false;
@@ -943,8 +944,10 @@ void inven_wield(struct object *obj, int slot)
 	pack_overflow(old);
 
 	/* Recalculate bonuses, torch, mana, gear */
+	equip_bonuses_changed(player, wielded);
 	player->upkeep->notice |= (PN_IGNORE);
-	player->upkeep->update |= (PU_BONUS | PU_INVEN | PU_UPDATE_VIEW);
+	player->upkeep->update |= (PU_BONUS | PU_ABILITIES | PU_INVEN |
+		PU_UPDATE_VIEW);
 	player->upkeep->redraw |= (PR_INVEN | PR_EQUIP | PR_ARC | PR_ARMOR);
 	player->upkeep->redraw |= (PR_MELEE | PR_STATS | PR_HP | PR_MANA |PR_SPEED);
 	update_stuff(player);
@@ -996,7 +999,8 @@ void inven_takeoff(struct object *obj)
 		remove_ability(&player->item_abilities, ability);
 	}
 
-	player->upkeep->update |= (PU_BONUS | PU_INVEN | PU_UPDATE_VIEW);
+	player->upkeep->update |= (PU_BONUS | PU_ABILITIES | PU_INVEN |
+		PU_UPDATE_VIEW);
 	player->upkeep->notice |= (PN_IGNORE);
 	update_stuff(player);
 
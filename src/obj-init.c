@@ -2655,6 +2655,7 @@ static void cleanup_artifact(void)
 	}
 	mem_free(a_info);
 	mem_free(aup_info);
+	aup_info = NULL;
 }
 
 struct file_parser artifact_parser = {
@@ -2719,6 +2720,7 @@ static errr finish_parse_randart(struct parser *p) {
 		aup_info[aidx].created = false;
 		aup_info[aidx].seen = false;
 		aup_info[aidx].everseen = false;
+		aup_info[aidx].obj = NULL;
 	}
 	z_info->a_max = new_max;
 
@@ -721,6 +721,7 @@ void object_touch(struct player *p, struct object *obj)
 
 	/* Apply known properties to the object */
 	player_know_object(p, obj);
+	equip_bonuses_changed(p, obj);
 
 	/* Log artifacts if found */
 	if (obj->artifact && !is_artifact_seen(obj->artifact)) {
@@ -762,12 +763,12 @@ void player_know_object(struct player *p, struct object *obj)
 	}
 
 	/* Know flavored objects with Item Lore */
-	if (player_active_ability(p, "Item Lore")) {
+	if (player_active_ability(p, PA_ITEM_LORE)) {
 		object_flavor_aware(p, obj);
 	}
 
 	/* Know worn objects with Lore-Master */
-	if (player_active_ability(p, "Lore-Master")) {
+	if (player_active_ability(p, PA_LORE_MASTER)) {
 		while (!object_runes_known(obj)) {
 			object_learn_unknown_rune(p, obj);
 		}
@@ -924,9 +925,26 @@ void update_player_object_knowledge(struct player *p)
 		for (i = 0; i < cave->obj_max; i++)
 			player_know_object(p, cave->objects[i]);
 
-	/* Player objects */
-	for (obj = p->gear; obj; obj = obj->next)
+	/* Player objects, noting any change in what is known of worn ones */
+	for (obj = p->gear; obj; obj = obj->next) {
+		bitflag flags[OF_SIZE];
+		struct element_info el_info[ELEM_MAX];
+		const struct ego_item *ego;
+
+		if (!obj->known || !object_is_equipped(p->body, obj)) {
+			player_know_object(p, obj);
+			continue;
+		}
+		of_copy(flags, obj->known->flags);
+		memcpy(el_info, obj->known->el_info, sizeof(el_info));
+		ego = obj->known->ego;
 		player_know_object(p, obj);
+		if (!of_is_equal(flags, obj->known->flags)
+				|| memcmp(el_info, obj->known->el_info, sizeof(el_info))
+				|| ego != obj->known->ego) {
+			equip_bonuses_changed(p, obj);
+		}
+	}
 
 	/* Update */
 	if (cave)
@@ -1230,6 +1248,7 @@ void object_learn_unknown_rune(struct player *p, struct object *obj)
 	if (i < 0) {
 		obj->known->notice |= OBJ_NOTICE_ASSESSED;
 		player_know_object(player, obj);
+		equip_bonuses_changed(p, obj);
 		return;
 	}
 
@@ -1505,6 +1524,7 @@ void object_flavor_aware(struct player *p, struct object *obj)
 
 	if (obj->kind->aware) return;
 	obj->kind->aware = true;
+	equip_bonuses_changed(p, NULL);
 
 	/* Quit if no dungeon yet */
 	if (!cave) return;
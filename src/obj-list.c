@@ -63,6 +63,7 @@ void object_list_free(object_list_t *list)
 		list->entries = NULL;
 	}
 
+	mem_free(list->object_entry);
 	mem_free(list);
 }
 
@@ -113,19 +114,31 @@ static bool object_list_needs_update(const object_list_t *list)
 
 /**
  * Zero out the contents of an object list.
+ *
+ * Each entry keeps the index of its object, so that the objects still there
+ * at the next collection are in the same order and sorting has little to do.
+ * The objects themselves may be gone by then, so are forgotten.
  */
 void object_list_reset(object_list_t *list)
 {
+	int i;
+
 	if (list == NULL || list->entries == NULL)
 		return;
 
 	if (!object_list_needs_update(list))
 		return;
 
-	memset(list->entries, 0, list->entries_size * sizeof(object_list_entry_t));
+	for (i = 0; i < list->distinct_entries; i++) {
+		uint16_t oidx = list->entries[i].oidx;
+		memset(&list->entries[i], 0, sizeof(object_list_entry_t));
+		list->entries[i].oidx = oidx;
+	}
+	memset(list->entries + list->distinct_entries, 0,
+		(list->entries_size - list->distinct_entries)
+		* sizeof(object_list_entry_t));
 	memset(list->total_entries, 0, OBJECT_LIST_SECTION_MAX * sizeof(uint16_t));
 	memset(list->total_objects, 0, OBJECT_LIST_SECTION_MAX * sizeof(uint16_t));
-	list->distinct_entries = 0;
 	list->creation_turn = 0;
 	list->sorted = false;
 }
@@ -149,7 +162,7 @@ static bool object_list_should_ignore_object(const struct player *p,
  */
 void object_list_collect(object_list_t *list)
 {
-	int i;
+	int i, n = 0;
 	struct loc pgrid = player->grid;
 
 	if (list == NULL || list->entries == NULL)
@@ -158,10 +171,19 @@ void object_list_collect(object_list_t *list)
 	if (!object_list_needs_update(list))
 		return;
 
+	/* Make sure every object index can be looked up */
+	if (list->object_entry_size < player->cave->obj_max) {
+		list->object_entry = mem_realloc(list->object_entry,
+			player->cave->obj_max * sizeof(uint16_t));
+		memset(list->object_entry + list->object_entry_size, 0,
+			(player->cave->obj_max - list->object_entry_size)
+			* sizeof(uint16_t));
+		list->object_entry_size = player->cave->obj_max;
+	}
+
 	/* Scan each object in the dungeon. */
 	for (i = 1; i < player->cave->obj_max; i++) {
 		object_list_entry_t *entry = NULL;
-		int entry_index;
 		int current_distance;
 		int entry_distance;
 		struct loc grid;
@@ -184,26 +206,26 @@ void object_list_collect(object_list_t *list)
 
 		if (object_list_should_ignore_object(player, obj)) continue;
 
-		/* Find or add a list entry. */
-		for (entry_index = 0; entry_index < (int)list->entries_size;
-			 entry_index++) {
-			int j;
-			struct object *list_obj = list->entries[entry_index].object;
-
-			if (list_obj == NULL) {
-				/* We found an empty slot, so add this object here. */
-				list->entries[entry_index].object = obj;
-				for (j = 0; j < OBJECT_LIST_SECTION_MAX; j++)
-					list->entries[entry_index].count[j] = 0;
-				list->entries[entry_index].dy = grid.y - pgrid.y;
-				list->entries[entry_index].dx = grid.x - pgrid.x;
-				entry = &list->entries[entry_index];
-				break;
-			}
+		/* Find the entry kept from last time, or add one */
+		if (list->object_entry[i]) {
+			entry = &list->entries[list->object_entry[i] - 1];
+		} else if (list->distinct_entries < list->entries_size) {
+			entry = &list->entries[list->distinct_entries++];
+			entry->oidx = i;
+			list->object_entry[i] = list->distinct_entries;
 		}
 
 		if (entry == NULL)
-			return;
+			continue;
+
+		if (entry->object == NULL) {
+			int j;
+			entry->object = obj;
+			for (j = 0; j < OBJECT_LIST_SECTION_MAX; j++)
+				entry->count[j] = 0;
+			entry->dy = grid.y - pgrid.y;
+			entry->dx = grid.x - pgrid.x;
+		}
 
 		/* We only know the number of objects we've actually seen */
 		if (obj->kind == cave->objects[obj->oidx]->kind)
@@ -223,11 +245,26 @@ void object_list_collect(object_list_t *list)
 		}
 	}
 
-	/* Collect totals for easier calculations of the list. */
-	for (i = 0; i < (int)list->entries_size; i++) {
-		if (list->entries[i].object == NULL)
+	/* Drop objects no longer listed, keeping the rest in order */
+	for (i = 0; i < list->distinct_entries; i++) {
+		object_list_entry_t *entry = &list->entries[i];
+
+		if (entry->object == NULL) {
+			if (entry->oidx < list->object_entry_size)
+				list->object_entry[entry->oidx] = 0;
 			continue;
+		}
+		list->entries[n++] = *entry;
+		list->object_entry[entry->oidx] = n;
+	}
+	if (n < list->distinct_entries) {
+		memset(list->entries + n, 0,
+			(list->distinct_entries - n) * sizeof(object_list_entry_t));
+	}
+	list->distinct_entries = n;
 
+	/* Collect totals for easier calculations of the list. */
+	for (i = 0; i < list->distinct_entries; i++) {
 		if (list->entries[i].count[OBJECT_LIST_SECTION_LOS] > 0)
 			list->total_entries[OBJECT_LIST_SECTION_LOS]++;
 
@@ -238,7 +275,6 @@ void object_list_collect(object_list_t *list)
 			list->entries[i].count[OBJECT_LIST_SECTION_LOS];
 		list->total_objects[OBJECT_LIST_SECTION_NO_LOS] +=
 			list->entries[i].count[OBJECT_LIST_SECTION_NO_LOS];
-		list->distinct_entries++;
 	}
 
 	list->creation_turn = turn;
@@ -304,7 +340,12 @@ void object_list_sort(object_list_t *list,
 	if (elements <= 1)
 		return;
 
-	sort(list->entries, elements, sizeof(list->entries[0]), compare);
+	sort_insertion(list->entries, elements, sizeof(list->entries[0]), compare);
+
+	/* Entries have moved, so note where each object is now */
+	for (elements = 0; elements < list->distinct_entries; elements++) {
+		list->object_entry[list->entries[elements].oidx] = elements + 1;
+	}
 	list->sorted = true;
 }
 
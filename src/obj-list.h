@@ -29,6 +29,7 @@ typedef enum object_list_section_e {
 
 typedef struct object_list_entry_s {
 	struct object *object;
+	uint16_t oidx;
 	uint16_t count[OBJECT_LIST_SECTION_MAX];
 	int16_t dx, dy;
 } object_list_entry_t;
@@ -41,6 +42,8 @@ typedef struct object_list_s {
 	uint16_t total_entries[OBJECT_LIST_SECTION_MAX];
 	uint16_t total_objects[OBJECT_LIST_SECTION_MAX];
 	bool sorted;
+	uint16_t *object_entry; /* One more than each object's entry, or 0 */
+	size_t object_entry_size;
 } object_list_t;
 
 object_list_t *object_list_new(void);
@@ -292,6 +292,7 @@ struct object *object_new(void)
  */
 void object_free(struct object *obj)
 {
+	forget_artifact_object(obj);
 	mem_free(obj->slays);
 	mem_free(obj->brands);
 	release_ability_list(obj->abilities);
@@ -327,6 +328,9 @@ void object_delete(struct chunk *c, struct chunk *p_c,
 	if (player && player->upkeep && obj == player->upkeep->object)
 		player->upkeep->object = NULL;
 
+	/* An orphaned artifact is no longer anywhere to be found */
+	forget_artifact_object(obj);
+
 	/* Orphan rather than actually delete if we still have a known object */
 	if (c && p_c && obj->oidx && (obj == c->objects[obj->oidx]) &&
 		p_c->objects[obj->oidx]) {
@@ -904,9 +908,11 @@ bool floor_carry(struct chunk *c, struct loc grid, struct object *drop,
 
 	/* Link to the first object in the pile */
 	pile_insert(&c->squares[grid.y][grid.x].obj, drop);
+	square_note_pile(c, grid);
 
 	/* Record in the level list */
 	list_object(c, drop);
+	set_artifact_object(drop);
 
 	/* If there's a known version, put it in the player's view of the
 	 * cave but at an unknown location.  square_note_spot() will move
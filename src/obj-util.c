@@ -589,7 +589,7 @@ bool obj_can_refuel(const struct object *obj)
 bool obj_can_takeoff(const struct object *obj)
 {
 	return !obj_has_flag(obj, OF_CURSED)
-		|| player_active_ability(player, "Curse Breaking");
+		|| player_active_ability(player, PA_CURSE_BREAKING);
 }
 
 /*
@@ -773,6 +773,7 @@ void uncurse_object(struct object *obj)
 
 	player->upkeep->notice |= (PN_COMBINE);
 	player->upkeep->update |= (PU_BONUS);
+	equip_bonuses_changed(player, obj);
 	player->upkeep->redraw |= (PR_EQUIP | PR_INVEN);
 }
 
@@ -949,6 +950,41 @@ void mark_artifact_everseen(const struct artifact *art, bool seen)
 	aup_info[art->aidx].everseen = seen;
 }
 
+/**
+ * Return the object for the given artifact if it is on the level, in the
+ * player's gear or held by a monster, or NULL otherwise.
+ */
+struct object *artifact_object(const struct artifact *art)
+{
+	assert(art->aidx == aup_info[art->aidx].aidx);
+	return aup_info[art->aidx].obj;
+}
+
+/**
+ * Record a real (not known) artifact object as it is placed on the level,
+ * in the player's gear or in a monster's inventory.  Does nothing for
+ * ordinary objects.
+ */
+void set_artifact_object(struct object *obj)
+{
+	if (!obj->artifact) return;
+	assert(obj->artifact->aidx == aup_info[obj->artifact->aidx].aidx);
+	aup_info[obj->artifact->aidx].obj = obj;
+}
+
+/**
+ * Stop recording an object as its artifact's instance; called as the object
+ * is deleted or orphaned.  Copies of the recorded object are left alone.
+ */
+void forget_artifact_object(const struct object *obj)
+{
+	/* Objects may outlive the artifact data at shutdown */
+	if (!obj->artifact || !aup_info) return;
+	if (aup_info[obj->artifact->aidx].obj == obj) {
+		aup_info[obj->artifact->aidx].obj = NULL;
+	}
+}
+
 /**
  * Write ability lines for a set of abilities.
  */
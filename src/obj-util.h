@@ -76,6 +76,9 @@ bool is_artifact_everseen(const struct artifact *art);
 void mark_artifact_created(const struct artifact *art, bool created);
 void mark_artifact_seen(const struct artifact *art, bool seen);
 void mark_artifact_everseen(const struct artifact *art, bool seen);
+struct object *artifact_object(const struct artifact *art);
+void set_artifact_object(struct object *obj);
+void forget_artifact_object(const struct object *obj);
 void write_self_made_artefact_entries(ang_file *fff);
 
 #endif /* OBJECT_UTIL_H */
@@ -67,6 +67,7 @@ struct effect {
 	int radius;		/**< Radius of the effect (if it has one) */
 	int other;		/**< Extra parameter to be passed to the handler */
 	char *msg;		/**< Message for death or whatever */
+	struct effect_op *code;	/**< Compiled chain, on its first effect only */
 };
 
 /**
@@ -295,13 +296,15 @@ struct artifact {
 
 /**
  * Information about artifacts that changes during the course of play;
- * except for aidx, saved to the save file
+ * except for aidx and obj, saved to the save file
  */
 struct artifact_upkeep {
 	uint32_t aidx;	/**< For cross-indexing with struct artifact */
 	bool created;	/**< Whether this artifact has been created */
 	bool seen;	/**< Whether this artifact has been seen this game */
 	bool everseen;	/**< Whether this artifact has ever been seen  */
+	struct object *obj;	/**< The artifact on the level, in the player's
+				gear or held by a monster, if any */
 };
 
 /**
@@ -29,6 +29,12 @@
 
 struct ability *abilities;
 
+static const char *ability_names[] = {
+	#define PA(a, b) b,
+	#include "list-player-abilities.h"
+	#undef PA
+};
+
 /**
  * ------------------------------------------------------------------------
  * Initialize abilities
@@ -56,8 +62,13 @@ static enum parser_error parse_ability_skill(struct parser *p) {
 static enum parser_error parse_ability_name(struct parser *p) {
 	const char *name = parser_getstr(p, "name");
 	struct ability *last = parser_priv(p);
-	struct ability *a = mem_zalloc(sizeof *a);
+	int index = lookup_player_ability(name);
+	struct ability *a;
 
+	if (index < 0)
+		return PARSE_ERROR_INVALID_ABILITY;
+	a = mem_zalloc(sizeof *a);
+	a->index = index;
 	if (last) {
 		last->next = a;
 	} else {
@@ -248,6 +259,20 @@ struct file_parser ability_parser = {
  * ------------------------------------------------------------------------
  * Ability utilities
  * ------------------------------------------------------------------------ */
+/**
+ * Find the PA_ index of an ability name, or -1 if there is none
+ */
+int lookup_player_ability(const char *name)
+{
+	int i;
+	for (i = 0; i < PA_MAX; i++) {
+		if (streq(ability_names[i], name)) {
+			return i;
+		}
+	}
+	return -1;
+}
+
 /**
  * Find an ability given its name and skill
  */
@@ -285,46 +310,6 @@ static int count_abilities(struct ability *ability, int skill)
 	return count;
 }
 
-static bool ability_is_active(const struct ability *ability)
-{
-	return ability->active;
-}
-
-static int test_ability(const char *name, struct ability *test,
-						ability_predicate pred)
-{
-	int skill, count = 0;
-	bool found = false;
-
-	if (!test) return 0;
-
-	/* Look in every skill for an ability with the right name */
-	for (skill = 0; skill < SKILL_MAX; skill++) {
-		struct ability *ability = lookup_ability(skill, name);
-		if (ability) {
-			struct ability *thisa = test;
-
-			/* Note that we have found an ability of that name */
-			found = true;
-
-			/* See if the provided ability list contains the named one... */
-			while (thisa) {
-				if (streq(thisa->name, name) && (thisa->skill == skill)) {
-					/* ...and if so, if it satisfies any required condition */
-					if (!pred || (pred && pred(thisa))) {
-						count++;
-					}
-				}
-				thisa = thisa->next;
-			}
-		}
-	}
-	if (!found) {
-		assert(0);
-	}
-	return count;
-}
-
 /**
  * Does the given object type support the given ability type?
  */
@@ -338,7 +323,7 @@ bool applicable_ability(struct ability *ability, struct object *obj)
 
 	/* Throwing Mastery is OK for throwing items */
 	if (of_has(obj->flags, OF_THROWING) && (ability->skill == SKILL_MELEE) &&
-		streq(ability->name, "Throwing Mastery")) {
+		(ability->index == PA_THROWING_MASTERY)) {
 		return true;
 	}
 
@@ -430,15 +415,41 @@ bool player_has_ability(struct player *p, struct ability *ability)
 	return false;
 }
 
-int player_active_ability(struct player *p, const char *name)
+/**
+ * Count the active abilities of the player with the given PA_ index; this
+ * can be more than one for those like Dexterity which several skills have
+ */
+int player_active_ability_count(struct player *p, int index)
 {
-	int count;
-	if (!p) return 0;
-	count = test_ability(name, p->abilities, ability_is_active);
-	count += test_ability(name, p->item_abilities, ability_is_active);
+	struct ability *ability;
+	int count = 0;
+
+	for (ability = p->abilities; ability; ability = ability->next) {
+		if (ability->active && (ability->index == index)) count++;
+	}
+	for (ability = p->item_abilities; ability; ability = ability->next) {
+		if (ability->active && (ability->index == index)) count++;
+	}
 	return count;
 }
 
+/**
+ * Rebuild the set of the player's active abilities from the innate and
+ * item ability lists
+ */
+void player_update_active_abilities(struct player *p)
+{
+	struct ability *ability;
+
+	pa_wipe(p->active_abilities);
+	for (ability = p->abilities; ability; ability = ability->next) {
+		if (ability->active) pa_on(p->active_abilities, ability->index);
+	}
+	for (ability = p->item_abilities; ability; ability = ability->next) {
+		if (ability->active) pa_on(p->active_abilities, ability->index);
+	}
+}
+
 bool player_has_prereq_abilities(struct player *p, struct ability *ability)
 {
 	struct ability *prereqs = ability->prerequisites;
@@ -498,7 +509,7 @@ bool player_gain_ability(struct player *p, struct ability *ability)
 	 * is not.  Having that indicated in ability.txt seems like overkill
 	 * to avoid an update_bonuses() call.
 	 */
-	p->upkeep->update |= (PU_BONUS);
+	p->upkeep->update |= (PU_BONUS | PU_ABILITIES);
 	p->upkeep->redraw |= (PR_EXP);
 	return true;
 }
@@ -27,6 +27,7 @@ struct ability {
 	struct ability *next;
 	char *name;
 	char *desc;
+	int index;		/* PA_ index, shared by abilities with the same name */
 	uint8_t skill;
 	uint8_t level;
 	bool active;
@@ -39,11 +40,13 @@ struct ability {
 extern struct ability *abilities;
 
 /**
- * ability_predicate is a function pointer which tests a given ability to
- * see if the predicate in question is true.
+ * Test whether the player has an active ability, given its PA_ index.  The
+ * set tested is rebuilt by calc_bonuses() after PU_ABILITIES is flagged.
  */
-typedef bool (*ability_predicate)(const struct ability *test);
+#define player_active_ability(p, index) \
+	(pa_has((p)->active_abilities, (index)))
 
+int lookup_player_ability(const char *name);
 struct ability *lookup_ability(int skill, const char *name);
 bool applicable_ability(struct ability *ability, struct object *obj);
 struct ability *locate_ability(struct ability *ability, struct ability *test);
@@ -51,7 +54,8 @@ void add_ability(struct ability **set, struct ability *add);
 void activate_ability(struct ability **set, struct ability *activate);
 void remove_ability(struct ability **ability, struct ability *remove);
 bool player_has_ability(struct player *p, struct ability *ability);
-int player_active_ability(struct player *p, const char *name);
+int player_active_ability_count(struct player *p, int index);
+void player_update_active_abilities(struct player *p);
 bool player_has_prereq_abilities(struct player *p, struct ability *ability);
 int player_ability_cost(struct player *p, struct ability *ability);
 bool player_can_gain_ability(struct player *p, struct ability *ability);
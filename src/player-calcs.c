@@ -39,6 +39,7 @@
 #include "player-calcs.h"
 #include "player-timed.h"
 #include "player-util.h"
+#include "profile.h"
 #include "project.h"
 #include "songs.h"
 
@@ -105,7 +106,7 @@ uint8_t total_mds(struct player *p, struct player_state *state,
 		}
 		
 		/* Apply the Momentum ability */
-		if (player_active_ability(p, "Momentum")) {
+		if (player_active_ability(p, PA_MOMENTUM)) {
 			divisor /= 2;
 		}
 
@@ -123,7 +124,7 @@ uint8_t total_mds(struct player *p, struct player_state *state,
 	int_mds += state->to_mds;
 
 	/* Bonus for users of 'mighty blows' ability */
-	if (player_active_ability(p, "Power")) {
+	if (player_active_ability(p, PA_POWER)) {
 		int_mds += 1;
 	}
 
@@ -190,7 +191,7 @@ int axe_bonus(struct player *p, const struct object *obj)
  */
 int polearm_bonus(struct player *p, const struct object *obj)
 {
-	if (player_active_ability(p, "Polearm Mastery") &&
+	if (player_active_ability(p, PA_POLEARM_MASTERY) &&
 		of_has(obj->kind->flags, OF_POLEARM)) {
 		return 1;
 	}
@@ -211,7 +212,7 @@ uint8_t total_ads(struct player *p, struct player_state *state,
 	
 	str_to_ads = state->stat_use[STAT_STR];
 
-	if (player_active_ability(p, "Rapid Fire") && !single_shot) {
+	if (player_active_ability(p, PA_RAPID_FIRE) && !single_shot) {
 		str_to_ads -= 3;
 	}
 
@@ -572,8 +573,7 @@ bool weapon_glows(struct object *obj, int near)
 	}
 
 	/* Create a 'flow' around the object */
-	cave->monster_noise.centre = obj_grid;
-	update_flow(cave, &cave->monster_noise, NULL);
+	update_noise_flow(cave, obj_grid);
 
 	/* Add up the total of creatures vulnerable to the weapon's slays */
 	for (i = 1; i < cave_monster_max(cave); i++) {
@@ -727,225 +727,593 @@ int weight_remaining(struct player *p)
 
 
 /**
- * Calculate the players current "state", taking into account
- * not only race/class intrinsics, but also objects being worn
- * and temporary spell effects.
- *
- * See also calc_mana() and calc_hitpoints().
- *
- * Take note of the new "speed code", in particular, a very strong
- * player will start slowing down as soon as he reaches 150 pounds,
- * but not until he reaches 450 pounds will he be half as fast as
- * a normal kobold.  This both hurts and helps the player, hurts
- * because in the old days a player could just avoid 300 pounds,
- * and helps because now carrying 300 pounds is not very painful.
- *
- * The "weapon" and "bow" do *not* add to the bonuses to hit or to
- * damage, since that would affect non-combat things.  These values
- * are actually added in later, at the appropriate place.
- *
- * If known_only is true, calc_bonuses() will only use the known
- * information of objects; thus it returns what the player _knows_
- * the character state to be.
+ * ------------------------------------------------------------------------
+ * Bonus layers
+ * ------------------------------------------------------------------------ */
+/**
+ * What one part of the player's circumstances adds to the player state.
+ * The equipment layer goes into the equipment modifiers, the others into
+ * the miscellaneous ones.
  */
-void calc_bonuses(struct player *p, struct player_state *state, bool known_only,
-				  bool update)
+struct bonus_layer {
+	int stat_mod[STAT_MAX];
+	int skill_mod[SKILL_MAX];
+	int speed;
+	int to_ds;			/* Damage sides for melee and archery */
+	int armour_weight;
+	int16_t flags[OF_MAX];
+	int16_t res_level[ELEM_MAX];
+};
+
+/**
+ * What the object in one equipment slot gives, and the object it was worked
+ * out for; it stays valid until equip_bonuses_changed() is told otherwise
+ */
+struct bonus_slot {
+	bool valid;
+	const struct object *obj;
+	struct bonus_layer layer;
+};
+
+struct bonus_base_key {
+	const struct player_race *race;
+	const struct player_house *house;
+};
+
+struct bonus_ability_key {
+	bitflag active[PA_SIZE];
+	int health;
+};
+
+struct bonus_timed_key {
+	const struct timed_grade *stun;
+	const struct timed_grade *food;
+	bool rage, str, dex, con, gra, fast, slow, sinvis;
+};
+
+struct bonus_song_key {
+	const struct song *song[SONG_MAX];
+	int pskill;
+	int wrath;
+};
+
+/**
+ * The layers last worked out for the player, each with the inputs it was
+ * worked out from; a layer is only recalculated when those change.  The
+ * equipment layer is the sum of a layer for each slot, and is kept twice,
+ * for the full and the known state.
+ */
+struct bonus_layers {
+	bool base_valid;
+	struct bonus_base_key base_key;
+	struct bonus_layer base;
+
+	bool ability_valid;
+	struct bonus_ability_key ability_key;
+	struct bonus_layer ability;
+
+	bool timed_valid;
+	struct bonus_timed_key timed_key;
+	struct bonus_layer timed;
+
+	bool song_valid;
+	struct bonus_song_key song_key;
+	struct bonus_layer song;
+
+	int equip_count[2];
+	struct bonus_layer equip[2];
+
+	/* z_info->equip_slots_max slots for the full state, then the known */
+	struct bonus_slot slots[];
+};
+
+static struct bonus_layers *bonus_layers_new(void)
 {
-	int i, j;
-	struct object *launcher = equipped_item_by_slot_name(p, "shooting");
-	struct object *weapon = equipped_item_by_slot_name(p, "weapon");
-	struct object *off = equipped_item_by_slot_name(p, "arm");
-	bitflag f[OF_SIZE];
-	int armour_weight = 0;
-	struct song *song;
+	return mem_zalloc(sizeof(struct bonus_layers)
+		+ 2 * z_info->equip_slots_max * sizeof(struct bonus_slot));
+}
 
-	/* Remove off-hand weapons if you cannot wield them */
-	if (!player_active_ability(p, "Two Weapon Fighting") &&
-		off && tval_is_weapon(off)) {
-		msg("You can no longer wield both weapons.");
-		inven_takeoff(off);
+/**
+ * Check a layer's inputs against the ones it was last worked out from,
+ * remembering the new ones if they differ
+ */
+static bool bonus_key_same(bool *valid, void *old_key, const void *key,
+		size_t size)
+{
+	if (*valid && !memcmp(old_key, key, size)) return true;
+	memcpy(old_key, key, size);
+	*valid = true;
+	return false;
+}
+
+static void add_bonus_layer(struct player_state *state,
+		const struct bonus_layer *layer, bool equip)
+{
+	int *stat_mod = equip ? state->stat_equip_mod : state->stat_misc_mod;
+	int *skill_mod = equip ? state->skill_equip_mod : state->skill_misc_mod;
+	int i;
+
+	for (i = 0; i < STAT_MAX; i++) {
+		stat_mod[i] += layer->stat_mod[i];
+	}
+	for (i = 0; i < SKILL_MAX; i++) {
+		skill_mod[i] += layer->skill_mod[i];
+	}
+	state->speed += layer->speed;
+	state->to_mds += layer->to_ds;
+	state->to_ads += layer->to_ds;
+	for (i = 0; i < OF_MAX; i++) {
+		state->flags[i] += layer->flags[i];
+	}
+	for (i = 0; i < ELEM_MAX; i++) {
+		state->el_info[i].res_level += layer->res_level[i];
 	}
+}
 
-	/* Reset */
-	memset(state, 0, sizeof *state);
+/**
+ * Race and house, and the defaults every character starts from
+ */
+static const struct bonus_layer *base_layer(struct player *p,
+		struct bonus_layers *layers, struct bonus_layer *layer)
+{
+	struct bonus_base_key key;
+	int i;
 
-	/* Set various defaults */
-	state->speed = 2;
-	state->el_info[ELEM_FIRE].res_level = 1;
-	state->el_info[ELEM_COLD].res_level = 1;
-	state->el_info[ELEM_POIS].res_level = 1;
+	if (layers) {
+		memset(&key, 0, sizeof(key));
+		key.race = p->race;
+		key.house = p->house;
+		if (bonus_key_same(&layers->base_valid, &layers->base_key, &key,
+				sizeof(key))) {
+			return &layers->base;
+		}
+		layer = &layers->base;
+	}
 
-	/* Extract race/house skill info */
+	memset(layer, 0, sizeof(*layer));
+	layer->speed = 2;
+	layer->res_level[ELEM_FIRE] = 1;
+	layer->res_level[ELEM_COLD] = 1;
+	layer->res_level[ELEM_POIS] = 1;
 	for (i = 0; i < SKILL_MAX; i++) {
-		state->skill_misc_mod[i] = p->race->skill_adj[i]
-			+ p->house->skill_adj[i];
+		layer->skill_mod[i] = p->race->skill_adj[i] + p->house->skill_adj[i];
 	}
+	return layer;
+}
 
-	/* Base pflags */
-	pf_copy(state->pflags, p->race->pflags);
+/**
+ * Add what an equipped object gives to a layer
+ */
+static void add_slot_bonuses(struct bonus_layer *layer,
+		const struct object *obj, bool known_only)
+{
+	bitflag f[OF_SIZE];
+	int i;
 
-	/* Analyze equipment */
-	for (i = 0; i < p->body.count; i++) {
-		struct object *obj = slot_object(p, i);
+	if (!obj) return;
 
-		if (obj) {
-			/* Extract the item flags */
-			if (known_only) {
-				object_flags_known(obj, f);
-			} else {
-				object_flags(obj, f);
-			}
+	/* Apply the item flags */
+	if (known_only) {
+		object_flags_known(obj, f);
+	} else {
+		object_flags(obj, f);
+	}
+	for (i = 0; i < OF_MAX; i++) {
+		if (of_has(f, i)) {
+			layer->flags[i]++;
+		}
+	}
 
-			/* Apply the item flags */
-			for (j = 0; j < OF_MAX; j++) {
-				if (of_has(f, j)) {
-					state->flags[j]++;
-				}
-			}			
+	/* Apply modifiers */
+	for (i = 0; i < STAT_MAX; i++) {
+		layer->stat_mod[i] += obj->modifiers[i];
+	}
+	for (i = 0; i < SKILL_MAX; i++) {
+		layer->skill_mod[i] += obj->modifiers[STAT_MAX + i];
+	}
+	layer->skill_mod[SKILL_EVASION] += obj->evn;
+	layer->to_ds += obj->modifiers[OBJ_MOD_DAMAGE_SIDES];
+
+	/* Apply element info, noting that it is known if need be */
+	for (i = 0; i < ELEM_MAX; i++) {
+		if (!known_only || obj->known->el_info[i].res_level) {
+			layer->res_level[i] += obj->el_info[i].res_level;
+		}
+	}
+
+	/* Add up the armour weight */
+	if (tval_is_armor(obj)) {
+		layer->armour_weight += obj->weight;
+	}
+
+	/* Do not apply weapon to-hit bonuses yet */
+	if (tval_is_weapon(obj)) return;
+
+	/* Apply the bonus to hit */
+	layer->skill_mod[SKILL_MELEE] += obj->att;
+	layer->skill_mod[SKILL_ARCHERY] += obj->att;
+}
+
+/**
+ * Everything the player is wearing or wielding
+ *
+ * Only the slots which have had their object swapped, or been marked by
+ * equip_bonuses_changed(), are worked out again.
+ */
+static const struct bonus_layer *equip_layer(struct player *p,
+		bool known_only, struct bonus_layers *layers,
+		struct bonus_layer *layer)
+{
+	int i, j;
+
+	if (layers && p->body.count <= z_info->equip_slots_max) {
+		struct bonus_slot *slots = layers->slots
+			+ (known_only ? z_info->equip_slots_max : 0);
+		bool changed = layers->equip_count[known_only] != p->body.count;
+
+		for (i = 0; i < p->body.count; i++) {
+			struct object *obj = slot_object(p, i);
+
+			if (slots[i].valid && slots[i].obj == obj) continue;
+			memset(&slots[i].layer, 0, sizeof(slots[i].layer));
+			add_slot_bonuses(&slots[i].layer, obj, known_only);
+			slots[i].obj = obj;
+			slots[i].valid = true;
+			changed = true;
+		}
+		layer = &layers->equip[known_only];
+		if (!changed) return layer;
+		layers->equip_count[known_only] = p->body.count;
+
+		/* Add the slots up again */
+		memset(layer, 0, sizeof(*layer));
+		for (i = 0; i < p->body.count; i++) {
+			const struct bonus_layer *slot = &slots[i].layer;
 
-			/* Apply modifiers */
 			for (j = 0; j < STAT_MAX; j++) {
-				state->stat_equip_mod[j] +=	obj->modifiers[j];
+				layer->stat_mod[j] += slot->stat_mod[j];
 			}
 			for (j = 0; j < SKILL_MAX; j++) {
-				state->skill_equip_mod[j] += obj->modifiers[STAT_MAX + j];
-				if (j == SKILL_EVASION) {
-					state->skill_equip_mod[j] += obj->evn;
-				}
+				layer->skill_mod[j] += slot->skill_mod[j];
 			}
-			if (obj->modifiers[OBJ_MOD_DAMAGE_SIDES]) {
-				state->to_mds += obj->modifiers[OBJ_MOD_DAMAGE_SIDES];
-				state->to_ads += obj->modifiers[OBJ_MOD_DAMAGE_SIDES];
+			layer->speed += slot->speed;
+			layer->to_ds += slot->to_ds;
+			layer->armour_weight += slot->armour_weight;
+			for (j = 0; j < OF_MAX; j++) {
+				layer->flags[j] += slot->flags[j];
 			}
-
-			/* Apply element info */
 			for (j = 0; j < ELEM_MAX; j++) {
-				if (!known_only || obj->known->el_info[j].res_level) {
-					state->el_info[j].res_level += obj->el_info[j].res_level;
-				}
+				layer->res_level[j] += slot->res_level[j];
 			}
-
-			/* Add up the armour weight */
-			if (tval_is_armor(obj)) {
-				armour_weight += obj->weight;
-			}
-
-			/* Do not apply weapon to-hit bonuses yet */
-			if (tval_is_weapon(obj)) continue;
-
-			/* Apply the bonus to hit */
-			state->skill_equip_mod[SKILL_MELEE] += obj->att;
-			state->skill_equip_mod[SKILL_ARCHERY] += obj->att;		
 		}
+		return layer;
 	}
 
-	/* Parrying grants extra bonus for weapon evasion */
-	if (weapon && player_active_ability(p, "Parry")) {
-		state->skill_equip_mod[SKILL_EVASION] += weapon->evn;
+	memset(layer, 0, sizeof(*layer));
+	for (i = 0; i < p->body.count; i++) {
+		add_slot_bonuses(layer, slot_object(p, i), known_only);
 	}
+	return layer;
+}
 
-	/* Deal with vulnerabilities and dark resistance */
-	for (i = 0; i < ELEM_MAX; i++) {
-		/* Represent overall vulnerabilities as negatives of the normal range */
-		if (state->el_info[i].res_level < 1) {
-			state->el_info[i].res_level -= 2;
+/**
+ * Note that what an equipped object gives has changed, either in the object
+ * itself or in what the player knows of it, so that the next update works
+ * out its slot again; with no object, all slots are worked out again.
+ * Objects which aren't equipped are ignored.
+ */
+void equip_bonuses_changed(struct player *p, struct object *obj)
+{
+	struct bonus_layers *layers = p->upkeep->bonus_layers;
+	int i;
+
+	if (obj && !object_is_equipped(p->body, obj)) return;
+	p->upkeep->update |= (PU_BONUS);
+	if (!layers) return;
+	for (i = 0; i < z_info->equip_slots_max; i++) {
+		if (!obj || (i < p->body.count && slot_object(p, i) == obj)) {
+			layers->slots[i].valid = false;
+			layers->slots[z_info->equip_slots_max + i].valid = false;
 		}
+	}
+}
 
-		/* Dark resistance depends only on the brightness of the player grid */
-		if ((i == ELEM_DARK) && character_dungeon) {
-			state->el_info[i].res_level = square_light(cave, p->grid);
+/**
+ * Active abilities that don't depend on what is wielded
+ */
+static const struct bonus_layer *ability_layer(struct player *p,
+		struct bonus_layers *layers, struct bonus_layer *layer)
+{
+	struct bonus_ability_key key;
+
+	if (layers) {
+		memset(&key, 0, sizeof(key));
+		pa_copy(key.active, p->active_abilities);
+		key.health = health_level(p->chp, p->mhp);
+		if (bonus_key_same(&layers->ability_valid, &layers->ability_key,
+				&key, sizeof(key))) {
+			return &layers->ability;
 		}
+		layer = &layers->ability;
 	}
 
+	memset(layer, 0, sizeof(*layer));
+
 	/* Ability stat boosts */
-	state->stat_misc_mod[STAT_STR] += player_active_ability(p, "Strength");
-	state->stat_misc_mod[STAT_DEX] += player_active_ability(p, "Dexterity");
-	state->stat_misc_mod[STAT_CON] += player_active_ability(p, "Constitution");
-	state->stat_misc_mod[STAT_GRA] += player_active_ability(p, "Grace");
+	layer->stat_mod[STAT_STR] += player_active_ability_count(p, PA_STRENGTH);
+	layer->stat_mod[STAT_DEX] += player_active_ability_count(p, PA_DEXTERITY);
+	layer->stat_mod[STAT_CON] +=
+		player_active_ability_count(p, PA_CONSTITUTION);
+	layer->stat_mod[STAT_GRA] += player_active_ability_count(p, PA_GRACE);
 
-	if (player_active_ability(p, "Strength in Adversity")) {
+	if (player_active_ability(p, PA_STRENGTH_IN_ADVERSITY)) {
 		/* If <= 50% health, give a bonus to strength and grace */
 		if (health_level(p->chp, p->mhp) <= HEALTH_BADLY_WOUNDED) {
-			state->stat_misc_mod[STAT_STR]++;
-			state->stat_misc_mod[STAT_GRA]++;
+			layer->stat_mod[STAT_STR]++;
+			layer->stat_mod[STAT_GRA]++;
 		}
 
 		/* If <= 25% health, give an extra bonus */
 		if (health_level(p->chp, p->mhp) <= HEALTH_ALMOST_DEAD) {
-			state->stat_misc_mod[STAT_STR]++;
-			state->stat_misc_mod[STAT_GRA]++;
+			layer->stat_mod[STAT_STR]++;
+			layer->stat_mod[STAT_GRA]++;
 		}
 	}
 
 	/* Ability skill modifications */
-	if (player_active_ability(p, "Rapid Attack")) {
-		state->skill_misc_mod[SKILL_MELEE] -= 3;
+	if (player_active_ability(p, PA_RAPID_ATTACK)) {
+		layer->skill_mod[SKILL_MELEE] -= 3;
 	}
-	if (player_active_ability(p, "Rapid Fire")) {
-		state->skill_misc_mod[SKILL_ARCHERY] -= 3;
+	if (player_active_ability(p, PA_RAPID_FIRE)) {
+		layer->skill_mod[SKILL_ARCHERY] -= 3;
 	}
-	if (player_active_ability(p, "Poison Resistance")) {
-		state->el_info[ELEM_POIS].res_level += 1;
+	if (player_active_ability(p, PA_POISON_RESISTANCE)) {
+		layer->res_level[ELEM_POIS] += 1;
 	}
 
-	/* Timed effects */
+	/* Decrease food consumption with 'mind over body' ability */
+	if (player_active_ability(p, PA_MIND_OVER_BODY)) {
+		layer->flags[OF_HUNGER] -= 1;
+	}
+
+	/* Protect from confusion, stunning, hallucinaton with 'clarity' ability */
+	if (player_active_ability(p, PA_CLARITY)) {
+		layer->flags[OF_PROT_CONF] += 1;
+		layer->flags[OF_PROT_STUN] += 1;
+		layer->flags[OF_PROT_HALLU] += 1;
+	}
+	return layer;
+}
+
+/**
+ * The grade a timed effect is currently at, or NULL if it is off
+ */
+static const struct timed_grade *current_grade(const struct player *p,
+		int idx)
+{
+	const struct timed_grade *grade = timed_effects[idx].grade;
+
+	if (!p->timed[idx]) return NULL;
+	while (p->timed[idx] > grade->max) {
+		grade = grade->next;
+	}
+	return grade;
+}
+
+/**
+ * Timed effects
+ */
+static const struct bonus_layer *timed_layer(struct player *p,
+		struct bonus_layers *layers, struct bonus_layer *layer)
+{
+	struct bonus_timed_key key;
+	int i;
+
+	if (layers) {
+		memset(&key, 0, sizeof(key));
+		key.stun = current_grade(p, TMD_STUN);
+		key.food = current_grade(p, TMD_FOOD);
+		key.rage = p->timed[TMD_RAGE] != 0;
+		key.str = p->timed[TMD_STR] != 0;
+		key.dex = p->timed[TMD_DEX] != 0;
+		key.con = p->timed[TMD_CON] != 0;
+		key.gra = p->timed[TMD_GRA] != 0;
+		key.fast = p->timed[TMD_FAST] != 0;
+		key.slow = p->timed[TMD_SLOW] != 0;
+		key.sinvis = p->timed[TMD_SINVIS] != 0;
+		if (bonus_key_same(&layers->timed_valid, &layers->timed_key, &key,
+				sizeof(key))) {
+			return &layers->timed;
+		}
+		layer = &layers->timed;
+	}
+
+	memset(layer, 0, sizeof(*layer));
 	if (player_timed_grade_eq(p, TMD_STUN, "Heavy Stun")) {
 		for (i = 0; i < SKILL_MAX; i++) {
-			state->skill_misc_mod[i] -= 4;
+			layer->skill_mod[i] -= 4;
 		}
 	} else if (player_timed_grade_eq(p, TMD_STUN, "Stun")) {
 		for (i = 0; i < SKILL_MAX; i++) {
-			state->skill_misc_mod[i] -= 2;
+			layer->skill_mod[i] -= 2;
 		}
 	}
 	if (player_timed_grade_eq(p, TMD_FOOD, "Weak")) {
-		state->stat_misc_mod[STAT_STR] -= 1;
+		layer->stat_mod[STAT_STR] -= 1;
 	}
 	if (p->timed[TMD_RAGE]) {
-		state->stat_misc_mod[STAT_STR] += 1;
-		state->stat_misc_mod[STAT_DEX] -= 1;
-		state->stat_misc_mod[STAT_CON] += 1;
-		state->stat_misc_mod[STAT_GRA] -= 1;
+		layer->stat_mod[STAT_STR] += 1;
+		layer->stat_mod[STAT_DEX] -= 1;
+		layer->stat_mod[STAT_CON] += 1;
+		layer->stat_mod[STAT_GRA] -= 1;
 	}
 	if (p->timed[TMD_STR]) {
-		state->stat_misc_mod[STAT_STR] += 3;
-		state->flags[OF_SUST_STR] += 1;
+		layer->stat_mod[STAT_STR] += 3;
+		layer->flags[OF_SUST_STR] += 1;
 	}
 	if (p->timed[TMD_DEX]) {
-		state->stat_misc_mod[STAT_DEX] += 3;
-		state->flags[OF_SUST_DEX] += 1;
+		layer->stat_mod[STAT_DEX] += 3;
+		layer->flags[OF_SUST_DEX] += 1;
 	}
 	if (p->timed[TMD_CON]) {
-		state->stat_misc_mod[STAT_CON] += 3;
-		state->flags[OF_SUST_CON] += 1;
+		layer->stat_mod[STAT_CON] += 3;
+		layer->flags[OF_SUST_CON] += 1;
 	}
 	if (p->timed[TMD_GRA]) {
-		state->stat_misc_mod[STAT_GRA] += 3;
-		state->flags[OF_SUST_GRA] += 1;
+		layer->stat_mod[STAT_GRA] += 3;
+		layer->flags[OF_SUST_GRA] += 1;
 	}
 	if (p->timed[TMD_FAST]) {
-		state->speed += 1;
+		layer->speed += 1;
 	}
 	if (p->timed[TMD_SLOW]) {
-		state->speed -= 1;
+		layer->speed -= 1;
 	}
 	if (p->timed[TMD_SINVIS]) {
-		state->flags[OF_SEE_INVIS] += 1;
-		state->flags[OF_PROT_BLIND] += 1;
-		state->flags[OF_PROT_HALLU] += 1;
+		layer->flags[OF_SEE_INVIS] += 1;
+		layer->flags[OF_PROT_BLIND] += 1;
+		layer->flags[OF_PROT_HALLU] += 1;
 	}
+	return layer;
+}
 
-	/* Decrease food consumption with 'mind over body' ability */
-	if (player_active_ability(p, "Mind Over Body")) {
-		state->flags[OF_HUNGER] -= 1;
+/**
+ * Songs being sung, given the player's song skill
+ */
+static const struct bonus_layer *song_layer(struct player *p, int pskill,
+		struct bonus_layers *layers, struct bonus_layer *layer)
+{
+	struct bonus_song_key key;
+	struct song *song;
+
+	if (layers) {
+		memset(&key, 0, sizeof(key));
+		memcpy(key.song, p->song, sizeof(key.song));
+		key.pskill = pskill;
+		key.wrath = p->wrath;
+		if (bonus_key_same(&layers->song_valid, &layers->song_key, &key,
+				sizeof(key))) {
+			return &layers->song;
+		}
+		layer = &layers->song;
 	}
 
-	/* Protect from confusion, stunning, hallucinaton with 'clarity' ability */
-	if (player_active_ability(p, "Clarity")) {
-		state->flags[OF_PROT_CONF] += 1;
-		state->flags[OF_PROT_STUN] += 1;
-		state->flags[OF_PROT_HALLU] += 1;
+	memset(layer, 0, sizeof(*layer));
+
+	/* Penalise stealth based on song(s) being sung */
+	layer->skill_mod[SKILL_STEALTH] -= player_song_noise(p);
+
+	/* Apply song effects that modify skills */
+	song = lookup_song("Slaying");
+	if (player_is_singing(p, song)) {
+		layer->skill_mod[SKILL_MELEE] += song_bonus(p, pskill, song);
+		layer->skill_mod[SKILL_ARCHERY] += song_bonus(p, pskill, song);
 	}
+	song = lookup_song("Aule");
+	if (player_is_singing(p, song)) {
+		layer->skill_mod[SKILL_SMITHING] += song_bonus(p, pskill, song);
+	}
+	song = lookup_song("Staying");
+	if (player_is_singing(p, song)) {
+		layer->skill_mod[SKILL_WILL] += song_bonus(p, pskill, song);
+	}
+	song = lookup_song("Freedom");
+	if (player_is_singing(p, song)) {
+		layer->flags[OF_FREE_ACT] += 1;
+	}
+	return layer;
+}
+
+
+/**
+ * Calculate the players current "state", taking into account
+ * not only race/class intrinsics, but also objects being worn
+ * and temporary spell effects.
+ *
+ * See also calc_mana() and calc_hitpoints().
+ *
+ * Take note of the new "speed code", in particular, a very strong
+ * player will start slowing down as soon as he reaches 150 pounds,
+ * but not until he reaches 450 pounds will he be half as fast as
+ * a normal kobold.  This both hurts and helps the player, hurts
+ * because in the old days a player could just avoid 300 pounds,
+ * and helps because now carrying 300 pounds is not very painful.
+ *
+ * The "weapon" and "bow" do *not* add to the bonuses to hit or to
+ * damage, since that would affect non-combat things.  These values
+ * are actually added in later, at the appropriate place.
+ *
+ * If known_only is true, calc_bonuses() will only use the known
+ * information of objects; thus it returns what the player _knows_
+ * the character state to be.
+ *
+ * Given a set of bonus layers, only the layers whose inputs have changed
+ * since they were last used are worked out again.
+ */
+static void calc_bonuses_aux(struct player *p, struct player_state *state,
+		bool known_only, bool update, struct bonus_layers *layers)
+{
+	int i, j;
+	struct bonus_layer scratch;
+	const struct bonus_layer *layer;
+	struct object *launcher = equipped_item_by_slot_name(p, "shooting");
+	struct object *weapon = equipped_item_by_slot_name(p, "weapon");
+	struct object *off = equipped_item_by_slot_name(p, "arm");
+	int armour_weight;
+
+	PROFILE_START(calc_bonuses);
+
+	/* Rebuild the active abilities if they or the gear have changed */
+	if (update && (p->upkeep->update & (PU_ABILITIES))) {
+		p->upkeep->update &= ~(PU_ABILITIES);
+		player_update_active_abilities(p);
+		if (p->upkeep->bonus_layers) {
+			p->upkeep->bonus_layers->ability_valid = false;
+		}
+	}
+
+	/* Remove off-hand weapons if you cannot wield them */
+	if (!player_active_ability(p, PA_TWO_WEAPON_FIGHTING) &&
+		off && tval_is_weapon(off)) {
+		msg("You can no longer wield both weapons.");
+		inven_takeoff(off);
+	}
+
+	/* Reset */
+	memset(state, 0, sizeof *state);
+
+	/* Base pflags */
+	pf_copy(state->pflags, p->race->pflags);
+
+	/* Race/house skills and defaults */
+	add_bonus_layer(state, base_layer(p, layers, &scratch), false);
+
+	/* Analyze equipment */
+	layer = equip_layer(p, known_only, layers, &scratch);
+	add_bonus_layer(state, layer, true);
+	armour_weight = layer->armour_weight;
+
+	/* Parrying grants extra bonus for weapon evasion */
+	if (weapon && player_active_ability(p, PA_PARRY)) {
+		state->skill_equip_mod[SKILL_EVASION] += weapon->evn;
+	}
+
+	/* Deal with vulnerabilities and dark resistance */
+	for (i = 0; i < ELEM_MAX; i++) {
+		/* Represent overall vulnerabilities as negatives of the normal range */
+		if (state->el_info[i].res_level < 1) {
+			state->el_info[i].res_level -= 2;
+		}
+
+		/* Dark resistance depends only on the brightness of the player grid */
+		if ((i == ELEM_DARK) && character_dungeon) {
+			state->el_info[i].res_level = square_light(cave, p->grid);
+		}
+	}
+
+	/* Abilities and timed effects */
+	add_bonus_layer(state, ability_layer(p, layers, &scratch), false);
+	add_bonus_layer(state, timed_layer(p, layers, &scratch), false);
 
 	/* Calculate stats */
 	for (i = 0; i < STAT_MAX; i++) {
@@ -990,9 +1358,6 @@ void calc_bonuses(struct player *p, struct player_state *state, bool known_only,
 	 * by 1 point per 10 pounds (rounding down) */
 	state->skill_equip_mod[SKILL_STEALTH] -= armour_weight / 100;
 
-	/* Penalise stealth based on song(s) being sung */
-	state->skill_misc_mod[SKILL_STEALTH] -= player_song_noise(p);
-
 	/*** Modify skills by ability scores ***/
 	state->skill_stat_mod[SKILL_MELEE] = state->stat_use[STAT_DEX];
 	state->skill_stat_mod[SKILL_ARCHERY] = state->stat_use[STAT_DEX];
@@ -1009,27 +1374,9 @@ void calc_bonuses(struct player *p, struct player_state *state, bool known_only,
 		+ state->skill_stat_mod[SKILL_SONG]
 		+ state->skill_misc_mod[SKILL_SONG];
 
-	/* Apply song effects that modify skills */
-	song = lookup_song("Slaying");
-	if (player_is_singing(p, song)) {
-		int pskill = state->skill_use[SKILL_SONG];
-		state->skill_misc_mod[SKILL_MELEE] += song_bonus(p, pskill, song);
-		state->skill_misc_mod[SKILL_ARCHERY] += song_bonus(p, pskill, song);
-	}
-	song = lookup_song("Aule");
-	if (player_is_singing(p, song)) {
-		int pskill = state->skill_use[SKILL_SONG];
-		state->skill_misc_mod[SKILL_SMITHING] += song_bonus(p, pskill, song);
-	}
-	song = lookup_song("Staying");
-	if (player_is_singing(p, song)) {
-		int pskill = state->skill_use[SKILL_SONG];
-		state->skill_misc_mod[SKILL_WILL] += song_bonus(p, pskill, song);
-	}
-	song = lookup_song("Freedom");
-	if (player_is_singing(p, song)) {
-		state->flags[OF_FREE_ACT] += 1;
-	}
+	/* Apply song effects, including the stealth penalty */
+	add_bonus_layer(state,
+		song_layer(p, state->skill_use[SKILL_SONG], layers, &scratch), false);
 
 	/* Analyze launcher */
 	if (launcher) {
@@ -1050,7 +1397,7 @@ void calc_bonuses(struct player *p, struct player_state *state, bool known_only,
 	}
 
 	/* Deal with the 'Versatility' ability */
-	if (player_active_ability(p, "Versatility") &&
+	if (player_active_ability(p, PA_VERSATILITY) &&
 		(p->skill_base[SKILL_ARCHERY] > p->skill_base[SKILL_MELEE])) {
 		state->skill_misc_mod[SKILL_MELEE] +=
 			(p->skill_base[SKILL_ARCHERY] - p->skill_base[SKILL_MELEE]) / 2;
@@ -1059,10 +1406,10 @@ void calc_bonuses(struct player *p, struct player_state *state, bool known_only,
 	/* Generate melee dice/sides from weapon, to_mdd, to_mds, strength */
 	state->mdd = total_mdd(p, weapon);
 	state->mds = total_mds(p, state, weapon,
-						   player_active_ability(p, "Rapid Attack") ? -3 : 0);
+						   player_active_ability(p, PA_RAPID_ATTACK) ? -3 : 0);
 
 	/* Determine the off-hand melee score, damage and sides */
-	if (player_active_ability(p, "Two Weapon Fighting") && 
+	if (player_active_ability(p, PA_TWO_WEAPON_FIGHTING) && 
 		off && tval_is_weapon(off)) {
 		/* Remove main-hand specific bonuses */
 		if (weapon) {
@@ -1071,7 +1418,7 @@ void calc_bonuses(struct player *p, struct player_state *state, bool known_only,
 				+ axe_bonus(p, weapon)
 				+ polearm_bonus(p, weapon);
 		}
-		if (player_active_ability(p, "Rapid Attack")) {
+		if (player_active_ability(p, PA_RAPID_ATTACK)) {
 			state->offhand_mel_mod += 3;
 		}
 
@@ -1102,7 +1449,16 @@ void calc_bonuses(struct player *p, struct player_state *state, bool known_only,
 	state->p_min = protection_roll(p, PROJ_HURT, true, MINIMISE);
 	state->p_max = protection_roll(p, PROJ_HURT, true, MINIMISE);
 
-	return;
+	PROFILE_STOP(calc_bonuses);
+}
+
+/**
+ * Calculate the player state from scratch
+ */
+void calc_bonuses(struct player *p, struct player_state *state, bool known_only,
+				  bool update)
+{
+	calc_bonuses_aux(p, state, known_only, update, NULL);
 }
 
 /**
@@ -1120,8 +1476,11 @@ static void update_bonuses(struct player *p)
 	 * Calculate bonuses
 	 * ------------------------------------ */
 
-	calc_bonuses(p, &state, false, true);
-	calc_bonuses(p, &known_state, true, true);
+	if (!p->upkeep->bonus_layers) {
+		p->upkeep->bonus_layers = bonus_layers_new();
+	}
+	calc_bonuses_aux(p, &state, false, true, p->upkeep->bonus_layers);
+	calc_bonuses_aux(p, &known_state, true, true, p->upkeep->bonus_layers);
 
 
 	/* ------------------------------------
@@ -1430,7 +1789,8 @@ void redraw_stuff(struct player *p)
 
 	/* Then the ones that require parameters to be supplied. */
 	if (redraw & PR_MAP) {
-		/* Mark the whole map to be redrawn */
+		/* Mark the whole map to be redrawn, which covers any single grids */
+		event_discard_map();
 		event_signal_point(EVENT_MAP, -1, -1);
 	}
 
@@ -1443,6 +1803,7 @@ void redraw_stuff(struct player *p)
 	 * Do any plotting, etc. delayed from earlier - this set of updates
 	 * is over.
 	 */
+	event_flush_map();
 	event_signal(EVENT_END);
 }
 
@@ -1452,7 +1813,10 @@ void redraw_stuff(struct player *p)
  */
 void handle_stuff(struct player *p)
 {
+	PROFILE_START(handle_stuff);
 	if (p->upkeep->update) update_stuff(p);
 	if (p->upkeep->redraw) redraw_stuff(p);
+	event_flush_map();
+	PROFILE_STOP(handle_stuff);
 }
 
@@ -43,6 +43,7 @@
 #define PU_DISTANCE		0x00000080L	/* Update distances */
 #define PU_PANEL		0x00000100L	/* Update panel */
 #define PU_INVEN		0x00000200L	/* Update inventory */
+#define PU_ABILITIES	0x00000400L	/* Rebuild the set of active abilities */
 
 
 /**
@@ -114,6 +115,7 @@ int weight_limit(struct player_state state);
 int weight_remaining(struct player *p);
 void calc_bonuses(struct player *p, struct player_state *state, bool known_only,
 				  bool update);
+void equip_bonuses_changed(struct player *p, struct object *obj);
 
 void health_track(struct player_upkeep *upkeep, struct monster *mon);
 void monster_race_track(struct player_upkeep *upkeep, 
@@ -171,8 +171,7 @@ void break_truce(struct player *p, bool obvious)
 				msg("%s lets out a cry! The tension is broken.", m_name);
 
 				/* Make a lot of noise */
-				cave->monster_noise.centre = mon->grid;
-				update_flow(cave, &cave->monster_noise, NULL);
+				update_noise_flow(cave, mon->grid);
 				monsters_hear(false, false, -10);
 			} else {
 				msg("The tension is broken.");
@@ -286,7 +285,7 @@ void prise_silmaril(struct player *p)
 	weapon = equipped_item_by_slot_name(p, "weapon");
 
 	/* Undo rapid attack penalties */
-	if (player_active_ability(p, "Rapid Attack")) {
+	if (player_active_ability(p, PA_RAPID_ATTACK)) {
 		/* Undo strength adjustment to the attack */
 		mds = total_mds(p, &p->state, weapon, 0);
 		
@@ -559,14 +559,14 @@ void player_flanking_or_retreat(struct player *p, struct loc grid)
 {
 	int d, start;
 	struct monster *mon = target_get_monster();
-	bool flanking = player_active_ability(p, "Flanking");
+	bool flanking = player_active_ability(p, PA_FLANKING);
 	bool controlled_retreat = false;
 
 	/* No attack if player is confused or afraid, or if the truce is in force */
 	if (p->timed[TMD_CONFUSED] || p->timed[TMD_AFRAID] || p->truce) return;
 	
 	/* Need to have the ability, and to have not moved last round */
-	if (player_active_ability(p, "Controlled Retreat") && 
+	if (player_active_ability(p, PA_CONTROLLED_RETREAT) && 
 	    ((p->previous_action[1] > 9) || (p->previous_action[1] == 5))) {
 		controlled_retreat = true;
 	}
@@ -637,8 +637,8 @@ void player_flanking_or_retreat(struct player *p, struct loc grid)
 void player_opportunist_or_zone(struct player *p, struct loc grid1,
 								struct loc grid2, bool opp_only)
 {
-	bool opp = player_active_ability(p, "Opportunist");
-	bool zone = player_active_ability(p, "Zone of Control") && !opp_only;
+	bool opp = player_active_ability(p, PA_OPPORTUNIST);
+	bool zone = player_active_ability(p, PA_ZONE_OF_CONTROL) && !opp_only;
 
 	/* Monster */
 	char m_name[80];
@@ -710,7 +710,7 @@ bool player_can_leap(struct player *p, struct loc grid, int dir)
 
 	if (p->timed[TMD_CONFUSED]) return false;
 	if (!square_isleapable(cave, grid)) return false;
-	if (!player_active_ability(p, "Leaping")) return false;
+	if (!player_active_ability(p, PA_LEAPING)) return false;
 
 	/* Test all three directions roughly towards the chasm/pit */
 	for (i = -1; i <= 1; i++) {
@@ -822,7 +822,7 @@ bool player_escape_pit(struct player *p)
 void player_blast_ceiling(struct player *p)
 {
 	int will = p->state.skill_use[SKILL_WILL];
-	if (player_active_ability(p, "Channeling")) {
+	if (player_active_ability(p, PA_CHANNELING)) {
 		will += 5;
 	}
 
@@ -855,7 +855,7 @@ void player_blast_ceiling(struct player *p)
 void player_blast_floor(struct player *p)
 {
 	int will = p->state.skill_use[SKILL_WILL];
-	if (player_active_ability(p, "Channeling")) {
+	if (player_active_ability(p, PA_CHANNELING)) {
 		will += 5;
 	}
 
@@ -919,7 +919,7 @@ bool player_action_is_movement(struct player *p, int n)
  */
 int player_dodging_bonus(struct player *p)
 {
-	if (player_active_ability(p, "Dodging") && player_action_is_movement(p, 0)){
+	if (player_active_ability(p, PA_DODGING) && player_action_is_movement(p, 0)){
 		return 3;
 	} else {
 		return 0;
@@ -934,7 +934,7 @@ bool player_can_riposte(struct player *p, int hit_result)
 {
 	struct object *weapon = equipped_item_by_slot_name(p, "weapon");
 
-	return (weapon && player_active_ability(p, "Riposte") &&
+	return (weapon && player_active_ability(p, PA_RIPOSTE) &&
 			!p->upkeep->riposte &&
 			!p->timed[TMD_AFRAID] &&
 			!p->timed[TMD_CONFUSED] &&
@@ -951,7 +951,7 @@ bool player_is_sprinting(struct player *p)
 	int i;
 	int turns = 1;
 
-	if (player_active_ability(p, "Sprinting")) {
+	if (player_active_ability(p, PA_SPRINTING)) {
 		for (i = 1; i < 4; i++) {
 			if (player_action_is_movement(p, i) &&
 				player_action_is_movement(p, i + 1)) {
@@ -1608,7 +1608,7 @@ static void search_square(struct player *p, struct loc grid, int dist,
 		if (searching) score += 5;
 
 		/* Eye for Detail ability */
-		if (player_active_ability(p, "Eye for Detail")) score += 5;
+		if (player_active_ability(p, PA_EYE_FOR_DETAIL)) score += 5;
 
 		/* Determine the base difficulty */
 		if (obj) {
@@ -359,6 +359,7 @@ void player_cleanup_members(struct player *p)
 	mem_free(p->timed);
 	if (p->upkeep) {
 		mem_free(p->upkeep->inven);
+		mem_free(p->upkeep->bonus_layers);
 		mem_free(p->upkeep);
 		p->upkeep = NULL;
 	}
@@ -148,6 +148,24 @@ enum {
 	SKILL_MAX
 };
 
+/**
+ * Ability indices; abilities of the same name in different skills share one
+ */
+enum {
+	#define PA(a, b) PA_##a,
+	#include "list-player-abilities.h"
+	#undef PA
+
+	PA_MAX
+};
+
+#define PA_SIZE                FLAG_SIZE(PA_MAX)
+
+#define pa_has(f, flag)        flag_has_dbg(f, PA_SIZE, flag, #f, #flag)
+#define pa_on(f, flag)         flag_on_dbg(f, PA_SIZE, flag, #f, #flag)
+#define pa_wipe(f)             flag_wipe(f, PA_SIZE)
+#define pa_copy(f1, f2)        flag_copy(f1, f2, PA_SIZE)
+
 /**
  * Structure for the "quests"
  */
@@ -170,6 +188,7 @@ struct song {
 	char *msg;
 	struct alt_song_desc *alt_desc;
 	int index;
+	int ability;		/* Ability needed to sing it, or -1 if none */
 	int bonus_mult;
 	int bonus_div;
 	int bonus_min;
@@ -443,6 +462,8 @@ struct player_upkeep {
 	int inven_cnt;			/* Number of items in inventory */
 	int equip_cnt;			/* Number of items in equipment */
 	int recharge_pow;		/* Power of recharge effect */
+
+	struct bonus_layers *bonus_layers;	/* Cached parts of calc_bonuses() */
 };
 
 /**
@@ -496,6 +517,7 @@ struct player {
 
 	struct ability *abilities;		/* Player innate abilities */
 	struct ability *item_abilities;	/* Player item abilities */
+	bitflag active_abilities[PA_SIZE];	/* Active innate or item abilities */
 
 	int16_t last_attack_m_idx;	/* Index of the monster attacked last round */
 	int16_t consecutive_attacks;/* Rounds spent attacking this monster */
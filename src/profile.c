@@ -0,0 +1,144 @@
+/**
+ * \file profile.c
+ * \brief Call counters and timers for hot code paths
+ *
+ * Copyright (c) 2026 Angband contributors
+ *
+ * This work is free software; you can redistribute it and/or modify it
+ * under the terms of either:
+ *
+ * a) the GNU General Public License as published by the Free Software
+ *    Foundation, version 2, or
+ *
+ * b) the "Angband licence":
+ *    This software may be copied and distributed for educational, research,
+ *    and not for profit purposes provided that this copyright and statement
+ *    are included in all such copies.  Other copyrights may also apply.
+ */
+
+#include "profile.h"
+#include "z-file.h"
+#ifdef WINDOWS
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+struct profile_counter profile_counters[PROF_MAX];
+
+static const struct {
+	const char *name;
+	const char *desc;
+} profile_region_info[] = {
+	#define PROF(a, b) { #a, b },
+	#include "list-profile-regions.h"
+	#undef PROF
+};
+
+/**
+ * Whether the PROFILE_START()/PROFILE_STOP() markers were compiled in
+ */
+bool profile_is_enabled(void)
+{
+#ifdef USE_PROFILE
+	return true;
+#else
+	return false;
+#endif
+}
+
+/**
+ * Read a monotonic clock, in nanoseconds from an arbitrary origin
+ */
+uint64_t profile_now(void)
+{
+#if defined(WINDOWS)
+	static LARGE_INTEGER freq;
+	LARGE_INTEGER now;
+
+	if (!freq.QuadPart) QueryPerformanceFrequency(&freq);
+	QueryPerformanceCounter(&now);
+	return (uint64_t)((double)now.QuadPart * 1.0e9 / (double)freq.QuadPart);
+#elif defined(CLOCK_MONOTONIC)
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	return (uint64_t)ts.tv_sec * 1000000000 + ts.tv_nsec;
+#else
+	return (uint64_t)clock() * (1000000000 / CLOCKS_PER_SEC);
+#endif
+}
+
+/**
+ * Enter region 'r'
+ */
+void profile_start(enum profile_region r)
+{
+	struct profile_counter *counter = &profile_counters[r];
+
+	counter->calls++;
+	if (counter->depth++ == 0) {
+		counter->start = profile_now();
+	}
+}
+
+/**
+ * Leave region 'r'
+ */
+void profile_stop(enum profile_region r)
+{
+	struct profile_counter *counter = &profile_counters[r];
+
+	if (counter->depth > 0 && --counter->depth == 0) {
+		counter->nsec += profile_now() - counter->start;
+	}
+}
+
+/**
+ * Zero all counters.  Regions which are currently active keep timing from
+ * the point of the reset.
+ */
+void profile_reset(void)
+{
+	int i;
+	uint64_t now = profile_now();
+
+	for (i = 0; i < PROF_MAX; i++) {
+		profile_counters[i].calls = 0;
+		profile_counters[i].nsec = 0;
+		profile_counters[i].start = now;
+	}
+}
+
+/**
+ * Write the counters to 'path' as comma separated values, one line per region
+ */
+bool profile_dump_csv(const char *path)
+{
+	ang_file *f = file_open(path, MODE_WRITE, FTYPE_TEXT);
+	int i;
+
+	if (!f) return false;
+
+	file_putf(f, "region,description,calls,total_ms,us_per_call\n");
+	for (i = 0; i < PROF_MAX; i++) {
+		const struct profile_counter *counter = &profile_counters[i];
+
+		file_putf(f, "%s,\"%s\",%lu,%.3f,%.3f\n", profile_region_info[i].name,
+			profile_region_info[i].desc, (unsigned long)counter->calls,
+			counter->nsec / 1.0e6,
+			counter->calls ? counter->nsec / 1.0e3 / counter->calls : 0.0);
+	}
+
+	return file_close(f);
+}
+
+const char *profile_region_name(enum profile_region r)
+{
+	return profile_region_info[r].name;
+}
+
+const char *profile_region_desc(enum profile_region r)
+{
+	return profile_region_info[r].desc;
+}
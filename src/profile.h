@@ -0,0 +1,72 @@
+/**
+ * \file profile.h
+ * \brief Call counters and timers for hot code paths
+ *
+ * Copyright (c) 2026 Angband contributors
+ *
+ * This work is free software; you can redistribute it and/or modify it
+ * under the terms of either:
+ *
+ * a) the GNU General Public License as published by the Free Software
+ *    Foundation, version 2, or
+ *
+ * b) the "Angband licence":
+ *    This software may be copied and distributed for educational, research,
+ *    and not for profit purposes provided that this copyright and statement
+ *    are included in all such copies.  Other copyrights may also apply.
+ */
+
+#ifndef INCLUDED_PROFILE_H
+#define INCLUDED_PROFILE_H
+
+#include "h-basic.h"
+
+/**
+ * Profiled regions
+ */
+enum profile_region {
+	#define PROF(a, b) PROF_##a,
+	#include "list-profile-regions.h"
+	#undef PROF
+	PROF_MAX
+};
+
+/**
+ * Accumulated cost of one region
+ */
+struct profile_counter {
+	uint32_t calls;		/* Number of times the region was entered */
+	uint64_t nsec;		/* Total time spent in the region */
+	uint64_t start;		/* Time the outermost active entry started */
+	int depth;			/* Nesting depth, so recursion is timed once */
+};
+
+/**
+ * Mark the start and end of a profiled region.  These compile to nothing
+ * unless the build has USE_PROFILE defined, so they can be left in hot paths.
+ * Every PROFILE_START() must be matched by a PROFILE_STOP() on every path out
+ * of the region.  PROFILE_COUNT() just counts an event, for regions which
+ * are never timed.
+ */
+#ifdef USE_PROFILE
+#define PROFILE_START(r) profile_start(PROF_##r)
+#define PROFILE_STOP(r) profile_stop(PROF_##r)
+#define PROFILE_COUNT(r) (profile_counters[PROF_##r].calls++)
+#else
+#define PROFILE_START(r) ((void)0)
+#define PROFILE_STOP(r) ((void)0)
+#define PROFILE_COUNT(r) ((void)0)
+#endif
+
+extern struct profile_counter profile_counters[PROF_MAX];
+
+bool profile_is_enabled(void);
+uint64_t profile_now(void);
+void profile_start(enum profile_region r);
+void profile_stop(enum profile_region r);
+void profile_reset(void);
+bool profile_dump_csv(const char *path);
+const char *profile_region_name(enum profile_region r);
+const char *profile_region_desc(enum profile_region r);
+
+#endif /* INCLUDED_PROFILE_H */
@@ -26,6 +26,7 @@
 #include "mon-util.h"
 #include "player-calcs.h"
 #include "player-timed.h"
+#include "profile.h"
 #include "project.h"
 #include "source.h"
 #include "trap.h"
@@ -340,37 +341,17 @@ int project_path_old(struct chunk *c, struct loc *gp, int range,
 #endif
 
 /**
- * Determine if a bolt spell cast from grid1 to grid2 will arrive
- * at the final destination, assuming that no monster gets in the way,
- * using the project_path() function to check the projection path.
- *
- * Accept projection flags, and pass them onto project_path().
- *
- * Note that no grid is ever projectable() from itself.
- *
- * This function is used to determine if the player can (easily) target
- * a given grid, if a monster can target the player, and if a clear shot
- * exists from monster to player.
+ * Trace the path for projectable(), below the checks against the player's
+ * field of fire
  */
-int projectable(struct chunk *c, struct loc grid1, struct loc grid2, int flg)
+static int projectable_path(struct chunk *c, struct loc grid1,
+		struct loc grid2, int flg)
 {
 	struct loc grid_g[512];
 	struct loc final, old_final = grid2;
 	int grid_n = 0;
 	int max_range = z_info->max_range;
 
-	/* We do not have permission to pass through walls */
-	if (!(flg & (PROJECT_WALL | PROJECT_PASS))) {
-		/* The character is the source or target of the projection */
-		if (loc_eq(grid1, player->grid)) {
-			/* Require that destination be in line of fire */
-			if (!square_isfire(c, grid2)) return PROJECT_PATH_NO;
-		} else if (loc_eq(grid2, player->grid)) {
-			/* Require that source be in line of fire */
-			if (!square_isfire(c, grid1)) return PROJECT_PATH_NO;
-		}
-	}
-
 	/* Check the projection path */
 	grid_n = project_path(c, grid_g, max_range, grid1, &grid2, flg);
 
@@ -399,6 +380,45 @@ int projectable(struct chunk *c, struct loc grid1, struct loc grid2, int flg)
 	return PROJECT_PATH_NOT_CLEAR;
 }
 
+/**
+ * Determine if a bolt spell cast from grid1 to grid2 will arrive
+ * at the final destination, assuming that no monster gets in the way,
+ * using the project_path() function to check the projection path.
+ *
+ * Accept projection flags, and pass them onto project_path().
+ *
+ * Note that no grid is ever projectable() from itself.
+ *
+ * This function is used to determine if the player can (easily) target
+ * a given grid, if a monster can target the player, and if a clear shot
+ * exists from monster to player.
+ */
+int projectable(struct chunk *c, struct loc grid1, struct loc grid2, int flg)
+{
+	int result;
+
+	/* We do not have permission to pass through walls */
+	if (!(flg & (PROJECT_WALL | PROJECT_PASS))) {
+		/* The character is the source or target of the projection */
+		if (loc_eq(grid1, player->grid)) {
+			/* Require that destination be in line of fire */
+			if (!square_isfire(c, grid2)) return PROJECT_PATH_NO;
+		} else if (loc_eq(grid2, player->grid)) {
+			/* Require that source be in line of fire */
+			if (!square_isfire(c, grid1)) return PROJECT_PATH_NO;
+		}
+	}
+
+	/* The path itself may have been traced already this turn */
+	if (path_cache_get(c, grid1, grid2, flg, &result)) return result;
+
+	/* Check the projection path */
+	result = projectable_path(c, grid1, grid2, flg);
+	path_cache_set(c, grid1, grid2, flg, result);
+	return result;
+}
+
+
 
 
 
@@ -636,6 +656,8 @@ bool project(struct source origin, int rad, struct loc finish,
 	/* Precalculated damage values for each distance. */
 	int *dam_at_dist = malloc((z_info->max_range + 1) * sizeof(*dam_at_dist));
 
+	PROFILE_START(project);
+
 	/* Flush any pending output */
 	handle_stuff(player);
 
@@ -1029,6 +1051,7 @@ bool project(struct source origin, int rad, struct loc finish,
 				notice = true;
 				if (player->is_dead) {
 					free(dam_at_dist);
+					PROFILE_STOP(project);
 					return notice;
 				}
 				break;
@@ -1055,6 +1078,7 @@ bool project(struct source origin, int rad, struct loc finish,
 	if (player->upkeep->update) update_stuff(player);
 
 	free(dam_at_dist);
+	PROFILE_STOP(project);
 
 	/* Return "something was noticed" */
 	return (notice);
@@ -19,6 +19,7 @@
 #include "angband.h"
 #include "game-world.h"
 #include "init.h"
+#include "profile.h"
 #include "savefile.h"
 #include "save-charoutput.h"
 
@@ -379,6 +380,8 @@ bool savefile_save(const char *path)
 	char new_savefile[1024];
 	char old_savefile[1024];
 
+	PROFILE_START(savefile_save);
+
 	/* Generate a CharOutput.txt, mainly for angband.live, when saving. */
 	(void) save_charoutput();
 
@@ -434,6 +437,7 @@ bool savefile_save(const char *path)
 
 		safe_setuid_drop();
 
+		PROFILE_STOP(savefile_save);
 		return err ? false : true;
 	}
 
@@ -445,6 +449,7 @@ bool savefile_save(const char *path)
 		file_delete(new_savefile);
 		safe_setuid_drop();
 	}
+	PROFILE_STOP(savefile_save);
 	return false;
 }
 
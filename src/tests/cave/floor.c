@@ -0,0 +1,137 @@
+/* cave/floor */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "cave.h"
+#include "generate.h"
+#include "init.h"
+#include "z-rand.h"
+#include "z-virt.h"
+
+int setup_tests(void **state) {
+	struct chunk *c;
+	struct loc grid;
+
+	/* Need to initialize the terrain information. */
+	set_file_paths();
+	if (!init_angband()) {
+		*state = NULL;
+		return 1;
+	}
+	Rand_init();
+
+	c = cave_new(9, 30);
+	for (grid.y = 0; grid.y < c->height; ++grid.y) {
+		for (grid.x = 0; grid.x < c->width; ++grid.x) {
+			if (grid.y == 0 || grid.y == c->height - 1 || grid.x == 0
+					|| grid.x == c->width - 1) {
+				square_set_feat(c, grid, FEAT_PERM);
+			} else {
+				square_set_feat(c, grid, FEAT_FLOOR);
+			}
+		}
+	}
+	*state = c;
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	cave_free(state);
+	cleanup_angband();
+	return 0;
+}
+
+/**
+ * Check that the floor list holds exactly the floor grids of the chunk.
+ */
+static bool floor_list_matches(struct chunk *c)
+{
+	struct loc grid;
+	int count = 0;
+
+	for (grid.y = 0; grid.y < c->height; ++grid.y) {
+		for (grid.x = 0; grid.x < c->width; ++grid.x) {
+			int n = grid.y * c->width + grid.x;
+			int place = c->floor_place[n];
+
+			if (square_isfloor(c, grid)) {
+				if (place < 0 || place >= c->floor_count) return false;
+				if (c->floor_grids[place] != n) return false;
+				count++;
+			} else if (place != -1) {
+				return false;
+			}
+		}
+	}
+	return count == c->floor_count;
+}
+
+static int test_floor_list(void *state) {
+	struct chunk *c = state;
+	int i;
+
+	eq(c->floor_count, (c->height - 2) * (c->width - 2));
+	require(floor_list_matches(c));
+
+	/* Knock out and restore grids at random */
+	for (i = 0; i < 200; i++) {
+		struct loc grid = loc(1 + randint0(c->width - 2),
+			1 + randint0(c->height - 2));
+		square_set_feat(c, grid, square_isfloor(c, grid) ?
+			FEAT_GRANITE : FEAT_FLOOR);
+		require(floor_list_matches(c));
+	}
+
+	/* Changing one floor into another leaves the list alone */
+	for (i = 0; i < c->floor_count; i++) {
+		int n = c->floor_grids[i];
+		square_set_feat(c, loc(n % c->width, n / c->width), FEAT_FLOOR);
+	}
+	require(floor_list_matches(c));
+	ok;
+}
+
+static int test_find_floor(void *state) {
+	struct chunk *c = state;
+	struct loc top_left = loc(0, 0);
+	struct loc bottom_right = loc(c->width - 1, c->height - 1);
+	struct loc grid;
+	bool *seen = mem_zalloc(c->height * c->width * sizeof(bool));
+	bool invalid = false;
+	int *find_state, visits = 0;
+
+	/* Leave one floor grid in the top row of the interior */
+	for (grid.y = 1; grid.y < c->height - 1; ++grid.y) {
+		for (grid.x = 1; grid.x < c->width - 1; ++grid.x) {
+			square_set_feat(c, grid, FEAT_GRANITE);
+		}
+	}
+	square_set_feat(c, loc(7, 1), FEAT_FLOOR);
+	require(find_empty(c, &grid));
+	require(loc_eq(grid, loc(7, 1)));
+	require(!cave_find_floor_in_range(c, &grid, loc(8, 1), loc(20, 5),
+		square_isempty));
+
+	/* Every floor grid in the rectangle comes up once, and nothing else */
+	square_set_feat(c, loc(3, 4), FEAT_FLOOR);
+	square_set_feat(c, loc(20, 7), FEAT_FLOOR);
+	find_state = cave_find_init_floor(c, top_left, bottom_right);
+	while (cave_find_get_grid(&grid, find_state)) {
+		int n = grid.y * c->width + grid.x;
+		if (!square_isfloor(c, grid) || seen[n]) invalid = true;
+		seen[n] = true;
+		visits++;
+	}
+	mem_free(find_state);
+	mem_free(seen);
+	require(!invalid);
+	eq(visits, 3);
+	ok;
+}
+
+const char *suite_name = "cave/floor";
+struct test tests[] = {
+	{ "floor list", test_floor_list },
+	{ "find floor", test_find_floor },
+	{ NULL, NULL }
+};
@@ -0,0 +1,178 @@
+/* cave/grid-classes */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "cave.h"
+#include "init.h"
+#include "object.h"
+#include "source.h"
+#include "trap.h"
+#include "z-rand.h"
+#include "z-virt.h"
+
+int setup_tests(void **state) {
+	struct chunk *c;
+	struct loc grid;
+
+	/* Need to initialize the terrain information. */
+	set_file_paths();
+	if (!init_angband()) {
+		*state = NULL;
+		return 1;
+	}
+	Rand_init();
+
+	c = cave_new(12, 40);
+	for (grid.y = 0; grid.y < c->height; ++grid.y) {
+		for (grid.x = 0; grid.x < c->width; ++grid.x) {
+			square_set_feat(c, grid, FEAT_FLOOR);
+		}
+	}
+	*state = c;
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	cave_free(state);
+	cleanup_angband();
+	return 0;
+}
+
+/**
+ * Check that the list for a grid class holds exactly the grids of the chunk
+ * which satisfy a predicate.
+ */
+static bool class_matches(struct chunk *c, int class, square_predicate pred)
+{
+	const struct grid_list *list = &c->grid_lists[class];
+	struct loc grid;
+	int count = 0;
+
+	for (grid.y = 0; grid.y < c->height; ++grid.y) {
+		for (grid.x = 0; grid.x < c->width; ++grid.x) {
+			int n = grid.y * c->width + grid.x;
+			int place = list->place[n];
+
+			if (pred(c, grid)) {
+				if (place < 0 || place >= list->count) return false;
+				if (list->grids[place] != n) return false;
+				count++;
+			} else if (place != -1) {
+				return false;
+			}
+		}
+	}
+	return count == list->count;
+}
+
+static bool square_hastrap(struct chunk *c, struct loc grid)
+{
+	return square_trap(c, grid) != NULL;
+}
+
+static bool square_haschest(struct chunk *c, struct loc grid)
+{
+	struct object *obj;
+
+	for (obj = square_object(c, grid); obj; obj = obj->next) {
+		if (obj->tval == TV_CHEST) return true;
+	}
+	return false;
+}
+
+static bool all_classes_match(struct chunk *c)
+{
+	return class_matches(c, GRID_CLASS_DOOR, square_isdoor)
+		&& class_matches(c, GRID_CLASS_SECRET_DOOR, square_issecretdoor)
+		&& class_matches(c, GRID_CLASS_TRAP, square_hastrap)
+		&& class_matches(c, GRID_CLASS_CHASM, square_ischasm)
+		&& class_matches(c, GRID_CLASS_RUBBLE, square_isrubble)
+		&& class_matches(c, GRID_CLASS_CHEST, square_haschest)
+		&& class_matches(c, GRID_CLASS_FORGE, square_isforge)
+		&& class_matches(c, GRID_CLASS_STAIR, square_isstairs);
+}
+
+static int test_terrain(void *state) {
+	struct chunk *c = state;
+	int feats[] = { FEAT_FLOOR, FEAT_CLOSED, FEAT_OPEN, FEAT_BROKEN,
+		FEAT_LESS, FEAT_MORE, FEAT_LESS_SHAFT, FEAT_MORE_SHAFT, FEAT_CHASM,
+		FEAT_SECRET, FEAT_RUBBLE, FEAT_GRANITE, FEAT_FORGE, FEAT_FORGE_GOOD };
+	int i;
+
+	require(all_classes_match(c));
+	for (i = 0; i < 2000; i++) {
+		struct loc grid = loc(randint0(c->width), randint0(c->height));
+		square_set_feat(c, grid, feats[randint0(N_ELEMENTS(feats))]);
+		require(all_classes_match(c));
+	}
+	ok;
+}
+
+static int test_traps_and_chests(void *state) {
+	struct chunk *c = state;
+	struct trap trap;
+	struct object chest, other;
+	struct loc grid = loc(5, 5);
+
+	memset(&trap, 0, sizeof(trap));
+	memset(&chest, 0, sizeof(chest));
+	memset(&other, 0, sizeof(other));
+	chest.tval = TV_CHEST;
+	other.tval = TV_SWORD;
+
+	square_set_trap(c, grid, &trap);
+	require(all_classes_match(c));
+
+	/* A chest counts wherever it is in the pile */
+	other.next = &chest;
+	chest.prev = &other;
+	square_set_obj(c, grid, &other);
+	require(all_classes_match(c));
+	square_excise_object(c, grid, &chest);
+	require(all_classes_match(c));
+	eq(c->grid_lists[GRID_CLASS_CHEST].count, 0);
+
+	/* Leave nothing behind for cave_free() */
+	square_set_obj(c, grid, NULL);
+	square_set_trap(c, grid, NULL);
+	require(all_classes_match(c));
+	eq(c->grid_lists[GRID_CLASS_TRAP].count, 0);
+	ok;
+}
+
+static int test_class_grids(void *state) {
+	struct chunk *c = state;
+	struct loc *grids, grid;
+	int i, n, expected = 0;
+
+	/* Doors also in the secret door class come up once, in map order */
+	grids = cave_class_grids(c, (1 << GRID_CLASS_DOOR)
+		| (1 << GRID_CLASS_SECRET_DOOR) | (1 << GRID_CLASS_CHASM), &n);
+	for (grid.y = 0; grid.y < c->height; ++grid.y) {
+		for (grid.x = 0; grid.x < c->width; ++grid.x) {
+			if (!square_isdoor(c, grid) && !square_ischasm(c, grid)) continue;
+			if (expected >= n || !loc_eq(grids[expected], grid)) {
+				mem_free(grids);
+				require(false);
+			}
+			expected++;
+		}
+	}
+	mem_free(grids);
+	eq(n, expected);
+
+	/* Random picks come from the class */
+	for (i = 0; i < 100; i++) {
+		if (!cave_find_class(c, &grid, GRID_CLASS_STAIR)) break;
+		require(square_isstairs(c, grid));
+	}
+	ok;
+}
+
+const char *suite_name = "cave/grid-classes";
+struct test tests[] = {
+	{ "terrain", test_terrain },
+	{ "traps and chests", test_traps_and_chests },
+	{ "class grids", test_class_grids },
+	{ NULL, NULL }
+};
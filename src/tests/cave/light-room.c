@@ -0,0 +1,106 @@
+/* cave/light-room */
+/* Light and darken a room as big as the level, then half of one. */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "cave.h"
+#include "game-world.h"
+#include "generate.h"
+#include "init.h"
+#include "mon-make.h"
+#include "player-birth.h"
+
+int setup_tests(void **state) {
+	set_file_paths();
+	init_angband();
+#ifdef UNIX
+	/* Necessary for creating the randart file. */
+	create_needed_dirs();
+#endif
+
+	/* Set up the player. */
+	if (!player_make_simple(NULL, NULL, NULL, "Tester")) {
+		cleanup_angband();
+		return 1;
+	}
+
+	prepare_next_level(player);
+	on_new_level();
+
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	wipe_mon_list(cave, player);
+	cleanup_angband();
+
+	return 0;
+}
+
+/**
+ * Turn the inside of the level into one lit room, with a wall (not part of
+ * the room) down column wall_x if that is inside
+ */
+static void make_hall(struct chunk *c, int wall_x)
+{
+	struct loc grid;
+
+	for (grid.y = 1; grid.y < c->height - 1; grid.y++) {
+		for (grid.x = 1; grid.x < c->width - 1; grid.x++) {
+			if (grid.x == wall_x) {
+				square_set_feat(c, grid, FEAT_GRANITE);
+				sqinfo_off(square(c, grid)->info, SQUARE_ROOM);
+			} else {
+				square_set_feat(c, grid, FEAT_FLOOR);
+				sqinfo_on(square(c, grid)->info, SQUARE_ROOM);
+			}
+			sqinfo_on(square(c, grid)->info, SQUARE_GLOW);
+		}
+	}
+}
+
+/**
+ * Count the glowing grids inside the level, left of column x
+ */
+static int count_glow(struct chunk *c, int x)
+{
+	struct loc grid;
+	int n = 0;
+
+	for (grid.y = 1; grid.y < c->height - 1; grid.y++) {
+		for (grid.x = 1; grid.x < x; grid.x++) {
+			if (square_isglow(c, grid)) n++;
+		}
+	}
+	return n;
+}
+
+static int test_whole_level(void *state) {
+	struct chunk *c = cave;
+
+	make_hall(c, -1);
+	eq(count_glow(c, c->width - 1), (c->height - 2) * (c->width - 2));
+	light_room(loc(c->width / 2, c->height / 2), false);
+	eq(count_glow(c, c->width - 1), 0);
+	ok;
+}
+
+static int test_divided(void *state) {
+	struct chunk *c = cave;
+	int wall_x = c->width / 2;
+
+	make_hall(c, wall_x);
+	light_room(loc(1, 1), false);
+
+	/* The left half is dark, the wall and the right half still lit */
+	eq(count_glow(c, wall_x), 0);
+	eq(count_glow(c, c->width - 1), (c->height - 2) * (c->width - 1 - wall_x));
+	ok;
+}
+
+const char *suite_name = "cave/light-room";
+struct test tests[] = {
+	{ "whole level", test_whole_level },
+	{ "divided", test_divided },
+	{ NULL, NULL }
+};
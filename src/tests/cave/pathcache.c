@@ -0,0 +1,87 @@
+/* cave/pathcache */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "cave.h"
+#include "init.h"
+#include "project.h"
+
+static struct chunk *create_empty_cave(int height, int width) {
+	struct chunk *c = cave_new(height, width);
+	struct loc grid;
+
+	for (grid.y = 0; grid.y < height; ++grid.y) {
+		for (grid.x = 0; grid.x < width; ++grid.x) {
+			if (grid.y == 0 || grid.y == height - 1 || grid.x == 0
+					|| grid.x == width - 1) {
+				square_set_feat(c, grid, FEAT_PERM);
+			} else {
+				square_set_feat(c, grid, FEAT_FLOOR);
+			}
+		}
+	}
+	return c;
+}
+
+int setup_tests(void **state) {
+	/* Need to initialize the terrain information. */
+	set_file_paths();
+	if (!init_angband()) {
+		*state = NULL;
+		return 1;
+	}
+
+	/* Only paths on the current level are cached */
+	cave = create_empty_cave(7, 20);
+	*state = cave;
+
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	cave_free(state);
+	cave = NULL;
+	cleanup_angband();
+	return 0;
+}
+
+static int test_los_terrain(void *state) {
+	struct chunk *c = state;
+	struct loc from = loc(2, 3), to = loc(17, 3), mid = loc(9, 3);
+
+	require(los(c, from, to));
+	require(los(c, from, to));
+
+	/* A new wall must not be hidden by the earlier answer */
+	square_set_feat(c, mid, FEAT_GRANITE);
+	require(!los(c, from, to));
+	require(!los(c, to, from));
+
+	square_set_feat(c, mid, FEAT_FLOOR);
+	require(los(c, from, to));
+	ok;
+}
+
+static int test_projectable_occupants(void *state) {
+	struct chunk *c = state;
+	struct loc from = loc(2, 4), to = loc(17, 4), mid = loc(9, 4);
+
+	eq(projectable(c, from, to, PROJECT_STOP), PROJECT_PATH_CLEAR);
+	eq(projectable(c, from, to, PROJECT_NONE), PROJECT_PATH_NOT_CLEAR);
+
+	/* Something standing in the way stops a bolt, but not a plain check */
+	square_set_mon(c, mid, -1);
+	eq(projectable(c, from, to, PROJECT_STOP), PROJECT_PATH_NO);
+	eq(projectable(c, from, to, PROJECT_NONE), PROJECT_PATH_NOT_CLEAR);
+
+	square_set_mon(c, mid, 0);
+	eq(projectable(c, from, to, PROJECT_STOP), PROJECT_PATH_CLEAR);
+	ok;
+}
+
+const char *suite_name = "cave/pathcache";
+struct test tests[] = {
+	{ "los_terrain", test_los_terrain },
+	{ "projectable_occupants", test_projectable_occupants },
+	{ NULL, NULL }
+};
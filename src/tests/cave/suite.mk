@@ -1,3 +1,7 @@
 TESTPROGS += \
 	cave/find \
+	cave/floor \
+	cave/grid-classes \
+	cave/light-room \
+	cave/pathcache \
 	cave/scatter
@@ -0,0 +1,141 @@
+/*
+ * effects/compiled
+ * Test that compiled effect chains behave like walking the chain, for every
+ * effect chain in the game data.
+ */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "cave.h"
+#include "effects.h"
+#include "game-world.h"
+#include "generate.h"
+#include "init.h"
+#include "mon-make.h"
+#include "obj-chest.h"
+#include "player.h"
+#include "player-birth.h"
+#include "songs.h"
+#include "source.h"
+#include "trap.h"
+#include "z-dice.h"
+
+int setup_tests(void **state) {
+	set_file_paths();
+	init_angband();
+#ifdef UNIX
+	/* Necessary for creating the randart file. */
+	create_needed_dirs();
+#endif
+	/* Expressions may depend on the player and the level. */
+	if (!player_make_simple(NULL, NULL, NULL, "Tester")) {
+		cleanup_angband();
+		return 1;
+	}
+	prepare_next_level(player);
+	on_new_level();
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	wipe_mon_list(cave, player);
+	cleanup_angband();
+	return 0;
+}
+
+/**
+ * Check a chain with several seeds, counting the chains checked.
+ */
+static bool chain_matches(struct effect *effect, int *count)
+{
+	uint32_t seeds[] = { 1, 42, 0x9e3779b9, 0xdeadbeef };
+	size_t i;
+
+	if (!effect) return true;
+	for (i = 0; i < N_ELEMENTS(seeds); i++) {
+		if (!effect_test_compiled(effect, seeds[i])) return false;
+	}
+	(*count)++;
+	return true;
+}
+
+static int test_object_effects(void *state) {
+	int i, count = 0;
+
+	for (i = 0; i < z_info->k_max; i++) {
+		require(chain_matches(k_info[i].effect, &count));
+		require(chain_matches(k_info[i].thrown_effect, &count));
+	}
+	require(count > 0);
+	ok;
+}
+
+static int test_monster_spell_effects(void *state) {
+	const struct monster_spell *spell;
+	int count = 0;
+
+	for (spell = monster_spells; spell; spell = spell->next) {
+		require(chain_matches(spell->effect, &count));
+		require(chain_matches(spell->effect_xtra, &count));
+	}
+
+	/* Spell power comes from the reference race when there is one */
+	ref_race = &r_info[1];
+	for (spell = monster_spells; spell; spell = spell->next) {
+		require(chain_matches(spell->effect, &count));
+	}
+	ref_race = NULL;
+	require(count > 0);
+	ok;
+}
+
+static int test_trap_effects(void *state) {
+	const struct chest_trap *ctrap;
+	int i, count = 0;
+
+	for (i = 0; i < z_info->trap_max; i++) {
+		require(chain_matches(trap_info[i].effect, &count));
+		require(chain_matches(trap_info[i].effect_xtra, &count));
+	}
+	for (ctrap = chest_traps; ctrap; ctrap = ctrap->next) {
+		require(chain_matches(ctrap->effect, &count));
+	}
+	require(count > 0);
+	ok;
+}
+
+static int test_song_effects(void *state) {
+	const struct song *song;
+	int count = 0;
+
+	for (song = songs; song; song = song->next) {
+		require(chain_matches(song->effect, &count));
+	}
+	require(count > 0);
+	ok;
+}
+
+static int test_bad_effect(void *state) {
+	struct effect *first = mem_zalloc(sizeof(*first));
+	struct effect *second = mem_zalloc(sizeof(*second));
+
+	/* A bad effect after a good one stops the chain in both forms */
+	first->index = EF_DAMAGE;
+	first->dice = dice_new();
+	require(dice_parse_string(first->dice, "2d6"));
+	first->next = second;
+	second->index = EF_MAX;
+	require(effect_test_compiled(first, 7));
+	free_effect(first);
+	ok;
+}
+
+const char *suite_name = "effects/compiled";
+struct test tests[] = {
+	{ "object effects", test_object_effects },
+	{ "monster spell effects", test_monster_spell_effects },
+	{ "trap effects", test_trap_effects },
+	{ "song effects", test_song_effects },
+	{ "bad effect", test_bad_effect },
+	{ NULL, NULL }
+};
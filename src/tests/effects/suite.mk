@@ -1 +1 @@
-TESTPROGS += effects/chain effects/earthquake effects/info
+TESTPROGS += effects/chain effects/compiled effects/earthquake effects/info
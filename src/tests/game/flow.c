@@ -0,0 +1,225 @@
+/* game/flow */
+/* Compare the row bitset flow kernel with the queue one on generated levels. */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include <time.h>
+#include "cave.h"
+#include "game-world.h"
+#include "generate.h"
+#include "init.h"
+#include "mon-make.h"
+#include "mon-util.h"
+#include "monster.h"
+#include "player-birth.h"
+#include "player-util.h"
+
+static clock_t queue_time, row_time;
+
+int setup_tests(void **state) {
+	set_file_paths();
+	init_angband();
+#ifdef UNIX
+	/* Necessary for creating the randart file. */
+	create_needed_dirs();
+#endif
+
+	/* Set up the player. */
+	if (!player_make_simple(NULL, NULL, NULL, "Tester")) {
+		cleanup_angband();
+		return 1;
+	}
+
+	prepare_next_level(player);
+	on_new_level();
+
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	if (verbose) {
+		printf("    queue kernel %.1f ms, row kernel %.1f ms\n",
+			1000.0 * queue_time / CLOCKS_PER_SEC,
+			1000.0 * row_time / CLOCKS_PER_SEC);
+	}
+	wipe_mon_list(cave, player);
+	cleanup_angband();
+
+	return 0;
+}
+
+/**
+ * Mark every monster's target, so the ones a flow resets can be seen
+ */
+static void mark_targets(struct chunk *c)
+{
+	int i;
+
+	for (i = 1; i < cave_monster_max(c); i++) {
+		struct monster *mon = cave_monster(c, i);
+		if (mon->race) mon->target.grid = loc(1, 1);
+	}
+}
+
+/**
+ * Run both kernels from the same centre and check they agree on every grid
+ * and on which monsters reconsider their targets
+ */
+static bool kernels_agree(struct chunk *c, struct loc centre,
+		struct monster *mon)
+{
+	struct flow a = { centre, NULL }, b = { centre, NULL };
+	bool *reset = mem_zalloc(cave_monster_max(c) * sizeof(bool));
+	bool same = true;
+	clock_t start;
+	int y, i;
+
+	flow_new(c, &a);
+	flow_new(c, &b);
+
+	mark_targets(c);
+	start = clock();
+	update_flow_queue(c, &a, mon);
+	queue_time += clock() - start;
+	for (i = 1; i < cave_monster_max(c); i++) {
+		struct monster *grid_mon = cave_monster(c, i);
+		reset[i] = grid_mon->race && loc_is_zero(grid_mon->target.grid);
+	}
+
+	mark_targets(c);
+	start = clock();
+	update_flow(c, &b, mon);
+	row_time += clock() - start;
+	for (i = 1; i < cave_monster_max(c); i++) {
+		struct monster *grid_mon = cave_monster(c, i);
+		if (reset[i] != (grid_mon->race &&
+				loc_is_zero(grid_mon->target.grid))) {
+			same = false;
+		}
+	}
+
+	for (y = 0; y < c->height; y++) {
+		if (memcmp(a.grids[y], b.grids[y], c->width * sizeof(uint16_t))) {
+			same = false;
+		}
+	}
+
+	flow_free(c, &b);
+	flow_free(c, &a);
+	mem_free(reset);
+	return same;
+}
+
+/**
+ * Check noise flows and monster flows on the current level
+ */
+static bool level_agrees(struct chunk *c)
+{
+	struct loc grid;
+	int i, n;
+
+	if (!kernels_agree(c, player->grid, NULL)) return false;
+	for (i = 0; i < 4; i++) {
+		if (find_empty(c, &grid) && !kernels_agree(c, grid, NULL)) {
+			return false;
+		}
+	}
+	for (i = 1, n = 0; i < cave_monster_max(c) && n < 16; i++) {
+		struct monster *mon = cave_monster(c, i);
+		if (!mon->race) continue;
+		if (!kernels_agree(c, player->grid, mon)) return false;
+		n++;
+	}
+	return true;
+}
+
+static int test_generated_levels(void *state) {
+	int depth;
+
+	for (depth = 1; depth <= 20; depth += 3) {
+		dungeon_change_level(player, depth);
+		prepare_next_level(player);
+		on_new_level();
+		require(level_agrees(cave));
+	}
+	ok;
+}
+
+static int test_short_flows(void *state) {
+	int flow_max = z_info->flow_max, max;
+
+	/* Flows cut short leave costly grids past the end to be overwritten */
+	for (max = 3; max <= 40; max += 9) {
+		z_info->flow_max = max;
+		if (!level_agrees(cave)) {
+			z_info->flow_max = flow_max;
+			require(false);
+		}
+	}
+	z_info->flow_max = flow_max;
+	ok;
+}
+
+static int test_reused_noise(void *state) {
+	int flow_max = z_info->flow_max;
+	struct loc centre, door, grid;
+	struct monster *mon;
+	int feats[7][7];
+
+	/*
+	 * A closed door next to the noise, walled in apart from the centre, is
+	 * only reached from the centre and costs 1 + 5, which is made exactly
+	 * the end of the flow; a monster there still hears the noise, whether
+	 * the flow is worked out or kept from before.
+	 */
+	centre = loc(cave->width / 2, cave->height / 2);
+	door = loc(centre.x + 1, centre.y);
+	for (grid.y = 0; grid.y < 7; grid.y++) {
+		for (grid.x = 0; grid.x < 7; grid.x++) {
+			struct loc g = loc(centre.x + grid.x - 3, centre.y + grid.y - 3);
+
+			if (square_monster(cave, g)) delete_monster(cave, g);
+			feats[grid.y][grid.x] = square(cave, g)->feat;
+			square_set_feat(cave, g, FEAT_FLOOR);
+		}
+	}
+	for (grid.y = door.y - 1; grid.y <= door.y + 1; grid.y++) {
+		for (grid.x = door.x - 1; grid.x <= door.x + 1; grid.x++) {
+			if (!loc_eq(grid, centre) && !loc_eq(grid, door)) {
+				square_set_feat(cave, grid, FEAT_GRANITE);
+			}
+		}
+	}
+	mon = t_add_monster(cave, door, "Wolf");
+	square_set_feat(cave, door, FEAT_CLOSED);
+	z_info->flow_max = 6;
+
+	mark_targets(cave);
+	update_noise_flow(cave, centre);
+	eq(flow_dist(cave->monster_noise, door), z_info->flow_max);
+	require(loc_is_zero(mon->target.grid));
+
+	mark_targets(cave);
+	update_noise_flow(cave, centre);
+	eq(flow_dist(cave->monster_noise, door), z_info->flow_max);
+	require(loc_is_zero(mon->target.grid));
+	require(kernels_agree(cave, centre, NULL));
+
+	z_info->flow_max = flow_max;
+	delete_monster(cave, door);
+	for (grid.y = 0; grid.y < 7; grid.y++) {
+		for (grid.x = 0; grid.x < 7; grid.x++) {
+			square_set_feat(cave, loc(centre.x + grid.x - 3,
+				centre.y + grid.y - 3), feats[grid.y][grid.x]);
+		}
+	}
+	ok;
+}
+
+const char *suite_name = "game/flow";
+struct test tests[] = {
+	{ "generated levels", test_generated_levels },
+	{ "short flows", test_short_flows },
+	{ "reused noise", test_reused_noise },
+	{ NULL, NULL }
+};
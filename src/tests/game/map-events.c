@@ -0,0 +1,103 @@
+/* game/map-events.c */
+/* Check that marked map grids are passed on as blocks. */
+
+#include "unit-test.h"
+#include "game-event.h"
+
+#define MAX_REGIONS 16
+
+static struct {
+	struct loc top_left;
+	struct loc bottom_right;
+} regions[MAX_REGIONS];
+static int n_regions;
+
+static void note_region(game_event_type type, game_event_data *data,
+		void *user)
+{
+	if (n_regions < MAX_REGIONS) {
+		regions[n_regions].top_left = data->region.top_left;
+		regions[n_regions].bottom_right = data->region.bottom_right;
+	}
+	n_regions++;
+}
+
+int setup_tests(void **state) {
+	event_add_handler(EVENT_MAP, note_region, NULL);
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	event_remove_all_handlers();
+	return 0;
+}
+
+static bool region_is(int i, int x0, int y0, int x1, int y1)
+{
+	return loc_eq(regions[i].top_left, loc(x0, y0))
+		&& loc_eq(regions[i].bottom_right, loc(x1, y1));
+}
+
+static int test_nothing_marked(void *state) {
+	n_regions = 0;
+	event_flush_map();
+	eq(n_regions, 0);
+	ok;
+}
+
+static int test_blocks(void *state) {
+	struct loc grid;
+
+	/* A lit room marks every grid of a rectangle */
+	n_regions = 0;
+	for (grid.y = 3; grid.y <= 7; grid.y++) {
+		for (grid.x = 10; grid.x <= 20; grid.x++) {
+			event_mark_map(grid);
+		}
+	}
+	event_mark_map(loc(15, 5));
+	eq(n_regions, 0);
+	event_flush_map();
+	eq(n_regions, 1);
+	require(region_is(0, 10, 3, 20, 7));
+
+	/* Nothing is passed on twice */
+	event_flush_map();
+	eq(n_regions, 1);
+
+	/* Rows with different spans make separate blocks */
+	n_regions = 0;
+	event_mark_map(loc(4, 2));
+	event_mark_map(loc(4, 1));
+	event_mark_map(loc(8, 1));
+	event_mark_map(loc(50, 40));
+	event_flush_map();
+	eq(n_regions, 3);
+	require(region_is(0, 4, 1, 8, 1));
+	require(region_is(1, 4, 2, 4, 2));
+	require(region_is(2, 50, 40, 50, 40));
+	ok;
+}
+
+static int test_discard(void *state) {
+	n_regions = 0;
+	event_mark_map(loc(1, 1));
+	event_mark_map(loc(2, 9));
+	event_discard_map();
+	event_flush_map();
+	eq(n_regions, 0);
+
+	/* Grids off the map are ignored */
+	event_mark_map(loc(-1, -1));
+	event_flush_map();
+	eq(n_regions, 0);
+	ok;
+}
+
+const char *suite_name = "game/map-events";
+struct test tests[] = {
+	{ "nothing marked", test_nothing_marked },
+	{ "blocks", test_blocks },
+	{ "discard", test_discard },
+	{ NULL, NULL }
+};
@@ -1 +1,3 @@
-TESTPROGS += game/basic
+TESTPROGS += game/basic \
+             game/flow \
+             game/map-events
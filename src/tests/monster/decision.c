@@ -0,0 +1,128 @@
+/* monster/decision */
+/* Check that a monster's ranged attack decision follows it and its target. */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "cave.h"
+#include "game-world.h"
+#include "generate.h"
+#include "init.h"
+#include "mon-make.h"
+#include "mon-move.h"
+#include "mon-spell.h"
+#include "mon-util.h"
+#include "player-birth.h"
+#include "project.h"
+
+int setup_tests(void **state) {
+	struct loc grid;
+	int i;
+
+	set_file_paths();
+	init_angband();
+#ifdef UNIX
+	/* Necessary for creating the randart file. */
+	create_needed_dirs();
+#endif
+
+	/* Set up the player. */
+	if (!player_make_simple(NULL, NULL, NULL, "Tester")) {
+		cleanup_angband();
+		return 1;
+	}
+	prepare_next_level(player);
+	on_new_level();
+
+	/* Clear the level around the player */
+	for (i = cave_monster_max(cave) - 1; i >= 1; i--) {
+		if (cave_monster(cave, i)->race) delete_monster_idx(cave, i);
+	}
+	for (grid.y = 1; grid.y < cave->height - 1; grid.y++) {
+		for (grid.x = 1; grid.x < cave->width - 1; grid.x++) {
+			if (!square_isplayer(cave, grid)) {
+				square_set_feat(cave, grid, FEAT_FLOOR);
+			}
+		}
+	}
+	player->truce = false;
+	update_view(cave, player);
+
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	wipe_mon_list(cave, player);
+	cleanup_angband();
+
+	return 0;
+}
+
+/**
+ * Find an open grid dx grids across and dy grids down from the player
+ */
+static struct loc from_player(int dx, int dy)
+{
+	return loc(player->grid.x + ((player->grid.x + dx < cave->width - 1) ?
+		dx : -dx), player->grid.y + ((player->grid.y + dy < cave->height - 1) ?
+		dy : -dy));
+}
+
+static int test_decision(void *state) {
+	struct loc near = from_player(4, 0), wall = from_player(2, 0);
+	struct loc behind = from_player(4, 4);
+	struct monster *mon = t_add_monster(cave, near, "Orc archer");
+	bitflag f[RSF_SIZE], g[RSF_SIZE];
+
+	mon->alertness = ALERTNESS_ALERT;
+	mon->cdis = distance(mon->grid, player->grid);
+
+	/* The decision matches working it out from scratch */
+	eq(monster_target_path(mon, PROJECT_STOP), PROJECT_PATH_CLEAR);
+	monster_usable_spells(mon, f);
+	rsf_copy(g, mon->race->spell_flags);
+	remove_bad_spells(mon, g);
+	require(rsf_is_equal(f, g));
+	require(rsf_has(f, RSF_ARROW1));
+	require(monster_cast_chance(mon) > 0);
+
+	/* A new wall only counts from the next turn */
+	square_set_feat(cave, wall, FEAT_GRANITE);
+	eq(monster_target_path(mon, PROJECT_STOP), PROJECT_PATH_CLEAR);
+	turn++;
+	eq(monster_target_path(mon, PROJECT_STOP), PROJECT_PATH_NO);
+	eq(monster_cast_chance(mon), 0);
+	monster_usable_spells(mon, f);
+	require(rsf_is_empty(f));
+	square_set_feat(cave, wall, FEAT_FLOOR);
+
+	/* Moving the monster starts a new decision */
+	monster_swap(mon->grid, behind);
+	require(loc_eq(mon->grid, behind));
+	mon->cdis = distance(mon->grid, player->grid);
+	eq(monster_target_path(mon, PROJECT_STOP),
+		projectable(cave, behind, player->grid, PROJECT_STOP));
+	monster_usable_spells(mon, f);
+	rsf_copy(g, mon->race->spell_flags);
+	remove_bad_spells(mon, g);
+	require(rsf_is_equal(f, g));
+
+	/* So does a change of stance or mana */
+	square_set_feat(cave, wall, FEAT_GRANITE);
+	monster_swap(mon->grid, near);
+	mon->cdis = distance(mon->grid, player->grid);
+	eq(monster_target_path(mon, PROJECT_STOP), PROJECT_PATH_NO);
+	square_set_feat(cave, wall, FEAT_FLOOR);
+	mon->stance = (mon->stance == STANCE_FLEEING) ? STANCE_AGGRESSIVE :
+		STANCE_FLEEING;
+	eq(monster_target_path(mon, PROJECT_STOP), PROJECT_PATH_CLEAR);
+	square_set_feat(cave, wall, FEAT_GRANITE);
+	mon->mana++;
+	eq(monster_target_path(mon, PROJECT_STOP), PROJECT_PATH_NO);
+	ok;
+}
+
+const char *suite_name = "monster/decision";
+struct test tests[] = {
+	{ "decision", test_decision },
+	{ NULL, NULL }
+};
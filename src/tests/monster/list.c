@@ -0,0 +1,247 @@
+/* monster/list */
+/* Check that a monster list kept between updates matches one built afresh. */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "cave.h"
+#include "game-world.h"
+#include "generate.h"
+#include "init.h"
+#include "mon-list.h"
+#include "mon-make.h"
+#include "mon-util.h"
+#include "player-birth.h"
+
+/**
+ * Remove every monster from the level
+ */
+static void clear_monsters(void)
+{
+	int i;
+
+	for (i = cave_monster_max(cave) - 1; i >= 1; i--) {
+		if (cave_monster(cave, i)->race) delete_monster_idx(cave, i);
+	}
+}
+
+int setup_tests(void **state) {
+	struct loc grid;
+
+	set_file_paths();
+	init_angband();
+#ifdef UNIX
+	/* Necessary for creating the randart file. */
+	create_needed_dirs();
+#endif
+
+	/* Set up the player. */
+	if (!player_make_simple(NULL, NULL, NULL, "Tester")) {
+		cleanup_angband();
+		return 1;
+	}
+	prepare_next_level(player);
+	on_new_level();
+
+	/* Clear the level around the player */
+	clear_monsters();
+	for (grid.y = 1; grid.y < cave->height - 1; grid.y++) {
+		for (grid.x = 1; grid.x < cave->width - 1; grid.x++) {
+			if (!square_isplayer(cave, grid)) {
+				square_set_feat(cave, grid, FEAT_FLOOR);
+			}
+		}
+	}
+	update_view(cave, player);
+
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	clear_monsters();
+	wipe_mon_list(cave, player);
+	cleanup_angband();
+
+	return 0;
+}
+
+/**
+ * Place a visible monster of the named race 'dx' grids across from the player
+ */
+static struct monster *show(const char *race, int dx)
+{
+	struct loc grid = loc(player->grid.x + ((player->grid.x + dx <
+		cave->width - 1) ? dx : -dx), player->grid.y);
+	struct monster *mon = t_add_monster(cave, grid, race);
+
+	mflag_on(mon->mflag, MFLAG_VISIBLE);
+	return mon;
+}
+
+/**
+ * Bring a list up to date the way the monster list subwindow does
+ */
+static void update_list(monster_list_t *list)
+{
+	monster_list_reset(list);
+	monster_list_collect(list);
+	monster_list_sort(list, monster_list_standard_compare);
+}
+
+/**
+ * Check that each race maps to its row in the list, and no other race does
+ */
+static bool map_matches(const monster_list_t *list)
+{
+	int i, mapped = 0;
+
+	for (i = 0; i < z_info->r_max; i++) {
+		int row = list->race_entry[i];
+
+		if (!row) continue;
+		if (row > list->distinct_entries) return false;
+		if (list->entries[row - 1].race->ridx != i) return false;
+		mapped++;
+	}
+	return mapped == list->distinct_entries;
+}
+
+/**
+ * Check that two lists have the same rows with the same counts; if 'ordered'
+ * the rows must also be in the same order
+ */
+static bool rows_match(const monster_list_t *a, const monster_list_t *b,
+		bool ordered)
+{
+	int i, j;
+
+	if (a->distinct_entries != b->distinct_entries) return false;
+	for (i = 0; i < MONSTER_LIST_SECTION_MAX; i++) {
+		if (a->total_entries[i] != b->total_entries[i]) return false;
+		if (a->total_monsters[i] != b->total_monsters[i]) return false;
+	}
+	for (i = 0; i < a->distinct_entries; i++) {
+		const monster_list_entry_t *ea = &a->entries[i], *eb;
+
+		j = ordered ? i : b->race_entry[ea->race->ridx] - 1;
+		if (j < 0) return false;
+		eb = &b->entries[j];
+		if (ea->race != eb->race) return false;
+		if (memcmp(ea->count, eb->count, sizeof(ea->count))) return false;
+	}
+	return true;
+}
+
+/**
+ * Compare a list kept between updates with one built from scratch
+ */
+static bool matches_rebuild(const monster_list_t *list, bool ordered)
+{
+	monster_list_t *fresh = monster_list_new();
+	bool same;
+
+	update_list(fresh);
+	same = map_matches(fresh) && rows_match(list, fresh, ordered);
+	monster_list_free(fresh);
+	return same;
+}
+
+/**
+ * Row of the named race in the list, counting from 0; -1 if not listed
+ */
+static int row_of(const monster_list_t *list, const char *race)
+{
+	return list->race_entry[lookup_monster(race)->ridx] - 1;
+}
+
+static int test_add_remove(void *state) {
+	monster_list_t *list = monster_list_new();
+	struct monster *orc, *wolf;
+
+	/* All the races here have different depths, so only one order works */
+	wolf = show("Wolf", 2);
+	orc = show("Orc", 3);
+	show("Orc scout", 4);
+	update_list(list);
+	eq(list->distinct_entries, 3);
+	require(map_matches(list));
+	require(matches_rebuild(list, true));
+
+	/* Gain a race and another of one already listed, and lose a race */
+	show("Orc soldier", 5);
+	show("Wolf", 6);
+	delete_monster_idx(cave, orc->midx);
+	update_list(list);
+	eq(list->distinct_entries, 3);
+	eq(row_of(list, "Orc"), -1);
+	eq(list->entries[row_of(list, "Wolf")].count[MONSTER_LIST_SECTION_LOS]
+		+ list->entries[row_of(list, "Wolf")].count[MONSTER_LIST_SECTION_ESP],
+		2);
+	require(map_matches(list));
+	require(matches_rebuild(list, true));
+
+	/* Lose one of a pair, then bring back a race which had gone */
+	delete_monster_idx(cave, wolf->midx);
+	show("Orc", 7);
+	update_list(list);
+	eq(list->distinct_entries, 4);
+	require(map_matches(list));
+	require(matches_rebuild(list, true));
+
+	/* Nothing left to see */
+	clear_monsters();
+	update_list(list);
+	eq(list->distinct_entries, 0);
+	require(map_matches(list));
+	require(matches_rebuild(list, true));
+
+	monster_list_free(list);
+	ok;
+}
+
+static int test_stable(void *state) {
+	monster_list_t *list = monster_list_new();
+	struct monster *scout, *soldier;
+
+	/*
+	 * Orc scouts and blue serpents are equally deep.  A list built from
+	 * scratch has them in monster order, but one kept between updates leaves
+	 * the serpent where it was and puts the newly seen scout after it.
+	 */
+	scout = show("Orc scout", 2);
+	mflag_off(scout->mflag, MFLAG_VISIBLE);
+	show("Blue serpent", 3);
+	show("Wolf", 4);
+	update_list(list);
+	eq(row_of(list, "Blue serpent"), 0);
+	eq(row_of(list, "Wolf"), 1);
+
+	mflag_on(scout->mflag, MFLAG_VISIBLE);
+	soldier = show("Orc soldier", 5);
+	update_list(list);
+	require(map_matches(list));
+	require(matches_rebuild(list, false));
+	eq(row_of(list, "Orc soldier"), 0);
+	eq(row_of(list, "Blue serpent"), 1);
+	eq(row_of(list, "Orc scout"), 2);
+	eq(row_of(list, "Wolf"), 3);
+
+	/* Dropping a row keeps the others in the same order */
+	delete_monster_idx(cave, soldier->midx);
+	update_list(list);
+	require(map_matches(list));
+	require(matches_rebuild(list, false));
+	eq(row_of(list, "Blue serpent"), 0);
+	eq(row_of(list, "Orc scout"), 1);
+	eq(row_of(list, "Wolf"), 2);
+
+	clear_monsters();
+	monster_list_free(list);
+	ok;
+}
+
+const char *suite_name = "monster/list";
+struct test tests[] = {
+	{ "add_remove", test_add_remove },
+	{ "stable", test_stable },
+	{ NULL, NULL }
+};
@@ -0,0 +1,150 @@
+/* object/artifact */
+/* Check that artifact objects are tracked as they move and are deleted. */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "cave.h"
+#include "game-world.h"
+#include "generate.h"
+#include "init.h"
+#include "mon-make.h"
+#include "obj-gear.h"
+#include "obj-knowledge.h"
+#include "obj-make.h"
+#include "obj-pile.h"
+#include "obj-util.h"
+#include "player-birth.h"
+
+int setup_tests(void **state) {
+	set_file_paths();
+	init_angband();
+#ifdef UNIX
+	/* Necessary for creating the randart file. */
+	create_needed_dirs();
+#endif
+
+	/* Set up the player. */
+	if (!player_make_simple(NULL, NULL, NULL, "Tester")) {
+		cleanup_angband();
+		return 1;
+	}
+
+	prepare_next_level(player);
+	on_new_level();
+
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	wipe_mon_list(cave, player);
+	cleanup_angband();
+
+	return 0;
+}
+
+/**
+ * Find an artifact that can be made and hasn't been.
+ */
+static const struct artifact *pick_artifact(void)
+{
+	int i;
+
+	for (i = 1; i < z_info->a_max; i++) {
+		const struct artifact *art = &a_info[i];
+
+		if (art->name && lookup_kind(art->tval, art->sval)
+				&& !is_artifact_created(art)
+				&& !artifact_object(art)) {
+			return art;
+		}
+	}
+	return NULL;
+}
+
+static struct object *new_artifact_object(const struct artifact *art)
+{
+	struct object *obj = object_new();
+
+	object_prep(obj, lookup_kind(art->tval, art->sval), art->level,
+		RANDOMISE);
+	obj->artifact = art;
+	copy_artifact_data(obj, art);
+	mark_artifact_created(art, true);
+	return obj;
+}
+
+static int test_floor_and_gear(void *state) {
+	const struct artifact *art = pick_artifact();
+	struct object *obj;
+	struct loc grid;
+	bool note;
+
+	notnull(art);
+	obj = new_artifact_object(art);
+
+	/* Made but not placed anywhere */
+	null(artifact_object(art));
+
+	/* Dropped on the floor */
+	require(find_empty(cave, &grid));
+	require(floor_carry(cave, grid, obj, &note));
+	ptreq(artifact_object(art), obj);
+	artifact_objects_check_integrity(cave, player);
+
+	/* Picked up */
+	square_excise_object(cave, grid, obj);
+	delist_object(cave, obj);
+	obj->known = object_new();
+	object_set_base_known(player, obj);
+	gear_insert_end(player, obj);
+	ptreq(artifact_object(art), obj);
+	artifact_objects_check_integrity(cave, player);
+
+	/* Destroyed */
+	require(gear_excise_object(player, obj));
+	object_delete(NULL, NULL, &obj->known);
+	object_delete(NULL, NULL, &obj);
+	null(artifact_object(art));
+	artifact_objects_check_integrity(cave, player);
+	ok;
+}
+
+static int test_copies(void *state) {
+	const struct artifact *art = pick_artifact();
+	struct object *obj, *copy;
+	struct loc grid;
+	bool note;
+
+	notnull(art);
+	obj = new_artifact_object(art);
+	require(find_empty(cave, &grid));
+	require(floor_carry(cave, grid, obj, &note));
+
+	/* Deleting a copy leaves the original recorded */
+	copy = object_new();
+	object_copy(copy, obj);
+	object_delete(NULL, NULL, &copy);
+	ptreq(artifact_object(art), obj);
+
+	/* Replacing the original by its copy follows the copy */
+	copy = object_new();
+	object_copy(copy, obj);
+	copy->oidx = 0;
+	copy->grid = loc(0, 0);
+	square_delete_object(cave, grid, obj, false, false);
+	null(artifact_object(art));
+	require(floor_carry(cave, grid, copy, &note));
+	ptreq(artifact_object(art), copy);
+	artifact_objects_check_integrity(cave, player);
+
+	square_delete_object(cave, grid, copy, false, false);
+	null(artifact_object(art));
+	ok;
+}
+
+const char *suite_name = "object/artifact";
+struct test tests[] = {
+	{ "floor and gear", test_floor_and_gear },
+	{ "copies", test_copies },
+	{ NULL, NULL }
+};
@@ -1,3 +1,3 @@
 # TESTPROGS += object/attack object/util object/pile object/slays
 # leave object/attack out for now as it fails on github
-TESTPROGS += object/util object/pile object/slays
+TESTPROGS += object/artifact object/util object/pile object/slays
@@ -0,0 +1,252 @@
+/* player/calc-bonuses.c */
+/* Check the cached bonus layers against a from-scratch calc_bonuses(). */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include "cave.h"
+#include "game-world.h"
+#include "generate.h"
+#include "init.h"
+#include "mon-make.h"
+#include "obj-gear.h"
+#include "obj-knowledge.h"
+#include "obj-make.h"
+#include "obj-pile.h"
+#include "obj-tval.h"
+#include "obj-util.h"
+#include "player-abilities.h"
+#include "player-birth.h"
+#include "player-calcs.h"
+#include "player-timed.h"
+#include "songs.h"
+
+int setup_tests(void **state) {
+	set_file_paths();
+	init_angband();
+#ifdef UNIX
+	/* Necessary for creating the randart file. */
+	create_needed_dirs();
+#endif
+
+	/* Set up the player. */
+	if (!player_make_simple(NULL, NULL, NULL, "Tester")) {
+		cleanup_angband();
+		return 1;
+	}
+
+	prepare_next_level(player);
+	on_new_level();
+
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	wipe_mon_list(cave, player);
+	cleanup_angband();
+
+	return 0;
+}
+
+/**
+ * Bring the player state up to date through the bonus layers, and check it
+ * against working everything out again.
+ */
+static bool state_matches_scratch(struct player *p)
+{
+	struct player_state state, known_state;
+
+	p->upkeep->update |= (PU_BONUS);
+	update_stuff(p);
+	calc_bonuses(p, &state, false, false);
+	calc_bonuses(p, &known_state, true, false);
+	return !memcmp(&state, &p->state, sizeof(state))
+		&& !memcmp(&known_state, &p->known_state, sizeof(known_state));
+}
+
+static struct object *wield_new_object(int tval, const char *name) {
+	struct object_kind *kind = lookup_kind(tval, lookup_sval(tval, name));
+	struct object *obj;
+
+	if (!kind) return NULL;
+	obj = object_new();
+	object_prep(obj, kind, 0, RANDOMISE);
+	obj->known = object_new();
+	object_set_base_known(player, obj);
+	object_touch(player, obj);
+	gear_insert_end(player, obj);
+	player->upkeep->total_weight += obj->weight;
+	inven_wield(obj, wield_slot(obj));
+	return obj;
+}
+
+static int test_timed(void *state) {
+	int food = player->timed[TMD_FOOD];
+
+	require(state_matches_scratch(player));
+	player->timed[TMD_STUN] = 20;
+	require(state_matches_scratch(player));
+	player->timed[TMD_STUN] = 80;
+	require(state_matches_scratch(player));
+	player->timed[TMD_RAGE] = 5;
+	player->timed[TMD_FAST] = 5;
+	require(state_matches_scratch(player));
+	player->timed[TMD_FOOD] = 1;
+	player->timed[TMD_SINVIS] = 5;
+	require(state_matches_scratch(player));
+	player->timed[TMD_FOOD] = 2;
+	require(state_matches_scratch(player));
+	player->timed[TMD_STUN] = 0;
+	player->timed[TMD_RAGE] = 0;
+	player->timed[TMD_FAST] = 0;
+	player->timed[TMD_SINVIS] = 0;
+	player->timed[TMD_FOOD] = food;
+	require(state_matches_scratch(player));
+	ok;
+}
+
+static int test_equipment(void *state) {
+	struct object *weapon = wield_new_object(TV_SWORD, "Dagger");
+	struct object *armour = wield_new_object(TV_SOFT_ARMOR, "Leather Armour");
+	int fire;
+
+	require(weapon && armour);
+	require(object_is_equipped(player->body, weapon));
+	require(object_is_equipped(player->body, armour));
+	require(state_matches_scratch(player));
+
+	/* Changes to an object in place are only noticed once reported */
+	armour->modifiers[STAT_STR] += 2;
+	armour->modifiers[STAT_MAX + SKILL_STEALTH] -= 1;
+	require(!state_matches_scratch(player));
+	equip_bonuses_changed(player, armour);
+	require(state_matches_scratch(player));
+	armour->el_info[ELEM_FIRE].res_level = 1;
+	equip_bonuses_changed(player, armour);
+	require(state_matches_scratch(player));
+	of_on(weapon->flags, OF_SEE_INVIS);
+	weapon->att += 3;
+	equip_bonuses_changed(player, weapon);
+	require(state_matches_scratch(player));
+
+	/* Learning a rune is reported without help */
+	fire = player->known_state.el_info[ELEM_FIRE].res_level;
+	equip_learn_element(player, ELEM_FIRE);
+	require(state_matches_scratch(player));
+	eq(player->known_state.el_info[ELEM_FIRE].res_level, fire + 1);
+	player_learn_flag(player, OF_SEE_INVIS);
+	require(state_matches_scratch(player));
+
+	inven_takeoff(armour);
+	require(state_matches_scratch(player));
+	ok;
+}
+
+static int test_songs(void *state) {
+	player->song[SONG_MAIN] = lookup_song("Slaying");
+	player->wrath = 400;
+	require(state_matches_scratch(player));
+	player->wrath = 900;
+	require(state_matches_scratch(player));
+	player->song[SONG_MINOR] = lookup_song("Freedom");
+	require(state_matches_scratch(player));
+	player->song[SONG_MAIN] = lookup_song("Staying");
+	player->song[SONG_MINOR] = NULL;
+	require(state_matches_scratch(player));
+	player->song[SONG_MAIN] = NULL;
+	player->wrath = 0;
+	require(state_matches_scratch(player));
+	ok;
+}
+
+/**
+ * Give the player an ability from the given skill, or take it away again
+ */
+static void set_ability(int skill, const char *name, bool gain)
+{
+	struct ability *ability = lookup_ability(skill, name);
+
+	if (gain) {
+		add_ability(&player->abilities, ability);
+		locate_ability(player->abilities, ability)->active = true;
+	} else {
+		remove_ability(&player->abilities, ability);
+	}
+	player->upkeep->update |= (PU_ABILITIES);
+}
+
+static int test_health(void *state) {
+	int chp = player->chp;
+	int str, gra;
+
+	player->chp = player->mhp;
+	require(state_matches_scratch(player));
+	str = player->state.stat_misc_mod[STAT_STR];
+	gra = player->state.stat_misc_mod[STAT_GRA];
+
+	/* Without the ability, being hurt makes no difference */
+	player->chp = player->mhp / 5;
+	require(state_matches_scratch(player));
+	eq(player->state.stat_misc_mod[STAT_STR], str);
+
+	/* With it, strength and grace go up as health crosses each threshold */
+	set_ability(SKILL_WILL, "Strength in Adversity", true);
+	player->chp = player->mhp;
+	require(state_matches_scratch(player));
+	require(player_active_ability(player, PA_STRENGTH_IN_ADVERSITY));
+	eq(player->state.stat_misc_mod[STAT_STR], str);
+	eq(player->state.stat_misc_mod[STAT_GRA], gra);
+	player->chp = player->mhp / 2;
+	require(health_level(player->chp, player->mhp) == HEALTH_BADLY_WOUNDED);
+	require(state_matches_scratch(player));
+	eq(player->state.stat_misc_mod[STAT_STR], str + 1);
+	eq(player->state.stat_misc_mod[STAT_GRA], gra + 1);
+	player->chp = player->mhp / 5;
+	require(health_level(player->chp, player->mhp) == HEALTH_ALMOST_DEAD);
+	require(state_matches_scratch(player));
+	eq(player->state.stat_misc_mod[STAT_STR], str + 2);
+	eq(player->state.stat_misc_mod[STAT_GRA], gra + 2);
+	player->chp = player->mhp;
+	require(state_matches_scratch(player));
+	eq(player->state.stat_misc_mod[STAT_STR], str);
+
+	set_ability(SKILL_WILL, "Strength in Adversity", false);
+	player->chp = chp;
+	require(state_matches_scratch(player));
+	ok;
+}
+
+static int test_abilities(void *state) {
+	int str, conf;
+
+	require(state_matches_scratch(player));
+	str = player->state.stat_misc_mod[STAT_STR];
+	conf = player->state.flags[OF_PROT_CONF];
+
+	/* Learning an ability rebuilds the cached abilities layer */
+	set_ability(SKILL_MELEE, "Strength", true);
+	require(state_matches_scratch(player));
+	eq(player->state.stat_misc_mod[STAT_STR], str + 1);
+	set_ability(SKILL_WILL, "Clarity", true);
+	require(state_matches_scratch(player));
+	eq(player->state.flags[OF_PROT_CONF], conf + 1);
+
+	/* And so does forgetting one */
+	set_ability(SKILL_MELEE, "Strength", false);
+	require(state_matches_scratch(player));
+	eq(player->state.stat_misc_mod[STAT_STR], str);
+	eq(player->state.flags[OF_PROT_CONF], conf + 1);
+	set_ability(SKILL_WILL, "Clarity", false);
+	require(state_matches_scratch(player));
+	eq(player->state.flags[OF_PROT_CONF], conf);
+	ok;
+}
+
+const char *suite_name = "player/calc-bonuses";
+struct test tests[] = {
+	{ "timed", test_timed },
+	{ "equipment", test_equipment },
+	{ "songs", test_songs },
+	{ "health", test_health },
+	{ "abilities", test_abilities },
+	{ NULL, NULL }
+};
@@ -0,0 +1,276 @@
+/* player/combat-odds */
+/* Check the exact combat odds against the rolls they describe. */
+
+#include "unit-test.h"
+#include "test-utils.h"
+#include <math.h>
+#include "combat.h"
+#include "game-world.h"
+#include "generate.h"
+#include "init.h"
+#include "mon-make.h"
+#include "obj-gear.h"
+#include "obj-knowledge.h"
+#include "obj-make.h"
+#include "obj-pile.h"
+#include "obj-util.h"
+#include "mon-util.h"
+#include "monster.h"
+#include "player-birth.h"
+#include "player-calcs.h"
+#include "project.h"
+#include "source.h"
+#include "z-rand.h"
+
+#define SAMPLES 200000
+
+int setup_tests(void **state) {
+	set_file_paths();
+	init_angband();
+#ifdef UNIX
+	/* Necessary for creating the randart file. */
+	create_needed_dirs();
+#endif
+	if (!player_make_simple(NULL, NULL, NULL, "Tester")) {
+		cleanup_angband();
+		return 1;
+	}
+	prepare_next_level(player);
+	on_new_level();
+	Rand_init();
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	wipe_mon_list(cave, player);
+	cleanup_angband();
+	return 0;
+}
+
+/**
+ * Tally of sampled values, over the same range as some odds
+ */
+struct tally {
+	const struct combat_odds *odds;
+	int *counts;
+	int n;
+	double sum;
+	bool outside;
+};
+
+static void tally_init(struct tally *t, const struct combat_odds *odds)
+{
+	t->odds = odds;
+	t->counts = mem_zalloc(odds->count * sizeof(int));
+	t->n = 0;
+	t->sum = 0.0;
+	t->outside = false;
+}
+
+static void tally_add(struct tally *t, int value)
+{
+	int i = value - t->odds->min;
+
+	if ((i < 0) || (i >= t->odds->count)) {
+		t->outside = true;
+	} else {
+		t->counts[i]++;
+	}
+	t->n++;
+	t->sum += value;
+}
+
+/**
+ * Check the sampled frequencies and mean are within a few standard errors
+ * of the exact ones, and free the tally
+ */
+static bool tally_matches(struct tally *t)
+{
+	double mean = odds_mean(t->odds), total = 0.0, sq = 0.0;
+	bool same = !t->outside;
+	int i;
+
+	for (i = 0; i < t->odds->count; i++) {
+		double p = t->odds->p[i], freq = (double) t->counts[i] / t->n;
+		double sd = sqrt(p * (1.0 - p) / t->n);
+
+		if (ABS(freq - p) > 5.0 * sd + 1e-9) same = false;
+		total += p;
+		sq += (t->odds->min + i - mean) * (t->odds->min + i - mean) * p;
+	}
+	if (ABS(total - 1.0) > 1e-9) same = false;
+	if (ABS(t->sum / t->n - mean) > 5.0 * sqrt(sq / t->n) + 1e-9) {
+		same = false;
+	}
+	mem_free(t->counts);
+	return same;
+}
+
+static int test_dice(void *state) {
+	struct combat_odds *odds = odds_dice(3, 6);
+	struct tally t;
+	int i;
+
+	/* Exact values */
+	eq(odds->min, 3);
+	require(ABS(odds_chance(odds, 3) - 1.0 / 216) < 1e-12);
+	require(ABS(odds_chance(odds, 10) - 27.0 / 216) < 1e-12);
+	require(ABS(odds_mean(odds) - 10.5) < 1e-9);
+	require(odds_chance(odds, 2) == 0.0);
+
+	tally_init(&t, odds);
+	for (i = 0; i < SAMPLES; i++) tally_add(&t, damroll(3, 6));
+	require(tally_matches(&t));
+	odds_free(odds);
+
+	/* No sides, no damage */
+	odds = odds_dice(4, 0);
+	eq(odds->count, 1);
+	require(odds_chance(odds, 0) == 1.0);
+	odds_free(odds);
+	ok;
+}
+
+static int test_rolls(void *state) {
+	struct combat_odds *odds;
+	struct tally t;
+	int i;
+
+	/* Skill checks, fair and cursed */
+	player->cursed = false;
+	odds = skill_check_odds(7, 3, false, false);
+	tally_init(&t, odds);
+	for (i = 0; i < SAMPLES; i++) {
+		tally_add(&t, skill_check(source_none(), 7, 3, source_none()));
+	}
+	require(tally_matches(&t));
+	odds_free(odds);
+
+	player->cursed = true;
+	odds = skill_check_odds(4, 6, false, true);
+	tally_init(&t, odds);
+	for (i = 0; i < SAMPLES; i++) {
+		tally_add(&t, skill_check(source_none(), 4, 6, source_player()));
+	}
+	require(tally_matches(&t));
+	odds_free(odds);
+
+	/* Hit rolls */
+	odds = hit_roll_odds(12, 5, true, false);
+	tally_init(&t, odds);
+	for (i = 0; i < SAMPLES; i++) {
+		tally_add(&t, hit_roll(12, 5, source_player(), source_none(), false));
+	}
+	require(tally_matches(&t));
+	odds_free(odds);
+
+	player->cursed = false;
+	odds = hit_roll_odds(3, 9, false, false);
+	tally_init(&t, odds);
+	for (i = 0; i < SAMPLES; i++) {
+		tally_add(&t, hit_roll(3, 9, source_player(), source_none(), false));
+	}
+	require(tally_matches(&t));
+	require(ABS(odds_chance_above(odds, 0) - 91.0 / 400) < 1e-9);
+	odds_free(odds);
+	ok;
+}
+
+/**
+ * Make an object of the given kind and have the player wear it
+ */
+static bool wear(int tval, const char *name)
+{
+	struct object_kind *kind = lookup_kind(tval, lookup_sval(tval, name));
+	struct object *obj;
+
+	if (!kind) return false;
+	obj = object_new();
+	object_prep(obj, kind, 0, RANDOMISE);
+	obj->known = object_new();
+	object_set_base_known(player, obj);
+	gear_insert_end(player, obj);
+	inven_wield(obj, wield_slot(obj));
+	return object_is_equipped(player->body, obj);
+}
+
+static int test_protection(void *state) {
+	struct combat_odds *odds;
+	struct tally t;
+	int i;
+
+	/* Body armour and a shield, for two sets of protection dice */
+	require(wear(TV_SOFT_ARMOR, "Leather Armour"));
+	require(wear(TV_SHIELD, "Round Shield"));
+	odds = protection_odds(player, PROJ_HURT, true);
+	require(odds->count > 4);
+
+	tally_init(&t, odds);
+	for (i = 0; i < SAMPLES; i++) {
+		tally_add(&t, protection_roll(player, PROJ_HURT, true, RANDOMISE));
+	}
+	require(tally_matches(&t));
+	odds_free(odds);
+	ok;
+}
+
+/**
+ * One blow as player-attack.c rolls it
+ */
+static int roll_blow(const struct blow_roll *blow)
+{
+	int hit = hit_roll(blow->att, blow->evn, source_player(), source_none(),
+		false);
+	int dice, dam, prt;
+
+	if (hit <= 0) return 0;
+	dice = crit_bonus(player, hit, blow->weight, blow->race,
+		blow->skill_type, blow->thrown);
+	dam = damroll(blow->dice + dice, blow->sides);
+	prt = damroll(blow->race->pd, blow->race->ps);
+	prt = (prt * blow->prt_percent) / 100;
+	return MAX(dam - prt, 0);
+}
+
+static int test_blow(void *state) {
+	struct monster_race *race = lookup_monster("Orc archer");
+	struct combat_odds *prt = odds_dice(race->pd, race->ps);
+	struct blow_roll blow = {
+		15, race->evn, false, false, 2, 5, true, 30, race, SKILL_MELEE,
+		false, prt, 100
+	};
+	struct combat_odds *odds;
+	struct tally t;
+	double hit, crit;
+	int i;
+
+	player->cursed = false;
+	odds = blow_odds(player, &blow, &hit, &crit);
+	require(hit > 0.0 && hit < 1.0);
+	require(crit > 0.0 && crit < hit);
+	tally_init(&t, odds);
+	for (i = 0; i < SAMPLES; i++) tally_add(&t, roll_blow(&blow));
+	require(tally_matches(&t));
+	odds_free(odds);
+
+	/* Half protection, as with sharpness */
+	blow.prt_percent = 50;
+	blow.att = 2;
+	odds = blow_odds(player, &blow, NULL, NULL);
+	tally_init(&t, odds);
+	for (i = 0; i < SAMPLES; i++) tally_add(&t, roll_blow(&blow));
+	require(tally_matches(&t));
+	odds_free(odds);
+
+	odds_free(prt);
+	ok;
+}
+
+const char *suite_name = "player/combat-odds";
+struct test tests[] = {
+	{ "dice", test_dice },
+	{ "rolls", test_rolls },
+	{ "protection", test_protection },
+	{ "blow", test_blow },
+	{ NULL, NULL }
+};
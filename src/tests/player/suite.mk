@@ -1,5 +1,7 @@
 TESTPROGS += player/birth \
+             player/calc-bonuses \
              player/calc-inventory \
+             player/combat-odds \
              player/combine-pack \
              player/history \
              player/inven-carry-num \
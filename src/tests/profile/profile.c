@@ -0,0 +1,84 @@
+/* profile/profile.c */
+
+#include "unit-test.h"
+#include "profile.h"
+#include "z-file.h"
+#include "z-util.h"
+
+#define TEST_FILE "profile-test.csv"
+
+NOSETUP
+
+int teardown_tests(void *state) {
+	file_delete(TEST_FILE);
+	return 0;
+}
+
+static int test_nesting(void *state) {
+	profile_reset();
+	profile_start(PROF_update_flow);
+	profile_start(PROF_update_flow);
+	eq(profile_counters[PROF_update_flow].depth, 2);
+	profile_stop(PROF_update_flow);
+	eq(profile_counters[PROF_update_flow].depth, 1);
+	profile_stop(PROF_update_flow);
+	eq(profile_counters[PROF_update_flow].depth, 0);
+	eq(profile_counters[PROF_update_flow].calls, 2);
+	eq(profile_counters[PROF_update_view].calls, 0);
+
+	/* A stray stop is ignored */
+	profile_stop(PROF_update_view);
+	eq(profile_counters[PROF_update_view].depth, 0);
+	ok;
+}
+
+static int test_reset(void *state) {
+	profile_start(PROF_project);
+	profile_stop(PROF_project);
+	require(profile_counters[PROF_project].calls > 0);
+	profile_reset();
+	eq(profile_counters[PROF_project].calls, 0);
+	require(profile_counters[PROF_project].nsec == 0);
+	ok;
+}
+
+static int test_names(void *state) {
+	require(streq(profile_region_name(PROF_update_flow), "update_flow"));
+	require(streq(profile_region_name(PROF_term_fresh), "term_fresh"));
+	require(profile_region_desc(PROF_MAX - 1) != NULL);
+	ok;
+}
+
+static int test_dump_csv(void *state) {
+	char buf[256];
+	ang_file *f;
+	int lines = 0;
+
+	profile_reset();
+	profile_start(PROF_calc_bonuses);
+	profile_stop(PROF_calc_bonuses);
+	require(profile_dump_csv(TEST_FILE));
+
+	f = file_open(TEST_FILE, MODE_READ, -1);
+	require(f);
+	require(file_getl(f, buf, sizeof(buf)));
+	require(streq(buf, "region,description,calls,total_ms,us_per_call"));
+	while (file_getl(f, buf, sizeof(buf))) {
+		if (prefix(buf, "calc_bonuses,")) {
+			require(strstr(buf, "\",1,") != NULL);
+		}
+		lines++;
+	}
+	require(file_close(f));
+	eq(lines, PROF_MAX);
+	ok;
+}
+
+const char *suite_name = "profile/profile";
+struct test tests[] = {
+	{ "nesting", test_nesting },
+	{ "reset", test_reset },
+	{ "names", test_names },
+	{ "dump_csv", test_dump_csv },
+	{ NULL, NULL }
+};
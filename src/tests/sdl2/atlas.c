@@ -0,0 +1,212 @@
+/* sdl2/atlas */
+/* Exercise the SDL2 front end's glyph atlas on SDL's dummy video driver. */
+
+#include "unit-test.h"
+#include "test-utils.h"
+
+#ifdef USE_SDL2
+
+/* The atlas and everything around it is static to the front end. */
+#include "../../main-sdl2.c"
+
+static struct window test_window;
+static struct font *test_font;
+static SDL_Texture *test_target;
+
+int setup_tests(void **state) {
+	SDL_RendererInfo info;
+
+	SDL_setenv("SDL_VIDEODRIVER", "dummy", 1);
+	init_systems();
+
+	set_file_paths();
+	init_font_info(ANGBAND_DIR_FONTS);
+
+	test_window.window = SDL_CreateWindow("atlas", 0, 0, 640, 480, 0);
+	if (test_window.window == NULL) {
+		return 1;
+	}
+	test_window.renderer = SDL_CreateRenderer(test_window.window, -1,
+		SDL_RENDERER_SOFTWARE | SDL_RENDERER_TARGETTEXTURE);
+	if (test_window.renderer == NULL
+			|| SDL_GetRendererInfo(test_window.renderer, &info) != 0
+			|| !choose_pixelformat(&test_window, &info)) {
+		return 1;
+	}
+
+	test_font = make_font(&test_window, DEFAULT_FONT, 0);
+	if (test_font == NULL) {
+		return 1;
+	}
+	test_target = make_subwindow_texture(&test_window,
+		test_font->ttf.glyph.w, test_font->ttf.glyph.h);
+
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	if (test_target != NULL) {
+		SDL_DestroyTexture(test_target);
+	}
+	if (test_font != NULL) {
+		free_font(test_font);
+	}
+	if (test_window.renderer != NULL) {
+		SDL_DestroyRenderer(test_window.renderer);
+	}
+	if (test_window.window != NULL) {
+		SDL_DestroyWindow(test_window.window);
+	}
+	for (size_t i = 0; i < N_ELEMENTS(g_font_info); i++) {
+		free_font_info(&g_font_info[i]);
+	}
+	quit_systems();
+	return 0;
+}
+
+/* Draw a glyph the way the term drawing code does */
+static void draw_glyph(uint32_t codepoint)
+{
+	SDL_Color fg = {0xFF, 0xFF, 0xFF, 0xFF};
+
+	SDL_SetRenderTarget(test_window.renderer, test_target);
+	render_glyph_mono(&test_window, test_font, test_target, 0, 0, &fg,
+		codepoint);
+}
+
+/* Return the slot holding a codepoint, or -1 if it isn't in the atlas */
+static int find_slot(uint32_t codepoint)
+{
+	const struct glyph_atlas *atlas = &test_font->cache.atlas;
+	int i = atlas->buckets[codepoint % GLYPH_ATLAS_BUCKETS];
+	int steps = 0;
+
+	while (i != 0 && steps++ < GLYPH_ATLAS_SLOTS) {
+		if (atlas->slots[i - 1].codepoint == codepoint) {
+			return i - 1;
+		}
+		i = atlas->slots[i - 1].next;
+	}
+	return -1;
+}
+
+/* Check that every slot in use is on its own bucket's chain exactly once */
+static bool chains_are_sound(void)
+{
+	const struct glyph_atlas *atlas = &test_font->cache.atlas;
+	bool seen[GLYPH_ATLAS_SLOTS] = { false };
+	int count = 0;
+
+	for (int b = 0; b < GLYPH_ATLAS_BUCKETS; b++) {
+		for (int i = atlas->buckets[b]; i != 0; i = atlas->slots[i - 1].next) {
+			if (i < 0 || i > atlas->used || seen[i - 1]) return false;
+			if (atlas->slots[i - 1].codepoint % GLYPH_ATLAS_BUCKETS
+					!= (uint32_t) b) return false;
+			seen[i - 1] = true;
+			count++;
+		}
+	}
+	return count == atlas->used;
+}
+
+/* Copy the pixels of part of the atlas texture */
+static void read_atlas(const SDL_Rect *rect, Uint32 *pixels)
+{
+	SDL_SetRenderTarget(test_window.renderer, test_font->cache.atlas.texture);
+	SDL_RenderReadPixels(test_window.renderer, rect, test_window.pixelformat,
+		pixels, rect->w * (int) sizeof(*pixels));
+}
+
+static int test_batching(void *state) {
+	const char *hint = SDL_GetHint(SDL_HINT_RENDER_BATCHING);
+
+	require(hint != NULL && streq(hint, "1"));
+	ok;
+}
+
+static int test_eviction(void *state) {
+	struct glyph_atlas *atlas = &test_font->cache.atlas;
+	size_t n = (size_t) test_font->ttf.glyph.w * test_font->ttf.glyph.h;
+	Uint32 *before = mem_zalloc(n * sizeof(*before));
+	Uint32 *after = mem_zalloc(n * sizeof(*after));
+	/* e with acute accent, drawn first so it is the first to go */
+	const uint32_t first = 0xE9;
+	SDL_Rect unused = { 0, 0, test_font->ttf.glyph.w, test_font->ttf.glyph.h };
+	bool inked = false;
+	int i;
+
+	draw_glyph(first);
+	i = find_slot(first);
+	require(i >= 0);
+	require(!atlas->slots[i].blank);
+	read_atlas(&atlas->slots[i].rect, before);
+
+	/* Make sure there was something to see, by comparing with a slot
+	 * that hasn't been handed out yet */
+	require(atlas->used < GLYPH_ATLAS_SLOTS);
+	unused.x = (atlas->used % GLYPH_ATLAS_COLS) * unused.w;
+	unused.y = (atlas->used / GLYPH_ATLAS_COLS) * unused.h;
+	read_atlas(&unused, after);
+	for (size_t j = 0; j < n; j++) {
+		if (before[j] != after[j]) inked = true;
+	}
+	require(inked);
+
+	/* Fill every slot with something else, then one more */
+	for (uint32_t c = 0x100; c <= 0x100 + GLYPH_ATLAS_SLOTS; c++) {
+		draw_glyph(c);
+		require(chains_are_sound());
+	}
+	eq(atlas->used, GLYPH_ATLAS_SLOTS);
+	eq(find_slot(first), -1);
+	eq(find_slot(0x100), -1);
+	require(find_slot(0x100 + GLYPH_ATLAS_SLOTS) >= 0);
+
+	/* Drawing it again renders it into whichever slot was oldest */
+	draw_glyph(first);
+	require(chains_are_sound());
+	i = find_slot(first);
+	require(i >= 0);
+	require(!atlas->slots[i].blank);
+	eq(find_slot(0x101), -1);
+	read_atlas(&atlas->slots[i].rect, after);
+	for (size_t j = 0; j < n; j++) {
+		eq(after[j], before[j]);
+	}
+
+	mem_free(before);
+	mem_free(after);
+	ok;
+}
+
+static int test_blank(void *state) {
+	struct glyph_atlas *atlas = &test_font->cache.atlas;
+
+	require(get_atlas_glyph(&test_window, test_font, test_target, 0) == NULL);
+	require(find_slot(0) >= 0);
+	require(atlas->slots[find_slot(0)].blank);
+	/* Found in the atlas this time */
+	require(get_atlas_glyph(&test_window, test_font, test_target, 0) == NULL);
+	require(chains_are_sound());
+	ok;
+}
+
+const char *suite_name = "sdl2/atlas";
+struct test tests[] = {
+	{ "batching", test_batching },
+	{ "eviction", test_eviction },
+	{ "blank", test_blank },
+	{ NULL, NULL }
+};
+
+#else /* USE_SDL2 */
+
+NOSETUP
+NOTEARDOWN
+
+const char *suite_name = "sdl2/atlas";
+struct test tests[] = {
+	{ NULL, NULL }
+};
+
+#endif /* USE_SDL2 */
@@ -0,0 +1 @@
+TESTPROGS += sdl2/atlas
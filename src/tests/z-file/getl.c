@@ -0,0 +1,221 @@
+/* z-file/getl.c */
+
+#include "unit-test.h"
+#include "z-file.h"
+#include "z-rand.h"
+#include "z-virt.h"
+
+#define TEST_FILE "getl-test.txt"
+
+int setup_tests(void **state) {
+	Rand_init();
+	return 0;
+}
+
+int teardown_tests(void *state) {
+	file_delete(TEST_FILE);
+	return 0;
+}
+
+static bool write_test_file(const char *contents, size_t n)
+{
+	ang_file *f = file_open(TEST_FILE, MODE_WRITE, FTYPE_TEXT);
+	bool result;
+
+	if (!f) return false;
+	result = file_write(f, contents, n);
+	return file_close(f) && result;
+}
+
+/**
+ * The original character at a time line reader, used as the reference for
+ * what file_getl() should return.
+ */
+static bool reference_getl(FILE *fh, char *buf, size_t len)
+{
+	bool seen_cr = false;
+	size_t i = 0;
+	size_t max_len = len - 1;
+
+	while (i < max_len) {
+		int c = fgetc(fh);
+
+		if (c == EOF) {
+			buf[i] = '\0';
+			return (i == 0) ? false : true;
+		}
+		if (c == '\r') {
+			seen_cr = true;
+			continue;
+		}
+		if (seen_cr && c != '\n') {
+			ungetc(c, fh);
+			buf[i] = '\0';
+			return true;
+		}
+		if (c == '\n') {
+			buf[i] = '\0';
+			return true;
+		}
+		if (c == '\t') {
+			size_t tabstop = ((i + 4) / 4) * 4;
+			if (tabstop >= len) break;
+			while (i < tabstop)
+				buf[i++] = ' ';
+			continue;
+		}
+		buf[i++] = (char) c;
+	}
+
+	buf[i] = '\0';
+	return true;
+}
+
+/**
+ * Check that file_getl() with a buffer of 'len' bytes splits 'contents'
+ * into the same lines as the reference reader.
+ */
+static bool matches_reference(const char *contents, size_t n, size_t len)
+{
+	char *buf1 = mem_alloc(len), *buf2 = mem_alloc(len);
+	ang_file *f;
+	FILE *fh;
+	bool same = true;
+
+	if (!write_test_file(contents, n)) return false;
+	f = file_open(TEST_FILE, MODE_READ, -1);
+	fh = fopen(TEST_FILE, "rb");
+	if (!f || !fh) same = false;
+
+	while (same) {
+		bool r1 = file_getl(f, buf1, len);
+		bool r2 = reference_getl(fh, buf2, len);
+
+		if (r1 != r2 || (r1 && !streq(buf1, buf2))) same = false;
+		if (!r1 || !r2) break;
+	}
+
+	if (f) file_close(f);
+	if (fh) fclose(fh);
+	mem_free(buf2);
+	mem_free(buf1);
+	return same;
+}
+
+static int test_line_endings(void *state) {
+	const char text[] = "one\ntwo\r\nthree\rfour\r\r\nfive";
+	char buf[80];
+	ang_file *f;
+
+	require(write_test_file(text, sizeof(text) - 1));
+	f = file_open(TEST_FILE, MODE_READ, -1);
+	require(f);
+	require(file_getl(f, buf, sizeof(buf)) && streq(buf, "one"));
+	require(file_getl(f, buf, sizeof(buf)) && streq(buf, "two"));
+	require(file_getl(f, buf, sizeof(buf)) && streq(buf, "three"));
+	require(file_getl(f, buf, sizeof(buf)) && streq(buf, "four"));
+	require(file_getl(f, buf, sizeof(buf)) && streq(buf, "five"));
+	require(!file_getl(f, buf, sizeof(buf)));
+	require(file_close(f));
+	ok;
+}
+
+static int test_tabs(void *state) {
+	const char text[] = "\ta\tbc\tdefg\thijkl\n\t\t\tx\n";
+	char buf[80], small[8];
+	ang_file *f;
+
+	require(write_test_file(text, sizeof(text) - 1));
+	f = file_open(TEST_FILE, MODE_READ, -1);
+	require(f);
+	require(file_getl(f, buf, sizeof(buf)));
+	require(streq(buf, "    a   bc  defg    hijkl"));
+	/* A tab that would overflow the buffer is dropped and the line split */
+	require(file_getl(f, small, sizeof(small)) && streq(small, "    "));
+	require(file_getl(f, small, sizeof(small)) && streq(small, "    x"));
+	require(!file_getl(f, buf, sizeof(buf)));
+	require(file_close(f));
+	ok;
+}
+
+static int test_long_lines(void *state) {
+	const char text[] = "abcdefghij\nk\n";
+	char buf[5];
+	ang_file *f;
+
+	require(write_test_file(text, sizeof(text) - 1));
+	f = file_open(TEST_FILE, MODE_READ, -1);
+	require(f);
+	require(file_getl(f, buf, sizeof(buf)) && streq(buf, "abcd"));
+	require(file_getl(f, buf, sizeof(buf)) && streq(buf, "efgh"));
+	require(file_getl(f, buf, sizeof(buf)) && streq(buf, "ij"));
+	require(file_getl(f, buf, sizeof(buf)) && streq(buf, "k"));
+	require(!file_getl(f, buf, sizeof(buf)));
+	require(file_close(f));
+	ok;
+}
+
+static int test_mixed_io(void *state) {
+	const char text[] = "first\nXYZsecond\nthird\n";
+	char buf[80], raw[3];
+	uint8_t b;
+	ang_file *f;
+
+	require(write_test_file(text, sizeof(text) - 1));
+	f = file_open(TEST_FILE, MODE_READ, -1);
+	require(f);
+	require(file_getl(f, buf, sizeof(buf)) && streq(buf, "first"));
+	eq(file_read(f, raw, sizeof(raw)), 3);
+	require(raw[0] == 'X' && raw[1] == 'Y' && raw[2] == 'Z');
+	require(file_skip(f, -2));
+	require(file_readc(f, &b));
+	eq(b, 'Y');
+	require(file_skip(f, 1));
+	require(file_getl(f, buf, sizeof(buf)) && streq(buf, "second"));
+	require(file_getl(f, buf, sizeof(buf)) && streq(buf, "third"));
+	require(!file_getl(f, buf, sizeof(buf)));
+	require(file_close(f));
+	ok;
+}
+
+static int test_reference(void *state) {
+	const char alphabet[] = "ab \t\t\r\n\n\r";
+	size_t lens[] = { 2, 3, 5, 8, 13, 64, 1024 };
+	size_t n = 40000, i, j;
+	char *text = mem_alloc(n);
+
+	/* Random text much larger than the read-ahead buffer */
+	for (i = 0; i < n; i++) {
+		text[i] = alphabet[randint0(sizeof(alphabet) - 1)];
+	}
+	for (j = 0; j < N_ELEMENTS(lens); j++) {
+		if (!matches_reference(text, n, lens[j])) {
+			mem_free(text);
+			require(false);
+		}
+	}
+
+	/* Long runs of ordinary characters with occasional line breaks */
+	for (i = 0; i < n; i++) {
+		text[i] = one_in_(200) ? '\n' : (one_in_(500) ? '\r' : 'x');
+	}
+	for (j = 0; j < N_ELEMENTS(lens); j++) {
+		if (!matches_reference(text, n, lens[j])) {
+			mem_free(text);
+			require(false);
+		}
+	}
+
+	mem_free(text);
+	ok;
+}
+
+const char *suite_name = "z-file/getl";
+struct test tests[] = {
+	{ "line_endings", test_line_endings },
+	{ "tabs", test_tabs },
+	{ "long_lines", test_long_lines },
+	{ "mixed_io", test_mixed_io },
+	{ "reference", test_reference },
+	{ NULL, NULL }
+};
@@ -237,6 +237,49 @@ static int test_strunescape(void *state) {
 	ok;
 }
 
+static int int_compare(const void *a, const void *b) {
+	return *(const int *)a - *(const int *)b;
+}
+
+static int pair_compare(const void *a, const void *b) {
+	return ((const int *)a)[0] - ((const int *)b)[0];
+}
+
+static int test_sort_insertion(void *state) {
+	int sorted[] = { 1, 2, 3, 5, 8, 13 };
+	int shuffled[] = { 9, 3, 7, 1, 0, 8, 2, 6, 4, 5 };
+	int moved[] = { 1, 2, 13, 3, 5, 8, 0 };
+	/* Pairs of key and original position */
+	int pairs[][2] = { { 2, 0 }, { 1, 1 }, { 2, 2 }, { 1, 3 }, { 0, 4 } };
+	int i;
+
+	sort_insertion(sorted, N_ELEMENTS(sorted), sizeof(int), int_compare);
+	eq(sorted[0], 1);
+	eq(sorted[5], 13);
+
+	sort_insertion(shuffled, N_ELEMENTS(shuffled), sizeof(int),
+		int_compare);
+	for (i = 0; i < (int)N_ELEMENTS(shuffled); i++) {
+		eq(shuffled[i], i);
+	}
+
+	sort_insertion(moved, N_ELEMENTS(moved), sizeof(int), int_compare);
+	for (i = 1; i < (int)N_ELEMENTS(moved); i++) {
+		require(moved[i - 1] <= moved[i]);
+	}
+	eq(moved[0], 0);
+	eq(moved[6], 13);
+
+	/* Equal elements keep their order */
+	sort_insertion(pairs, N_ELEMENTS(pairs), sizeof(pairs[0]), pair_compare);
+	eq(pairs[0][1], 4);
+	eq(pairs[1][1], 1);
+	eq(pairs[2][1], 3);
+	eq(pairs[3][1], 0);
+	eq(pairs[4][1], 2);
+	ok;
+}
+
 const char *suite_name = "z-util/util";
 struct test tests[] = {
 	{ "utf8_clipto", test_alloc },
@@ -245,5 +288,6 @@ struct test tests[] = {
 	{ "utf32_to_utf8", test_utf32_to_utf8 },
 	{ "hex_str_to_int", test_hex_str_to_int },
 	{ "strunescape", test_strunescape },
+	{ "sort_insertion", test_sort_insertion },
 	{ NULL, NULL }
 };
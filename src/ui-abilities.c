@@ -19,6 +19,7 @@
 #include "angband.h"
 #include "monster.h"
 #include "player-abilities.h"
+#include "player-calcs.h"
 #include "player-util.h"
 #include "ui-abilities.h"
 #include "ui-input.h"
@@ -191,6 +192,7 @@ static bool ability_action(struct menu *m, const ui_event *event, int oid)
 				possessed->active = true;
 				put_str("Ability now switched on.", 0, 0);
 			}
+			player->upkeep->update |= (PU_BONUS | PU_ABILITIES);
 		} else if (player_has_prereq_abilities(player, choice[oid]) && points) {
 			if (player_can_gain_ability(player, choice[oid])) {
 				if (streq(choice[oid]->name, "Bane")) {
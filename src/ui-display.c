@@ -273,7 +273,7 @@ static void prt_mel(int row, int col)
 			player->state.mdd, player->state.mds);
 	put_str(format("%12s", buf), row + mod, col);
 
-	if (player_active_ability(player, "Rapid Attack")) {
+	if (player_active_ability(player, PA_RAPID_ATTACK)) {
 		put_str("2x", row + mod, col);
 	}
 
@@ -302,7 +302,7 @@ static void prt_arc(int row, int col)
 				player->state.add, player->state.ads);
 		c_put_str(COLOUR_UMBER, format("%12s", buf), row, col);
 
-		if (player_active_ability(player, "Rapid Fire")) {
+		if (player_active_ability(player, PA_RAPID_FIRE)) {
 			c_put_str(COLOUR_UMBER, "2x", row, col);
 			//} else {
 			//strnfmt(buf, sizeof(buf), "            ");
@@ -1084,71 +1084,95 @@ static void trace_map_updates(game_event_type type, game_event_data *data,
 	if (data->point.x == -1 && data->point.y == -1)
 		printf("Redraw whole map\n");
 	else
-		printf("Redraw (%i, %i)\n", data->point.x, data->point.y);
+		printf("Redraw (%i, %i) to (%i, %i)\n",
+			data->region.top_left.x, data->region.top_left.y,
+			data->region.bottom_right.x, data->region.bottom_right.y);
 }
 #endif
 
 /**
- * Update either a single map grid or a whole map
+ * Redraw a single map grid, if it is on the panel shown in the term
  */
-static void update_maps(game_event_type type, game_event_data *data, void *user)
+static void update_map_grid(term *t, struct loc grid)
 {
-	term *t = user;
+	struct grid_data g;
+	int a, ta;
+	wchar_t c, tc;
 
-	/* This signals a whole-map redraw. */
-	if (data->point.x == -1 && data->point.y == -1)
-		prt_map();
+	int ky, kx;
+	int vy, vx;
+	int clipy;
 
-	/* Single point to be redrawn */
-	else {
-		struct grid_data g;
-		int a, ta;
-		wchar_t c, tc;
-
-		int ky, kx;
-		int vy, vx;
-		int clipy;
+	/* Location relative to panel */
+	ky = grid.y - t->offset_y;
+	kx = grid.x - t->offset_x;
 
-		/* Location relative to panel */
-		ky = data->point.y - t->offset_y;
-		kx = data->point.x - t->offset_x;
+	if (t == angband_term[0]) {
+		/* Verify location */
+		if ((ky < 0) || (ky >= SCREEN_HGT)) return;
+		if ((kx < 0) || (kx >= SCREEN_WID)) return;
 
-		if (t == angband_term[0]) {
-			/* Verify location */
-			if ((ky < 0) || (ky >= SCREEN_HGT)) return;
-			if ((kx < 0) || (kx >= SCREEN_WID)) return;
+		/* Location in window */
+		vy = tile_height * ky + ROW_MAP;
+		vx = tile_width * kx + COL_MAP;
 
-			/* Location in window */
-			vy = tile_height * ky + ROW_MAP;
-			vx = tile_width * kx + COL_MAP;
-
-			/* Protect the status line against modification. */
-			clipy = ROW_MAP + SCREEN_ROWS;
-		} else {
-			/* Verify location */
-			if ((ky < 0) || (ky >= t->hgt / tile_height)) return;
-			if ((kx < 0) || (kx >= t->wid / tile_width)) return;
+		/* Protect the status line against modification. */
+		clipy = ROW_MAP + SCREEN_ROWS;
+	} else {
+		/* Verify location */
+		if ((ky < 0) || (ky >= t->hgt / tile_height)) return;
+		if ((kx < 0) || (kx >= t->wid / tile_width)) return;
 
-			/* Location in window */
-			vy = tile_height * ky;
-			vx = tile_width * kx;
+		/* Location in window */
+		vy = tile_height * ky;
+		vx = tile_width * kx;
 
-			/* All the rows may be used for the map. */
-			clipy = t->hgt;
-		}
+		/* All the rows may be used for the map. */
+		clipy = t->hgt;
+	}
 
 
-		/* Redraw the grid spot */
-		map_info(data->point, &g);
-		grid_data_as_text(&g, &a, &c, &ta, &tc);
-		Term_queue_char(t, vx, vy, a, c, ta, tc);
+	/* Redraw the grid spot */
+	map_info(grid, &g);
+	grid_data_as_text(&g, &a, &c, &ta, &tc);
+	Term_queue_char(t, vx, vy, a, c, ta, tc);
 #ifdef MAP_DEBUG
-		/* Plot 'spot' updates in light green to make them visible */
-		Term_queue_char(t, vx, vy, COLOUR_L_GREEN, c, ta, tc);
+	/* Plot 'spot' updates in light green to make them visible */
+	Term_queue_char(t, vx, vy, COLOUR_L_GREEN, c, ta, tc);
 #endif
 
-		if ((tile_width > 1) || (tile_height > 1))
-			Term_big_queue_char(t, vx, vy, clipy, a, c, COLOUR_WHITE, L' ');
+	if ((tile_width > 1) || (tile_height > 1))
+		Term_big_queue_char(t, vx, vy, clipy, a, c, COLOUR_WHITE, L' ');
+}
+
+/**
+ * Update either a block of map grids or a whole map
+ */
+static void update_maps(game_event_type type, game_event_data *data, void *user)
+{
+	term *t = user;
+
+	/* This signals a whole-map redraw. */
+	if (data->point.x == -1 && data->point.y == -1)
+		prt_map();
+
+	/* Block of grids to be redrawn, clipped to the panel */
+	else {
+		struct loc grid;
+		int panel_hgt = (t == angband_term[0]) ? SCREEN_HGT :
+			t->hgt / tile_height;
+		int panel_wid = (t == angband_term[0]) ? SCREEN_WID :
+			t->wid / tile_width;
+		int y0 = MAX(data->region.top_left.y, t->offset_y);
+		int y1 = MIN(data->region.bottom_right.y, t->offset_y + panel_hgt - 1);
+		int x0 = MAX(data->region.top_left.x, t->offset_x);
+		int x1 = MIN(data->region.bottom_right.x, t->offset_x + panel_wid - 1);
+
+		for (grid.y = y0; grid.y <= y1; grid.y++) {
+			for (grid.x = x0; grid.x <= x1; grid.x++) {
+				update_map_grid(t, grid);
+			}
+		}
 	}
 
 	/* Refresh the main screen unless the map needs to center */
@@ -1300,6 +1324,167 @@ static void bolt_pict(int y, int x, int ny, int nx, int typ, uint8_t *a,
 	}
 }
 
+/**
+ * ------------------------------------------------------------------------
+ * Animation queue
+ *
+ * Bolts, missiles, explosions and hits are recorded here as they happen, and
+ * played back the next time the game waits for a key, so the game never
+ * waits for them itself.  Effects recorded between two waits are played
+ * together, each starting from the first frame, unless one directly follows
+ * on from another (like the explosion at the end of a bolt).
+ * ------------------------------------------------------------------------ */
+
+/**
+ * The most frames kept waiting to be played
+ */
+#define ANIM_FRAMES_MAX 256
+
+/**
+ * A glyph drawn over the map by an animation
+ */
+struct anim_glyph {
+	struct loc grid;
+	uint8_t a;
+	wchar_t c;
+};
+
+/**
+ * One frame: grids put back as they are on the map, then glyphs drawn over
+ * the map, then a pause to show them
+ */
+struct anim_frame {
+	struct loc *erase;
+	int n_erase, erase_size;
+	struct anim_glyph *draw;
+	int n_draw, draw_size;
+	int msec;
+};
+
+static struct anim_frame anim_frames[ANIM_FRAMES_MAX];
+static int anim_n_frames = 0;
+static int anim_step = 0;	/* Next frame of the effect being recorded */
+static game_event_type anim_last_type = EVENT_END;	/* Last recorded */
+static struct loc anim_last_grid;	/* Last grid it drew on */
+
+/**
+ * Get a frame to record into, or NULL if too many are waiting
+ */
+static struct anim_frame *anim_frame(int step)
+{
+	if (step >= ANIM_FRAMES_MAX) return NULL;
+	if (step >= anim_n_frames) anim_n_frames = step + 1;
+	return &anim_frames[step];
+}
+
+/**
+ * Record a glyph to be drawn at the given frame, held for at least msec
+ */
+static void anim_draw(int step, struct loc grid, uint8_t a, wchar_t c,
+		int msec)
+{
+	struct anim_frame *f = anim_frame(step);
+
+	if (!f) return;
+	if (f->n_draw == f->draw_size) {
+		f->draw_size = f->draw_size ? 2 * f->draw_size : 8;
+		f->draw = mem_realloc(f->draw, f->draw_size * sizeof(*f->draw));
+	}
+	f->draw[f->n_draw].grid = grid;
+	f->draw[f->n_draw].a = a;
+	f->draw[f->n_draw].c = c;
+	f->n_draw++;
+	f->msec = MAX(f->msec, msec);
+}
+
+/**
+ * Record a grid to be put back as it is on the map at the given frame
+ */
+static void anim_erase(int step, struct loc grid)
+{
+	struct anim_frame *f = anim_frame(step);
+
+	if (!f) return;
+	if (f->n_erase == f->erase_size) {
+		f->erase_size = f->erase_size ? 2 * f->erase_size : 8;
+		f->erase = mem_realloc(f->erase, f->erase_size * sizeof(*f->erase));
+	}
+	f->erase[f->n_erase++] = grid;
+}
+
+/**
+ * Forget any waiting animations, putting back what they have drawn over
+ */
+static void anim_clear(bool restore)
+{
+	int i, j;
+
+	for (i = 0; i < anim_n_frames; i++) {
+		struct anim_frame *f = &anim_frames[i];
+		if (restore) {
+			for (j = 0; j < f->n_draw; j++) {
+				event_mark_map(f->draw[j].grid);
+			}
+		}
+		f->n_erase = 0;
+		f->n_draw = 0;
+		f->msec = 0;
+	}
+	anim_n_frames = 0;
+	anim_step = 0;
+	anim_last_type = EVENT_END;
+	if (restore) {
+		event_flush_map();
+	}
+}
+
+/**
+ * Play any waiting animations.  If the player has typed ahead the rest are
+ * skipped, and everything drawn over is put back once they are done.
+ */
+void display_animations(void)
+{
+	int i, j;
+	bool skip = false;
+
+	if (!anim_n_frames) return;
+
+	for (i = 0; i < anim_n_frames && !skip; i++) {
+		struct anim_frame *f = &anim_frames[i];
+		ui_event ke;
+
+		/* Frames where nothing visible happens take no time */
+		if (!f->n_erase && !f->n_draw) continue;
+
+		/* A key waiting means the player wants to get on */
+		if (Term_inkey(&ke, false, false) == 0) {
+			skip = true;
+			break;
+		}
+
+		for (j = 0; j < f->n_erase; j++) {
+			event_mark_map(f->erase[j]);
+		}
+		event_flush_map();
+		for (j = 0; j < f->n_draw; j++) {
+			struct anim_glyph *g = &f->draw[j];
+			print_rel(g->c, g->a, g->grid.y, g->grid.x);
+			move_cursor_relative(g->grid.y, g->grid.x);
+		}
+		Term_fresh();
+		if (player->upkeep->redraw)
+			redraw_stuff(player);
+		if (f->n_draw) {
+			Term_xtra(TERM_XTRA_DELAY, f->msec);
+		}
+	}
+
+	anim_clear(true);
+	Term_fresh();
+	if (player->upkeep->redraw)
+		redraw_stuff(player);
+}
+
 /**
  * Draw an explosion
  */
@@ -1308,7 +1493,7 @@ static void display_explosion(game_event_type type, game_event_data *data,
 {
 	bool new_radius = false;
 	bool drawn = false;
-	int i, y, x;
+	int i;
 	int msec = player->opts.delay_factor;
 	int proj_type = data->explosion.proj_type;
 	int num_grids = data->explosion.num_grids;
@@ -1316,14 +1501,14 @@ static void display_explosion(game_event_type type, game_event_data *data,
 	bool drawing = data->explosion.drawing;
 	bool *player_sees_grid = data->explosion.player_sees_grid;
 	struct loc *blast_grid = data->explosion.blast_grid;
-	struct loc centre = data->explosion.centre;
+
+	/* Explosions follow on from the bolt or missile that caused them */
+	if ((anim_last_type != EVENT_BOLT) && (anim_last_type != EVENT_MISSILE)) {
+		anim_step = 0;
+	}
 
 	/* Draw the blast from inside out */
 	for (i = 0; i < num_grids; i++) {
-		/* Extract the location */
-		y = blast_grid[i].y;
-		x = blast_grid[i].x;
-
 		/* Only do visuals if the player can see the blast */
 		if (player_sees_grid[i]) {
 			uint8_t a;
@@ -1332,58 +1517,38 @@ static void display_explosion(game_event_type type, game_event_data *data,
 			drawn = true;
 
 			/* Obtain the explosion pict */
-			bolt_pict(y, x, y, x, proj_type, &a, &c);
+			bolt_pict(blast_grid[i].y, blast_grid[i].x, blast_grid[i].y,
+				blast_grid[i].x, proj_type, &a, &c);
 
 			/* Just display the pict, ignoring what was under it */
-			print_rel(c, a, y, x);
+			anim_draw(anim_step, blast_grid[i], a, c, msec);
 		}
 
-		/* Center the cursor to stop it tracking the blast grids  */
-		move_cursor_relative(centre.y, centre.x);
-
 		/* Check for new radius, taking care not to overrun array */
 		if (i == num_grids - 1)
 			new_radius = true;
 		else if (distance_to_grid[i + 1] > distance_to_grid[i])
 			new_radius = true;
 
-		/* We have all the grids at the current radius, so draw it */
+		/* We have all the grids at the current radius, so show it */
 		if (new_radius) {
-			/* Flush all the grids at this radius */
-			Term_fresh();
-			if (player->upkeep->redraw)
-				redraw_stuff(player);
-
-			/* Delay to show this radius appearing */
 			if (drawn || drawing) {
-				Term_xtra(TERM_XTRA_DELAY, msec);
+				anim_step++;
 			}
 
 			new_radius = false;
 		}
 	}
 
-	/* Erase and flush */
+	/* Erase the explosion drawn above */
 	if (drawn) {
-		/* Erase the explosion drawn above */
 		for (i = 0; i < num_grids; i++) {
-			/* Extract the location */
-			y = blast_grid[i].y;
-			x = blast_grid[i].x;
-
-			/* Erase visible, valid grids */
 			if (player_sees_grid[i])
-				event_signal_point(EVENT_MAP, x, y);
+				anim_erase(anim_step, blast_grid[i]);
 		}
-
-		/* Center the cursor */
-		move_cursor_relative(centre.y, centre.x);
-
-		/* Flush the explosion */
-		Term_fresh();
-		if (player->upkeep->redraw)
-			redraw_stuff(player);
 	}
+
+	anim_last_type = EVENT_EXPLOSION;
 }
 
 /**
@@ -1399,8 +1564,15 @@ static void display_bolt(game_event_type type, game_event_data *data,
 	bool beam = data->bolt.beam;
 	int oy = data->bolt.oy;
 	int ox = data->bolt.ox;
-	int y = data->bolt.y;
-	int x = data->bolt.x;
+	struct loc grid = loc(data->bolt.x, data->bolt.y);
+
+	/* A bolt starting afresh is a new effect */
+	if ((anim_last_type != EVENT_BOLT) ||
+		!loc_eq(anim_last_grid, loc(ox, oy))) {
+		anim_step = 0;
+	}
+	anim_last_type = EVENT_BOLT;
+	anim_last_grid = grid;
 
 	/* Only do visuals if the player can "see" the bolt */
 	if (seen) {
@@ -1408,32 +1580,25 @@ static void display_bolt(game_event_type type, game_event_data *data,
 		wchar_t c;
 
 		/* Obtain the bolt pict */
-		bolt_pict(oy, ox, y, x, proj_type, &a, &c);
+		bolt_pict(oy, ox, grid.y, grid.x, proj_type, &a, &c);
 
 		/* Visual effects */
-		print_rel(c, a, y, x);
-		move_cursor_relative(y, x);
-		Term_fresh();
-		if (player->upkeep->redraw)
-			redraw_stuff(player);
-		Term_xtra(TERM_XTRA_DELAY, msec);
-		event_signal_point(EVENT_MAP, x, y);
-		Term_fresh();
-		if (player->upkeep->redraw)
-			redraw_stuff(player);
+		anim_draw(anim_step, grid, a, c, msec);
+		anim_erase(anim_step + 1, grid);
 
 		/* Display "beam" grids */
 		if (beam) {
 
 			/* Obtain the explosion pict */
-			bolt_pict(y, x, y, x, proj_type, &a, &c);
+			bolt_pict(grid.y, grid.x, grid.y, grid.x, proj_type, &a, &c);
 
 			/* Visual effects */
-			print_rel(c, a, y, x);
+			anim_draw(anim_step + 1, grid, a, c, 0);
 		}
+		anim_step++;
 	} else if (drawing) {
-		/* Delay for consistency */
-		Term_xtra(TERM_XTRA_DELAY, msec);
+		/* Keep time with the rest of the bolt */
+		anim_step++;
 	}
 }
 
@@ -1446,22 +1611,21 @@ static void display_missile(game_event_type type, game_event_data *data,
 	int msec = player->opts.delay_factor;
 	struct object *obj = data->missile.obj;
 	bool seen = data->missile.seen;
-	int y = data->missile.y;
-	int x = data->missile.x;
+	struct loc grid = loc(data->missile.x, data->missile.y);
+
+	/* A missile starting afresh is a new effect */
+	if ((anim_last_type != EVENT_MISSILE) ||
+		(distance(anim_last_grid, grid) != 1)) {
+		anim_step = 0;
+	}
+	anim_last_type = EVENT_MISSILE;
+	anim_last_grid = grid;
 
 	/* Only do visuals if the player can "see" the missile */
 	if (seen) {
-		print_rel(object_char(obj), object_attr(obj), y, x);
-		move_cursor_relative(y, x);
-
-		Term_fresh();
-		if (player->upkeep->redraw) redraw_stuff(player);
-
-		Term_xtra(TERM_XTRA_DELAY, msec);
-		event_signal_point(EVENT_MAP, x, y);
-
-		Term_fresh();
-		if (player->upkeep->redraw) redraw_stuff(player);
+		anim_draw(anim_step, grid, object_attr(obj), object_char(obj), msec);
+		anim_erase(anim_step + 1, grid);
+		anim_step++;
 	}
 }
 
@@ -1538,43 +1702,35 @@ static void display_hit(game_event_type type, game_event_data *data, void *user)
 		tens = 9;
 	}
 
+	/* Hits follow on from whatever caused them, so keep the current frame */
 	if (damage_x_attr[0] & 0x80) {
-		print_rel(damage_x_char[ones], damage_x_attr[ones], y, x);
-		move_cursor_relative(y, x);
+		anim_draw(anim_step, loc(x, y), damage_x_attr[ones],
+			damage_x_char[ones], msec);
 		if (dam >= 10) {
-			print_rel(damage_x_char[tens], damage_x_attr[tens],
-				y, x - 1);
-			move_cursor_relative(y, x - 1);
+			anim_draw(anim_step, loc(x - 1, y), damage_x_attr[tens],
+				damage_x_char[tens], msec);
 		}
 	} else {
 		uint8_t a;
-		wchar_t c;
 
 		/* Obtain the hit colour */
 		hit_pict(dam, dam_type, fatal, &a);
 
 		/* Print the 'ones' digit */
-		c = '0' + ones;
-		print_rel(c, a, y, x);
-		move_cursor_relative(y, x);
+		anim_draw(anim_step, loc(x, y), a, '0' + ones, msec);
 
 		/* Print the 'tens' digit if needed */
 		if (dam >= 10) {
-			c = '0' + tens;
-			print_rel(c, a, y, x - 1);
-			move_cursor_relative(y, x - 1);
+			anim_draw(anim_step, loc(x - 1, y), a, '0' + tens, msec);
 		}
 	}
 
-	Term_fresh();
-	Term_xtra(TERM_XTRA_DELAY, msec);
-
-	event_signal_point(EVENT_MAP, x, y);
+	anim_erase(anim_step + 1, loc(x, y));
 	if (dam >= 10) {
-		event_signal_point(EVENT_MAP, x - 1, y);
+		anim_erase(anim_step + 1, loc(x - 1, y));
 	}
-	Term_fresh();
-	if (player->upkeep->redraw) redraw_stuff(player);
+	anim_step++;
+	anim_last_type = EVENT_HIT;
 }
 
 /**
@@ -1887,6 +2043,25 @@ static void update_minimap_subwindow(game_event_type type,
 {
 	struct minimap_flags *flags = user;
 
+	/* Note changes even while not redrawing, so they aren't missed later */
+	if (type == EVENT_MAP) {
+		if (data->point.x == -1 && data->point.y == -1) {
+			display_map_note_spot(angband_term[flags->win_idx], data->point);
+		} else {
+			struct loc grid;
+
+			for (grid.y = data->region.top_left.y;
+					grid.y <= data->region.bottom_right.y; grid.y++) {
+				for (grid.x = data->region.top_left.x;
+						grid.x <= data->region.bottom_right.x; grid.x++) {
+					display_map_note_spot(angband_term[flags->win_idx],
+						grid);
+				}
+			}
+		}
+		return;
+	}
+
 	if (player_resting_count(player) || player->upkeep->running) return;
 
 	if (type == EVENT_END) {
@@ -1897,11 +2072,13 @@ static void update_minimap_subwindow(game_event_type type,
 		Term_activate(t);
 
 		/* If whole-map redraw, clear window first. */
-		if (flags->needs_redraw)
+		if (flags->needs_redraw) {
 			Term_clear();
-
-		/* Redraw map */
-		display_map(NULL, NULL);
+			display_map(NULL, NULL);
+		} else {
+			/* Redraw what's changed */
+			display_map_update();
+		}
 		Term_fresh();
 
 		/* Restore */
@@ -1920,6 +2097,9 @@ static void update_minimap_subwindow(game_event_type type,
 		if (cave->height <= map_height || cave->width <= map_width) {
 			flags->needs_redraw = true;
 		}
+
+		/* Nothing on the old level's map carries over */
+		display_map_note_spot(t, loc(-1, -1));
 	}
 }
 
@@ -2449,6 +2629,9 @@ static void repeated_command_display(game_event_type type,
 static void new_level_display_update(game_event_type type,
 									 game_event_data *data, void *user)
 {
+	/* Animations from the old level are no use now */
+	anim_clear(false);
+
 	/* Hack -- enforce illegal panel */
 	Term->offset_y = z_info->dungeon_hgt;
 	Term->offset_x = z_info->dungeon_wid;
@@ -2843,6 +3026,16 @@ static void ui_enter_game(game_event_type type, game_event_data *data,
 static void ui_leave_game(game_event_type type, game_event_data *data,
 						  void *user)
 {
+	int i;
+
+	/* Free the animation queue */
+	anim_clear(false);
+	for (i = 0; i < ANIM_FRAMES_MAX; i++) {
+		mem_free(anim_frames[i].erase);
+		mem_free(anim_frames[i].draw);
+	}
+	memset(anim_frames, 0, sizeof(anim_frames));
+
 	/*
 	 * These are removed here rather than ui_leave_world() to allow for
 	 * post-death viewing of the dungeon.
@@ -33,6 +33,7 @@
 #include "ui-input.h"
 #include "ui-keymap.h"
 #include "ui-knowledge.h"
+#include "ui-map.h"
 #include "ui-options.h"
 #include "ui-output.h"
 #include "ui-prefs.h"
@@ -118,4 +119,5 @@ void textui_cleanup(void)
 	keymap_free();
 	textui_prefs_free();
 	textui_knowledge_cleanup();
+	display_map_free();
 }
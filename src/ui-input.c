@@ -220,6 +220,13 @@ ui_event inkey_ex(void)
 	/* Hack -- Activate main screen */
 	Term_activate(term_screen);
 
+	/* Show the map as it is now */
+	event_flush_map();
+
+	/* Play any animations while waiting, unless the map is hidden */
+	if (!inkey_scan && !screen_save_depth) {
+		display_animations();
+	}
 
 	/* Get a key */
 	while (ke.type == EVT_NONE) {
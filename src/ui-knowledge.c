@@ -1502,43 +1502,6 @@ static void display_artifact(int col, int row, bool cursor, int oid)
 	c_prt(attr, o_name, row, col);
 }
 
-/**
- * Look for an artifact
- */
-static struct object *find_artifact(struct artifact *artifact)
-{
-	int y, x, i;
-	struct object *obj;
-
-	/* Ground objects */
-	for (y = 1; y < cave->height; y++) {
-		for (x = 1; x < cave->width; x++) {
-			struct loc grid = loc(x, y);
-			for (obj = square_object(cave, grid); obj; obj = obj->next) {
-				if (obj->artifact == artifact) return obj;
-			}
-		}
-	}
-
-	/* Player objects */
-	for (obj = player->gear; obj; obj = obj->next) {
-		if (obj->artifact == artifact) return obj;
-	}
-
-	/* Monster objects */
-	for (i = cave_monster_max(cave) - 1; i >= 1; i--) {
-		struct monster *mon = cave_monster(cave, i);
-		obj = mon ? mon->held_obj : NULL;
-
-		while (obj) {
-			if (obj->artifact == artifact) return obj;
-			obj = obj->next;
-		}
-	}
-
-	return NULL;
-}
-
 /**
  * Show artifact lore
  */
@@ -1553,7 +1516,7 @@ static void desc_art_fake(int a_idx)
 	textblock *tb;
 	region area = { 0, 0, 0, 0 };
 
-	obj = find_artifact(&a_info[a_idx]);
+	obj = artifact_object(&a_info[a_idx]);
 
 	/* If it's been lost, make a fake artifact for it */
 	if (!obj) {
@@ -1634,7 +1597,7 @@ static bool artifact_is_known(int a_idx)
 		return false;
 
 	/* Check all objects to see if it exists but hasn't been IDed */
-	obj = find_artifact(&a_info[a_idx]);
+	obj = artifact_object(&a_info[a_idx]);
 	if (obj && !object_is_known_artifact(obj))
 		return false;
 
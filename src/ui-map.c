@@ -737,82 +737,112 @@ void prt_map(void)
 }
 
 /**
- * Display a "small-scale" map of the dungeon in the active Term.
- *
- * Note that this function must "disable" the special lighting effects so
- * that the "priority" function will work.
- *
- * Note the use of a specialized "priority" function to allow this function
- * to work with any graphic attr/char mappings, and the attempts to optimize
- * this function where possible.
- *
- * If "cy" and "cx" are not NULL, then returns the screen location at which
- * the player was displayed, so the cursor can be moved to that location,
- * and restricts the horizontal map size to SCREEN_WID.  Otherwise, nothing
- * is returned (obviously), and no restrictions are enforced.
+ * A small-scale map as last drawn in a term, kept so that redraws only need
+ * to work out the parts of the map which have changed
  */
-void display_map(int *cy, int *cx)
-{
-	int map_hgt, map_wid;
-	int row, col;
+struct minimap {
+	int cave_hgt, cave_wid;		/* Size of the level it was laid out for */
+	int map_hgt, map_wid;		/* Size of the map in the term */
+	int tile_hgt, tile_wid;		/* Tile multipliers it was laid out for */
+	int *row_first, *row_last;	/* Level rows shown in each map row */
+	int *col_first, *col_last;	/* Level columns shown in each map column */
+	bool *dirty;				/* Map cells which need to be drawn again */
+	bool all_dirty;				/* Whether the whole map needs drawing */
+	struct loc player_cell;		/* Where the player was drawn */
+};
+
+static struct minimap minimaps[ANGBAND_TERM_MAX];
 
-	int x, y;
-	struct grid_data g;
-
-	int a, ta;
-	wchar_t c, tc;
-
-	uint8_t tp;
+/**
+ * Get the small-scale map for a term, if it's one of ours
+ */
+static struct minimap *minimap_for_term(const term *t)
+{
+	int j;
 
-	struct monster_race *race = &r_info[0];
+	for (j = 0; j < ANGBAND_TERM_MAX; j++) {
+		if (angband_term[j] == t) return &minimaps[j];
+	}
+	return NULL;
+}
 
-	/* Priority array */
-	uint8_t **mp = mem_zalloc(cave->height * sizeof(uint8_t*));
-	for (y = 0; y < cave->height; y++)
-		mp[y] = mem_zalloc(cave->width * sizeof(uint8_t));
+/**
+ * Work out which level grids go in each cell of the small-scale map for the
+ * active term, if anything has changed since it was last laid out.
+ *
+ * \return false if the term is too small for any map at all
+ */
+static bool minimap_layout(struct minimap *m)
+{
+	int map_hgt, map_wid, y, x;
 
-	/* Desired map height */
 	get_minimap_dimensions(Term, cave, tile_width, tile_height,
 		&map_wid, &map_hgt);
+	if ((map_wid < 1) || (map_hgt < 1)) return false;
 
-	/* Prevent accidents */
-	if ((map_wid < 1) || (map_hgt < 1)) {
-		for (y = 0; y < cave->height; y++)
-			mem_free(mp[y]);
-		mem_free(mp);
-		return;
+	if (m->dirty && (m->map_hgt == map_hgt) && (m->map_wid == map_wid) &&
+		(m->cave_hgt == cave->height) && (m->cave_wid == cave->width) &&
+		(m->tile_hgt == tile_height) && (m->tile_wid == tile_width)) {
+		return true;
 	}
 
-	/* Nothing here */
-	a = COLOUR_WHITE;
-    c = L' ';
-	ta = COLOUR_WHITE;
-	tc = L' ';
-
-	/* Draw a box around the edge of the term */
-	window_make(0, 0, map_wid + 1, map_hgt + 1);
-
-	/* Clear outside that boundary. */
-	if (map_wid + 1 < Term->wid - 1) {
-		for (y = 0; y < map_hgt + 1; y++) {
-			Term_erase(map_wid + 2, y, Term->wid - map_wid - 2);
-		}
-	}
-	if (map_hgt + 1 < Term->hgt - 1) {
-		for (y = map_hgt + 2; y < Term->hgt; y++) {
-			Term_erase(0, y, Term->wid);
-		}
+	m->map_hgt = map_hgt;
+	m->map_wid = map_wid;
+	m->cave_hgt = cave->height;
+	m->cave_wid = cave->width;
+	m->tile_hgt = tile_height;
+	m->tile_wid = tile_width;
+	m->row_first = mem_realloc(m->row_first, map_hgt * sizeof(int));
+	m->row_last = mem_realloc(m->row_last, map_hgt * sizeof(int));
+	m->col_first = mem_realloc(m->col_first, map_wid * sizeof(int));
+	m->col_last = mem_realloc(m->col_last, map_wid * sizeof(int));
+	mem_free(m->dirty);
+	m->dirty = mem_zalloc(map_hgt * map_wid * sizeof(bool));
+	m->all_dirty = true;
+
+	/* Each map row or column shows a run of level rows or columns */
+	for (y = 0; y < map_hgt; y++) {
+		m->row_first[y] = -1;
+		m->row_last[y] = -2;
 	}
-
-	/* Analyze the actual map */
 	for (y = 0; y < cave->height; y++) {
-		row = (y * map_hgt) / cave->height;
+		int row = (y * map_hgt) / cave->height;
 		if (tile_height > 1) row = row - (row % tile_height);
+		if (m->row_first[row] < 0) m->row_first[row] = y;
+		m->row_last[row] = y;
+	}
+	for (x = 0; x < map_wid; x++) {
+		m->col_first[x] = -1;
+		m->col_last[x] = -2;
+	}
+	for (x = 0; x < cave->width; x++) {
+		int col = (x * map_wid) / cave->width;
+		if (tile_width > 1) col = col - (col % tile_width);
+		if (m->col_first[col] < 0) m->col_first[col] = x;
+		m->col_last[col] = x;
+	}
 
-		for (x = 0; x < cave->width; x++) {
-			col = (x * map_wid) / cave->width;
-			if (tile_width > 1) col = col - (col % tile_width);
+	return true;
+}
+
+/**
+ * Draw one cell of the small-scale map, showing the grid in it with the
+ * highest priority (the first in the level, if there's a tie)
+ *
+ * \param blank is whether to erase the cell if nothing in it has priority;
+ * after a full redraw it is blank already
+ */
+static void minimap_draw_cell(const struct minimap *m, int row, int col,
+		bool blank)
+{
+	struct grid_data g, best;
+	int a, ta;
+	wchar_t c, tc;
+	uint8_t mp = 0, tp;
+	int x, y;
 
+	for (y = m->row_first[row]; y <= m->row_last[row]; y++) {
+		for (x = m->col_first[col]; x <= m->col_last[col]; x++) {
 			/* Get the attr/char at that map location */
 			map_info(loc(x, y), &g);
 			grid_data_as_text(&g, &a, &c, &ta, &tc);
@@ -824,34 +854,90 @@ void display_map(int *cy, int *cx)
 			if ((a != ta) || (c != tc)) tp = 20;
 
 			/* Save "best" */
-			if (mp[row][col] < tp) {
-				/* Hack - make every grid on the map lit */
-				g.lighting = LIGHTING_LIT;
-				grid_data_as_text(&g, &a, &c, &ta, &tc);
+			if (mp < tp) {
+				best = g;
+				mp = tp;
+			}
+		}
+	}
 
-				Term_queue_char(Term, col + 1, row + 1, a, c, ta, tc);
+	if (mp) {
+		/* Hack - make every grid on the map lit */
+		best.lighting = LIGHTING_LIT;
+		grid_data_as_text(&best, &a, &c, &ta, &tc);
 
-				if ((tile_width > 1) || (tile_height > 1))
-					Term_big_queue_char(Term, col + 1,
-						row + 1, Term->hgt - 1,
-						255, -1, 0, 0);
+		Term_queue_char(Term, col + 1, row + 1, a, c, ta, tc);
+
+		if ((tile_width > 1) || (tile_height > 1))
+			Term_big_queue_char(Term, col + 1, row + 1, Term->hgt - 1,
+				255, -1, 0, 0);
+	} else if (blank) {
+		for (y = 0; y < tile_height; y++) {
+			Term_erase(col + 1, row + 1 + y, tile_width);
+		}
+	}
+}
 
-				/* Save priority */
-				mp[row][col] = tp;
+/**
+ * Draw the small-scale map in the active Term, either all of it or just the
+ * cells which have changed since it was last drawn.
+ */
+static void minimap_draw(struct minimap *m, bool all, int *cy, int *cx)
+{
+	int a, ta;
+	wchar_t c, tc;
+	struct grid_data g;
+	int row, col, y;
+	struct monster_race *race = &r_info[0];
+
+	if (!minimap_layout(m)) return;
+	if (m->all_dirty) all = true;
+
+	if (all) {
+		/* Draw a box around the edge of the term */
+		window_make(0, 0, m->map_wid + 1, m->map_hgt + 1);
+
+		/* Clear outside that boundary. */
+		if (m->map_wid + 1 < Term->wid - 1) {
+			for (y = 0; y < m->map_hgt + 1; y++) {
+				Term_erase(m->map_wid + 2, y, Term->wid - m->map_wid - 2);
+			}
+		}
+		if (m->map_hgt + 1 < Term->hgt - 1) {
+			for (y = m->map_hgt + 2; y < Term->hgt; y++) {
+				Term_erase(0, y, Term->wid);
+			}
+		}
+	} else {
+		/* The player has probably moved */
+		m->dirty[m->player_cell.y * m->map_wid + m->player_cell.x] = true;
+	}
+
+	/* Analyze the actual map */
+	for (row = 0; row < m->map_hgt; row++) {
+		if (m->row_first[row] < 0) continue;
+		for (col = 0; col < m->map_wid; col++) {
+			bool *dirty = &m->dirty[row * m->map_wid + col];
+			if (m->col_first[col] < 0) continue;
+			if (all || *dirty) {
+				minimap_draw_cell(m, row, col, !all);
 			}
+			*dirty = false;
 		}
 	}
+	m->all_dirty = false;
 
 	/*** Display the player ***/
 
 	/* Player location */
-	row = (player->grid.y * map_hgt / cave->height);
-	col = (player->grid.x * map_wid / cave->width);
+	row = (player->grid.y * m->map_hgt / cave->height);
+	col = (player->grid.x * m->map_wid / cave->width);
 
 	if (tile_width > 1)
 		col = col - (col % tile_width);
 	if (tile_height > 1)
 		row = row - (row % tile_height);
+	m->player_cell = loc(col, row);
 
 	/* Get the terrain at the player's spot. */
 	map_info(player->grid, &g);
@@ -868,14 +954,86 @@ void display_map(int *cy, int *cx)
 	if ((tile_width > 1) || (tile_height > 1))
 		Term_big_queue_char(Term, col + 1, row + 1, Term->hgt - 1,
 			255, -1, 0, 0);
-  
+
 	/* Return player location */
 	if (cy != NULL) (*cy) = row + 1;
 	if (cx != NULL) (*cx) = col + 1;
+}
+
+/**
+ * Display a "small-scale" map of the dungeon in the active Term.
+ *
+ * Note that this function must "disable" the special lighting effects so
+ * that the "priority" function will work.
+ *
+ * Note the use of a specialized "priority" function to allow this function
+ * to work with any graphic attr/char mappings, and the attempts to optimize
+ * this function where possible.
+ *
+ * If "cy" and "cx" are not NULL, then returns the screen location at which
+ * the player was displayed, so the cursor can be moved to that location,
+ * and restricts the horizontal map size to SCREEN_WID.  Otherwise, nothing
+ * is returned (obviously), and no restrictions are enforced.
+ */
+void display_map(int *cy, int *cx)
+{
+	struct minimap *m = minimap_for_term(Term);
+
+	if (m) minimap_draw(m, true, cy, cx);
+}
+
+/**
+ * Bring the "small-scale" map in the active Term up to date, only working out
+ * the parts of it which have been noted as changed by display_map_note_spot()
+ * since it was last drawn.
+ */
+void display_map_update(void)
+{
+	struct minimap *m = minimap_for_term(Term);
+
+	if (m) minimap_draw(m, false, NULL, NULL);
+}
+
+/**
+ * Note that a grid has changed, so the part of the small-scale map in the
+ * given term that shows it needs drawing again.  A grid of (-1, -1), as used
+ * by EVENT_MAP, means the whole map has changed.
+ */
+void display_map_note_spot(const term *t, struct loc grid)
+{
+	struct minimap *m = minimap_for_term(t);
+	int row, col;
+
+	if (!m || !m->dirty) return;
+	if ((grid.y < 0) || (grid.y >= m->cave_hgt) || (grid.x < 0) ||
+		(grid.x >= m->cave_wid)) {
+		m->all_dirty = true;
+		return;
+	}
+
+	row = (grid.y * m->map_hgt) / m->cave_hgt;
+	if (m->tile_hgt > 1) row = row - (row % m->tile_hgt);
+	col = (grid.x * m->map_wid) / m->cave_wid;
+	if (m->tile_wid > 1) col = col - (col % m->tile_wid);
+	m->dirty[row * m->map_wid + col] = true;
+}
+
+/**
+ * Free the small-scale maps kept for each term
+ */
+void display_map_free(void)
+{
+	int j;
 
-	for (y = 0; y < cave->height; y++)
-		mem_free(mp[y]);
-	mem_free(mp);
+	for (j = 0; j < ANGBAND_TERM_MAX; j++) {
+		struct minimap *m = &minimaps[j];
+		mem_free(m->row_first);
+		mem_free(m->row_last);
+		mem_free(m->col_first);
+		mem_free(m->col_last);
+		mem_free(m->dirty);
+		memset(m, 0, sizeof(*m));
+	}
 }
 
 
@@ -22,6 +22,9 @@ extern void move_cursor_relative(int y, int x);
 extern void print_rel(wchar_t c, uint8_t a, int y, int x);
 extern void prt_map(void);
 extern void display_map(int *cy, int *cx);
+extern void display_map_update(void);
+extern void display_map_note_spot(const struct term *t, struct loc grid);
+extern void display_map_free(void);
 extern void do_cmd_view_map(void);
 extern void mini_screenshot(game_event_type type, game_event_data *data,
 							void *user);
@@ -477,11 +477,11 @@ static void tval_display(struct menu *menu, int oid, bool cursor, int row,
 	uint8_t attr = COLOUR_RED;
 
 	if (((smithing_tvals[oid].category == SMITH_TYPE_WEAPON) &&
-		 player_active_ability(player, "Weaponsmith")) ||
+		 player_active_ability(player, PA_WEAPONSMITH)) ||
 		((smithing_tvals[oid].category == SMITH_TYPE_JEWELRY) &&
-		 player_active_ability(player, "Jeweller")) ||
+		 player_active_ability(player, PA_JEWELLER)) ||
 		((smithing_tvals[oid].category == SMITH_TYPE_ARMOUR) &&
-		 player_active_ability(player, "Armoursmith"))) {
+		 player_active_ability(player, PA_ARMOURSMITH))) {
 		attr = COLOUR_WHITE;
 	}
 
@@ -1378,9 +1378,9 @@ static void check_smithing_menu_row_colors(void)
 	/* Recognise which actions are valid, and which need a new ability */
 	for (i = 0; i < N_ELEMENTS(smithing_actions); i++) {
 		if (i == 0) {
-			if (player_active_ability(player, "Weaponsmith") ||
-				player_active_ability(player, "Armoursmith") ||
-				player_active_ability(player, "Jeweller")) {
+			if (player_active_ability(player, PA_WEAPONSMITH) ||
+				player_active_ability(player, PA_ARMOURSMITH) ||
+				player_active_ability(player, PA_JEWELLER)) {
 				smithing_actions[i].flags = 0;
 			} else {
 				smithing_actions[i].flags = MN_ACT_MAYBE;
@@ -1391,7 +1391,7 @@ static void check_smithing_menu_row_colors(void)
 				tval_is_jewelry(smith_obj) || tval_is_horn(smith_obj) ||
 				strstr(smith_obj->kind->name, "Shovel")) {
 				smithing_actions[i].flags = MN_ACT_GRAYED;
-			} else if (player_active_ability(player, "Enchantment")) {
+			} else if (player_active_ability(player, PA_ENCHANTMENT)) {
 				smithing_actions[i].flags = 0;
 			} else {
 				smithing_actions[i].flags = MN_ACT_MAYBE;
@@ -1401,7 +1401,7 @@ static void check_smithing_menu_row_colors(void)
 			if (!smith_obj->kind || smith_obj->ego || tval_is_horn(smith_obj) ||
 				(player->self_made_arts >= z_info->self_arts_max)) {
 				smithing_actions[i].flags = MN_ACT_GRAYED;
-			} else if (player_active_ability(player, "Artifice")) {
+			} else if (player_active_ability(player, PA_ARTIFICE)) {
 				smithing_actions[i].flags = 0;
 			} else {
 				smithing_actions[i].flags = MN_ACT_MAYBE;
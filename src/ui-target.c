@@ -19,6 +19,7 @@
 #include "angband.h"
 #include "cave.h"
 #include "game-input.h"
+#include "game-world.h"
 #include "init.h"
 #include "mon-desc.h"
 #include "mon-lore.h"
@@ -325,7 +326,7 @@ static ui_event target_recall_loop_object(struct object *obj, int y, int x,
 						"%s%s%s%s, %s (%d:%d, noise=%d, scent=%d).", s1, s2, s3,
 						o_name, coords, y, x,
 						(int)cave->player_noise.grids[y][x],
-						(int)cave->scent.grids[y][x]);
+						get_scent(cave, loc(x, y)));
 			} else {
 				strnfmt(out_val, TARGET_OUT_VAL_SIZE,
 						"%s%s%s%s, %s.", s1, s2, s3, o_name, coords);
@@ -413,7 +414,7 @@ static bool aux_hallucinate(struct chunk *c, struct player *p,
 			auxst->grid.y,
 			auxst->grid.x,
 			(int)c->player_noise.grids[auxst->grid.y][auxst->grid.x],
-			(int)c->scent.grids[auxst->grid.y][auxst->grid.x]);
+			get_scent(c, auxst->grid));
 	} else {
 		strnfmt(out_val, sizeof(out_val), "%s%s%s, %s.",
 			auxst->phrase1,
@@ -494,7 +495,7 @@ static bool aux_monster(struct chunk *c, struct player *p,
 					auxst->grid.y,
 					auxst->grid.x,
 					(int)c->player_noise.grids[auxst->grid.y][auxst->grid.x],
-					(int)c->scent.grids[auxst->grid.y][auxst->grid.x]);
+					get_scent(c, auxst->grid));
 			} else {
 				strnfmt(out_val, sizeof(out_val),
 					"%s%s%s%s, %s.",
@@ -580,7 +581,7 @@ static bool aux_monster(struct chunk *c, struct player *p,
 				auxst->grid.y,
 				auxst->grid.x,
 				(int)c->player_noise.grids[auxst->grid.y][auxst->grid.x],
-				(int)c->scent.grids[auxst->grid.y][auxst->grid.x]);
+				get_scent(c, auxst->grid));
 
 			prt(out_val, 0, 0);
 			move_cursor_relative(auxst->grid.y, auxst->grid.x);
@@ -653,7 +654,7 @@ static bool aux_trap(struct chunk *c, struct player *p,
 				auxst->grid.y,
 				auxst->grid.x,
 				(int)c->player_noise.grids[auxst->grid.y][auxst->grid.x],
-				(int)c->scent.grids[auxst->grid.y][auxst->grid.x]);
+				get_scent(c, auxst->grid));
 		} else {
 			strnfmt(out_val, sizeof(out_val), "%s%s%s%s, %s.",
 				auxst->phrase1,
@@ -725,7 +726,7 @@ static bool aux_object(struct chunk *c, struct player *p,
 					auxst->grid.y,
 					auxst->grid.x,
 					(int)c->player_noise.grids[auxst->grid.y][auxst->grid.x],
-					(int)c->scent.grids[auxst->grid.y][auxst->grid.x]);
+					get_scent(c, auxst->grid));
 			} else {
 				strnfmt(out_val, sizeof(out_val),
 					"%s%sa pile of %d objects, %s.",
@@ -849,7 +850,7 @@ static bool aux_terrain(struct chunk *c, struct player *p,
 			auxst->grid.y,
 			auxst->grid.x,
 			(int)c->player_noise.grids[auxst->grid.y][auxst->grid.x],
-			(int)c->scent.grids[auxst->grid.y][auxst->grid.x]);
+			get_scent(c, auxst->grid));
 	} else {
 		strnfmt(out_val, sizeof(out_val),
 			"%s%s%s%s, %s.",
@@ -17,6 +17,7 @@
  */
 #include "buildid.h"
 #include "h-basic.h"
+#include "profile.h"
 #include "ui-term.h"
 #include "z-color.h"
 #include "z-util.h"
@@ -309,6 +310,13 @@ int col_map[SIDEBAR_MAX] = {13, 0, 0};
  */
 term *Term = NULL;
 
+/**
+ * Nesting depth of Term_batch_begin() calls, and the last term which
+ * deferred its flush during the batch
+ */
+static int term_batch_depth = 0;
+static term *term_batch_last = NULL;
+
 /* grumbles */
 int log_i = 0;
 int log_size = 0;
@@ -342,6 +350,8 @@ static errr term_win_nuke(term_win *s)
 	mem_free_alt(s->vta);
 	mem_free_alt(s->vtc);
 
+	mem_free(s->saved_row);
+
 	/* Success */
 	return (0);
 }
@@ -384,6 +394,86 @@ static errr term_win_init(term_win *s, int w, int h)
 }
 
 
+/**
+ * Initialize a "term_win" to be a layer for Term_save().  Rows are only
+ * copied into it when they are about to change (see term_win_keep_row()),
+ * so the contents start out unset.
+ */
+static void term_win_init_saved(term_win *s, int w, int h)
+{
+	int y;
+
+	s->a = mem_zalloc_alt(h * sizeof(int*));
+	s->c = mem_zalloc_alt(h * sizeof(wchar_t*));
+	s->va = mem_alloc_alt(h * w * sizeof(int));
+	s->vc = mem_alloc_alt(h * w * sizeof(wchar_t));
+	s->ta = mem_zalloc_alt(h * sizeof(int*));
+	s->tc = mem_zalloc_alt(h * sizeof(wchar_t*));
+	s->vta = mem_alloc_alt(h * w * sizeof(int));
+	s->vtc = mem_alloc_alt(h * w * sizeof(wchar_t));
+	for (y = 0; y < h; y++) {
+		s->a[y] = s->va + w * y;
+		s->c[y] = s->vc + w * y;
+		s->ta[y] = s->vta + w * y;
+		s->tc[y] = s->vtc + w * y;
+	}
+
+	s->saved_row = mem_zalloc(h * sizeof(bool));
+}
+
+
+/**
+ * Copy row "y" of a "term_win" from another
+ */
+static void term_win_copy_row(term_win *s, term_win *f, int y, int w)
+{
+	memcpy(s->a[y], f->a[y], w * sizeof(int));
+	memcpy(s->c[y], f->c[y], w * sizeof(wchar_t));
+	memcpy(s->ta[y], f->ta[y], w * sizeof(int));
+	memcpy(s->tc[y], f->tc[y], w * sizeof(wchar_t));
+}
+
+
+/**
+ * Row "y" of the requested screen is about to change, so copy it into the
+ * latest Term_save() layer if that has not kept it already
+ */
+static void term_win_keep_row(term *t, int y)
+{
+	term_win *mem = t->mem;
+
+	if (!mem || !mem->saved_row || mem->saved_row[y]) return;
+	term_win_copy_row(mem, t->scr, y, t->wid);
+	mem->saved_row[y] = true;
+}
+
+
+/**
+ * Fill in the rows the Term_save() layers of a term never needed to keep,
+ * leaving every layer a complete copy of the screen it saved
+ */
+static void term_mem_flatten(term *t)
+{
+	term_win *newer = t->scr;
+	term_win *mem;
+	int y;
+
+	for (mem = t->mem; mem; mem = mem->next) {
+		if (mem->saved_row) {
+			/* Rows kept by neither layer are unchanged since this save */
+			for (y = 0; y < t->hgt; y++) {
+				if (!mem->saved_row[y]) {
+					term_win_copy_row(mem, newer, y, t->wid);
+				}
+			}
+			mem_free(mem->saved_row);
+			mem->saved_row = NULL;
+		}
+		newer = mem;
+	}
+}
+
+
 /**
  * Copy a "term_win" from another
  */
@@ -444,6 +534,8 @@ extern errr Term_redraw_all(void)
 	errr combined = 0;
 	int j;
 
+	/* Let the front end write all the terminals out together */
+	Term_batch_begin();
 	for (j = 0; j < ANGBAND_TERM_MAX; j++) {
 		errr one_result;
 
@@ -454,6 +546,7 @@ extern errr Term_redraw_all(void)
 			combined = one_result;
 		}
 	}
+	Term_batch_end();
 	(void) Term_activate(old);
 
 	return combined;
@@ -568,6 +661,9 @@ void Term_queue_char(term *t, int x, int y, int a, wchar_t c, int ta,
 	/* Hack -- Ignore non-changes */
 	if ((oa == a) && (oc == c) && (ota == ta) && (otc == tc)) return;
 
+	/* Keep the old row for the latest save */
+	if (t->mem) term_win_keep_row(t, y);
+
 	/* Save the "literal" information */
 	scr_aa[x] = a;
 	scr_cc[x] = c;
@@ -708,6 +804,9 @@ void Term_queue_chars(int x, int y, int n, int a, const wchar_t *s)
 		/* Hack -- Ignore non-changes */
 		if ((oa == a) && (oc == *s) && (ota == 0) && (otc == 0)) continue;
 
+		/* Keep the old row for the latest save */
+		if (x1 < 0 && Term->mem) term_win_keep_row(Term, y);
+
 		/* Save the "literal" information */
 		scr_aa[x] = a;
 		scr_cc[x] = *s;
@@ -1737,6 +1836,7 @@ errr Term_fresh(void)
 		return (1);
 	}
 
+	PROFILE_START(term_fresh);
 
 	/* Paranoia -- use "fake" hooks to prevent core dumps */
 	if (!Term->curs_hook) Term->curs_hook = Term_curs_hack;
@@ -1974,8 +2074,15 @@ errr Term_fresh(void)
 	old->cnx = scr->cnx;
 	old->cny = scr->cny;
 
-	/* Actually flush the output */
-	Term_xtra(TERM_XTRA_FRESH, 0);
+	/* Actually flush the output, or leave it to the end of the batch */
+	if (term_batch_depth > 0) {
+		Term_xtra(TERM_XTRA_FRESH, TERM_FRESH_DEFER);
+		term_batch_last = Term;
+	} else {
+		Term_xtra(TERM_XTRA_FRESH, TERM_FRESH_NOW);
+	}
+
+	PROFILE_STOP(term_fresh);
 
 	/* Success */
 	return (0);
@@ -1983,6 +2090,36 @@ errr Term_fresh(void)
 
 
 
+/**
+ * Start a batch of refreshes.  Until the matching Term_batch_end(), front
+ * ends may hold back the output of Term_fresh() (see TERM_FRESH_DEFER) and
+ * then write it all at once.  Batches may be nested.
+ */
+void Term_batch_begin(void)
+{
+	term_batch_depth++;
+}
+
+
+/**
+ * End a batch of refreshes, flushing anything held back during it
+ */
+void Term_batch_end(void)
+{
+	term *old = Term;
+
+	if (term_batch_depth == 0 || --term_batch_depth > 0) return;
+	if (!term_batch_last) return;
+
+	/* One flush sends everything the batch held back */
+	Term_activate(term_batch_last);
+	Term_xtra(TERM_XTRA_FRESH, TERM_FRESH_NOW);
+	Term_activate(old);
+	term_batch_last = NULL;
+}
+
+
+
 /**
  * ------------------------------------------------------------------------
  * Output routines
@@ -2281,6 +2418,9 @@ errr Term_erase(int x, int y, int n)
 		/* Hack -- Ignore "non-changes" */
 		if ((oa == COLOUR_WHITE) && (oc == ' ')) continue;
 
+		/* Keep the old row for the latest save */
+		if (x1 < 0 && Term->mem) term_win_keep_row(Term, y);
+
 		/* Save the "literal" information */
 		scr_aa[x] = COLOUR_WHITE;
 		scr_cc[x] = ' ';
@@ -2336,6 +2476,9 @@ errr Term_clear(void)
 		int *scr_taa = Term->scr->ta[y];
 		wchar_t *scr_tcc = Term->scr->tc[y];
 
+		/* Keep the old row for the latest save */
+		if (Term->mem) term_win_keep_row(Term, y);
+
 		/* Wipe each column */
 		for (x = 0; x < w; x++) {
 			scr_aa[x] = COLOUR_WHITE;
@@ -2723,11 +2866,16 @@ errr Term_save(void)
 	/* Allocate window */
 	mem = mem_zalloc(sizeof(term_win));
 
-	/* Initialize window */
-	term_win_init(mem, w, h);
+	/* Initialize window; rows are copied in as they change */
+	term_win_init_saved(mem, w, h);
 
-	/* Grab */
-	term_win_copy(mem, Term->scr, w, h);
+	/* Grab the cursor */
+	mem->cnx = Term->scr->cnx;
+	mem->cny = Term->scr->cny;
+	mem->cx = Term->scr->cx;
+	mem->cy = Term->scr->cy;
+	mem->cu = Term->scr->cu;
+	mem->cv = Term->scr->cv;
 
 	/* Front of the queue */
 	mem->next = Term->mem;
@@ -2756,6 +2904,9 @@ errr Term_load(void)
 
 	term_win *tmp;
 
+	/* Double-height tiles reach across rows, so redraw everything for them */
+	bool all_changed = true;
+
 	/* Pop off window from the list */
 	if (Term->mem) {
 		/* Save pointer to old mem */
@@ -2764,8 +2915,27 @@ errr Term_load(void)
 		/* Forget it */
 		Term->mem = Term->mem->next;
 
-		/* Load */
-		term_win_copy(Term->scr, tmp, w, h);
+		if (tmp->saved_row) {
+			/* Only the rows changed since the save need to come back */
+			all_changed = (Term->dblh_hook != NULL);
+			for (y = 0; y < h; y++) {
+				if (!tmp->saved_row[y]) continue;
+				term_win_copy_row(Term->scr, tmp, y, w);
+				Term->x1[y] = 0;
+				Term->x2[y] = w - 1;
+				if (y < Term->y1) Term->y1 = y;
+				if (y > Term->y2) Term->y2 = y;
+			}
+			Term->scr->cnx = tmp->cnx;
+			Term->scr->cny = tmp->cny;
+			Term->scr->cx = tmp->cx;
+			Term->scr->cy = tmp->cy;
+			Term->scr->cu = tmp->cu;
+			Term->scr->cv = tmp->cv;
+		} else {
+			/* Load */
+			term_win_copy(Term->scr, tmp, w, h);
+		}
 
 		/* Free the old window */
 		(void)term_win_nuke(tmp);
@@ -2774,16 +2944,18 @@ errr Term_load(void)
 		mem_free(tmp);
 	}
 
-	/* Assume change */
-	for (y = 0; y < h; y++) {
+	if (all_changed) {
 		/* Assume change */
-		Term->x1[y] = 0;
-		Term->x2[y] = w - 1;
-	}
+		for (y = 0; y < h; y++) {
+			/* Assume change */
+			Term->x1[y] = 0;
+			Term->x2[y] = w - 1;
+		}
 
-	/* Assume change */
-	Term->y1 = 0;
-	Term->y2 = h - 1;
+		/* Assume change */
+		Term->y1 = 0;
+		Term->y2 = h - 1;
+	}
 
 	/* One less saved */
 	Term->saved--;
@@ -2811,6 +2983,9 @@ errr Term_load_all(void)
 	} *reversed_list = NULL;
 	struct term_win *cursor;
 
+	/* Replaying needs every save complete */
+	term_mem_flatten(Term);
+
 	for (cursor = Term->mem; cursor; cursor = cursor->next) {
 		struct reversed_save *new_head = mem_alloc(sizeof(*new_head));
 
@@ -2898,7 +3073,8 @@ errr Term_resize(int w, int h)
 	/* Save old window */
 	hold_scr = Term->scr;
 
-	/* Save old window */
+	/* Save old window, completing any partial saves so they can be copied */
+	term_mem_flatten(Term);
 	hold_mem = Term->mem;
 
 	/* Save old window */
@@ -3074,6 +3250,9 @@ errr Term_activate(term *t)
  */
 errr term_nuke(term *t)
 {
+	/* Forget any flush still waiting on a batch */
+	if (term_batch_last == t) term_batch_last = NULL;
+
 	/* Hack -- Call the special "nuke" hook */
 	if (t->active_flag) {
 		/* Call the "nuke" hook */
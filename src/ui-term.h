@@ -27,6 +27,8 @@
  *	- Array[h*w] -- Attribute array
  *	- Array[h*w] -- Character array
  *
+ *	- Array[h] -- Rows holding saved contents (Term_save() layers only)
+ *
  *	- next screen saved
  *	- hook to be called on screen size change
  *
@@ -54,6 +56,8 @@ struct term_win
 	int *vta;
 	wchar_t *vtc;
 
+	bool *saved_row;
+
 	term_win *next;
 };
 
@@ -302,6 +306,16 @@ extern int col_map[SIDEBAR_MAX];
 #define TERM_XTRA_LEVEL 12    /* Change the "soft" level (optional) */
 #define TERM_XTRA_DELAY 13    /* Delay some milliseconds (optional) */
 
+/**
+ * Values for the "v" code of "TERM_XTRA_FRESH".  Between Term_batch_begin()
+ * and Term_batch_end(), Term_fresh() asks for TERM_FRESH_DEFER, which lets
+ * the front end hold the output back until the TERM_FRESH_NOW that ends the
+ * batch, and so write the whole batch at once.  Front ends that ignore "v"
+ * just flush every time.
+ */
+#define TERM_FRESH_NOW		0
+#define TERM_FRESH_DEFER	1
+
 /**
  * Bit flags for the "window_flag" variable.
  */
@@ -370,6 +384,8 @@ extern void Term_big_queue_char(term *t, int x, int y, int clipy,
 extern void Term_queue_chars(int x, int y, int n, int a, const wchar_t *s);
 
 extern errr Term_fresh(void);
+extern void Term_batch_begin(void);
+extern void Term_batch_end(void);
 extern errr Term_set_cursor(bool v);
 extern errr Term_gotoxy(int x, int y);
 extern errr Term_draw(int x, int y, int a, wchar_t c);
@@ -514,6 +514,7 @@ void start_tutorial(void)
 				a->v.archetype.added_abilities[i]);
 			assert(anew);
 			anew->active = true;
+			player->upkeep->update |= (PU_BONUS | PU_ABILITIES);
 		}
 
 		/* Adjust the pool of unspent experience if necesary. */
@@ -591,6 +591,38 @@ int dice_roll(const dice_t *dice, random_value *v)
 	return rv.base + damroll(rv.dice, rv.sides);
 }
 
+/**
+ * Get one part of a dice object, for code that evaluates dice by itself.
+ *
+ * \param dice is the dice object.
+ * \param part is 0 for the base, 1 for the number of dice, 2 for the sides,
+ * or 3 for the bonus.
+ * \param value is set to the part's value if it doesn't use an expression.
+ * \return the expression bound to the part, or NULL if it has a fixed value.
+ */
+const expression_t *dice_part(const dice_t *dice, int part, int *value)
+{
+	int n;
+	bool ex;
+
+	switch (part) {
+		case 0: n = dice->b; ex = dice->ex_b; break;
+		case 1: n = dice->x; ex = dice->ex_x; break;
+		case 2: n = dice->y; ex = dice->ex_y; break;
+		default: n = dice->m; ex = dice->ex_m; break;
+	}
+
+	if (!ex) {
+		*value = n;
+		return NULL;
+	}
+
+	/* A variable without an expression counts as zero */
+	*value = 0;
+	if (dice->expressions == NULL) return NULL;
+	return dice->expressions[n].expression;
+}
+
 /**
  * Test the dice object against the given values.
  */
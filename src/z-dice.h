@@ -34,6 +34,7 @@ int dice_bind_expression(dice_t *dice, const char *name,
 void dice_random_value(const dice_t *dice, random_value *v);
 int dice_evaluate(const dice_t *dice, int level, aspect asp, random_value *v);
 int dice_roll(const dice_t *dice, random_value *v);
+const expression_t *dice_part(const dice_t *dice, int part, int *value);
 bool dice_test_values(const dice_t *dice, int base, int dice_count, int sides,
 		int bonus);
 bool dice_test_variables(const dice_t *dice, const char *base,
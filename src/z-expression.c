@@ -33,18 +33,6 @@ struct expression_s {
 	int32_t fixed_base;
 };
 
-/**
- * Operator types.
- */
-typedef enum expression_operator_e {
-	OPERATOR_NONE,
-	OPERATOR_ADD,
-	OPERATOR_SUB,
-	OPERATOR_MUL,
-	OPERATOR_DIV,
-	OPERATOR_NEG,
-} expression_operator_t;
-
 /**
  * States for parser state table.
  */
@@ -268,6 +256,35 @@ int32_t expression_evaluate(expression_t const * const expression)
 	return value;
 }
 
+/**
+ * Return the base value function of an expression, or NULL if it starts from
+ * its fixed base.
+ */
+expression_base_value_f expression_base_value(const expression_t *expression)
+{
+	return expression->base_value;
+}
+
+/**
+ * Return the number of operations in an expression.
+ */
+size_t expression_operation_count(const expression_t *expression)
+{
+	return expression->operation_count;
+}
+
+/**
+ * Return the operator of the i-th operation of an expression, and set
+ * operand to its operand.
+ */
+expression_operator_t expression_operation(const expression_t *expression,
+	size_t i, int16_t *operand)
+{
+	assert(i < expression->operation_count);
+	*operand = expression->operations[i].operand;
+	return expression->operations[i].operator;
+}
+
 /**
  * Add an operation to an expression, allocating more memory as needed.
  */
@@ -30,6 +30,18 @@ enum expression_err_e {
 	EXPRESSION_ERR_OPERAND_OUT_OF_BOUNDS = -6
 };
 
+/**
+ * Operator types.
+ */
+typedef enum expression_operator_e {
+	OPERATOR_NONE,
+	OPERATOR_ADD,
+	OPERATOR_SUB,
+	OPERATOR_MUL,
+	OPERATOR_DIV,
+	OPERATOR_NEG,
+} expression_operator_t;
+
 typedef struct expression_operation_s expression_operation_t;
 typedef struct expression_s expression_t;
 typedef int32_t (*expression_base_value_f)(void);
@@ -41,6 +53,10 @@ void expression_set_fixed_base(expression_t *expression, int32_t value);
 void expression_set_base_value(expression_t *expression,
 	expression_base_value_f function);
 int32_t expression_evaluate(expression_t const * const expression);
+expression_base_value_f expression_base_value(const expression_t *expression);
+size_t expression_operation_count(const expression_t *expression);
+expression_operator_t expression_operation(const expression_t *expression,
+	size_t i, int16_t *operand);
 int16_t expression_add_operations_string(expression_t *expression,
 									  const char *string);
 bool expression_test_copy(const expression_t *a, const expression_t *b);
@@ -840,12 +840,22 @@ size_t path_filename_index(const char *path)
 FILE *fdopen(int handle, const char *mode);
 #endif
 
+/**
+ * Size of the read-ahead buffer used by file_getl()
+ */
+#define FILE_BUF_SIZE 16384
+
 /* Private structure to hold file pointers and useful info. */
 struct ang_file
 {
 	FILE *fh;
 	char *fname;
 	file_mode mode;
+
+	/* Read-ahead buffer; allocated by the first call to file_getl() */
+	char *buf;
+	size_t buf_pos;
+	size_t buf_len;
 };
 
 
@@ -1014,6 +1024,7 @@ bool file_close(ang_file *f)
 	if (fclose(f->fh) != 0)
 		return false;
 
+	mem_free(f->buf);
 	mem_free(f->fname);
 	mem_free(f);
 
@@ -1059,11 +1070,50 @@ void file_unlock(ang_file *f)
 
 /** Byte-based IO and functions **/
 
+/**
+ * Refill the read-ahead buffer of file 'f'.  Returns false at end of file.
+ */
+static bool file_buf_fill(ang_file *f)
+{
+	if (!f->buf)
+		f->buf = mem_alloc(FILE_BUF_SIZE);
+
+	f->buf_pos = 0;
+	f->buf_len = fread(f->buf, 1, FILE_BUF_SIZE, f->fh);
+
+	return f->buf_len > 0;
+}
+
+/**
+ * Discard anything left in the read-ahead buffer of file 'f', moving the
+ * underlying stream back to where the caller thinks it is.
+ */
+static void file_buf_drop(ang_file *f)
+{
+	size_t unread = f->buf_len - f->buf_pos;
+
+	if (unread)
+		fseek(f->fh, -(long)unread, SEEK_CUR);
+
+	f->buf_pos = 0;
+	f->buf_len = 0;
+}
+
 /**
  * Seek to location 'pos' in file 'f'.
  */
 bool file_skip(ang_file *f, int bytes)
 {
+	/* Stay within the read-ahead buffer if we can */
+	if (f->buf_len) {
+		if ((bytes >= 0 && (size_t)bytes <= f->buf_len - f->buf_pos)
+				|| (bytes < 0 && (size_t)(-(long)bytes) <= f->buf_pos)) {
+			f->buf_pos += bytes;
+			return true;
+		}
+		file_buf_drop(f);
+	}
+
 	return (fseek(f->fh, bytes, SEEK_CUR) == 0);
 }
 
@@ -1072,8 +1122,14 @@ bool file_skip(ang_file *f, int bytes)
  */
 bool file_readc(ang_file *f, uint8_t *b)
 {
-	int i = fgetc(f->fh);
+	int i;
 
+	if (f->buf_pos < f->buf_len) {
+		*b = (uint8_t)f->buf[f->buf_pos++];
+		return true;
+	}
+
+	i = fgetc(f->fh);
 	if (i == EOF)
 		return false;
 
@@ -1094,12 +1150,23 @@ bool file_writec(ang_file *f, uint8_t b)
  */
 int file_read(ang_file *f, char *buf, size_t n)
 {
-	size_t read = fread(buf, 1, n, f->fh);
+	size_t buffered = 0, read;
+
+	/* Use up anything left over from file_getl() first */
+	if (f->buf_pos < f->buf_len) {
+		buffered = MIN(n, f->buf_len - f->buf_pos);
+		memcpy(buf, f->buf + f->buf_pos, buffered);
+		f->buf_pos += buffered;
+		if (buffered == n)
+			return n;
+	}
 
-	if (read == 0 && ferror(f->fh))
+	read = fread(buf + buffered, 1, n - buffered, f->fh);
+
+	if (read == 0 && buffered == 0 && ferror(f->fh))
 		return -1;
 	else
-		return read;
+		return read + buffered;
 }
 
 /**
@@ -1107,6 +1174,9 @@ int file_read(ang_file *f, char *buf, size_t n)
  */
 bool file_write(ang_file *f, const char *buf, size_t n)
 {
+	if (f->buf_len)
+		file_buf_drop(f);
+
 	return fwrite(buf, 1, n, f->fh) == n;
 }
 
@@ -1116,41 +1186,49 @@ bool file_write(ang_file *f, const char *buf, size_t n)
  * Read a line of text from file 'f' into buffer 'buf' of size 'n' bytes.
  *
  * Support both \r\n and \n as line endings, but not the outdated \r that used
- * to be used on Macs.  Replace non-printables with '?', and \ts with ' '.
+ * to be used on Macs.  Replace \ts with ' '.  Lines too long for 'buf' are
+ * split, with the remainder returned by the next call.
+ *
+ * The file is read through a large buffer, and runs of ordinary characters
+ * are located with memchr() and copied in one go.
  */
 #define TAB_COLUMNS 4
 
 bool file_getl(ang_file *f, char *buf, size_t len)
 {
 	bool seen_cr = false;
-	uint8_t b;
 	size_t i = 0;
 
 	/* Leave a byte for the terminating 0 */
 	size_t max_len = len - 1;
 
 	while (i < max_len) {
+		const char *p, *end;
+		size_t run;
 		char c;
 
-		if (!file_readc(f, &b)) {
+		if (f->buf_pos == f->buf_len && !file_buf_fill(f)) {
 			buf[i] = '\0';
 			return (i == 0) ? false : true;
 		}
 
-		c = (char) b;
+		p = f->buf + f->buf_pos;
+		c = *p;
 
 		if (c == '\r') {
 			seen_cr = true;
+			f->buf_pos++;
 			continue;
 		}
 
+		/* A lone \r ends the line; leave the next character unread */
 		if (seen_cr && c != '\n') {
-			fseek(f->fh, -1, SEEK_CUR);
 			buf[i] = '\0';
 			return true;
 		}
 
 		if (c == '\n') {
+			f->buf_pos++;
 			buf[i] = '\0';
 			return true;
 		}
@@ -1159,16 +1237,28 @@ bool file_getl(ang_file *f, char *buf, size_t len)
 		if (c == '\t') {
 			/* Next tab stop */
 			size_t tabstop = ((i + TAB_COLUMNS) / TAB_COLUMNS) * TAB_COLUMNS;
+			f->buf_pos++;
 			if (tabstop >= len) break;
 
 			/* Convert to spaces */
-			while (i < tabstop)
-				buf[i++] = ' ';
+			memset(buf + i, ' ', tabstop - i);
+			i = tabstop;
 
 			continue;
 		}
 
-		buf[i++] = c;
+		/* Copy everything up to the next special character or the limit */
+		run = MIN(f->buf_len - f->buf_pos, max_len - i);
+		end = memchr(p, '\n', run);
+		if (end) run = end - p;
+		end = memchr(p, '\t', run);
+		if (end) run = end - p;
+		end = memchr(p, '\r', run);
+		if (end) run = end - p;
+
+		memcpy(buf + i, p, run);
+		i += run;
+		f->buf_pos += run;
 	}
 
 	buf[i] = '\0';
@@ -81,21 +81,52 @@ struct point_set *point_set_new(int initial_size)
 	ps->n = 0;
 	ps->allocated = initial_size;
 	ps->pts = mem_zalloc(sizeof(*(ps->pts)) * ps->allocated);
+	ps->width = 0;
+	ps->height = 0;
+	ps->member = NULL;
+	return ps;
+}
+
+struct point_set *point_set_new_indexed(int initial_size, int width,
+	int height)
+{
+	struct point_set *ps = point_set_new(initial_size);
+	ps->width = width;
+	ps->height = height;
+	ps->member = mem_zalloc((width * height + 7) / 8);
 	return ps;
 }
 
 void point_set_dispose(struct point_set *ps)
 {
+	mem_free(ps->member);
 	mem_free(ps->pts);
 	mem_free(ps);
 }
 
+/**
+ * Position of the grid in a point set's membership bitmap, or -1 if it
+ * isn't covered
+ */
+static int point_set_index(struct point_set *ps, struct loc grid)
+{
+	if (!ps->member) return -1;
+	if (grid.x < 0 || grid.x >= ps->width) return -1;
+	if (grid.y < 0 || grid.y >= ps->height) return -1;
+	return grid.y * ps->width + grid.x;
+}
+
 /**
  * Add the point to the given point set, making more space if there is
  * no more space left.
  */
 void add_to_point_set(struct point_set *ps, struct loc grid)
 {
+	int idx = point_set_index(ps, grid);
+
+	if (idx >= 0) {
+		ps->member[idx / 8] |= 1 << (idx % 8);
+	}
 	ps->pts[ps->n] = grid;
 	ps->n++;
 	if (ps->n >= ps->allocated) {
@@ -111,7 +142,11 @@ int point_set_size(struct point_set *ps)
 
 int point_set_contains(struct point_set *ps, struct loc grid)
 {
-	int i;
+	int i, idx = point_set_index(ps, grid);
+
+	if (idx >= 0) {
+		return (ps->member[idx / 8] >> (idx % 8)) & 1;
+	}
 	for (i = 0; i < ps->n; i++)
 		if (loc_eq(ps->pts[i], grid))
 			return 1;
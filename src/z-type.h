@@ -46,14 +46,23 @@ struct grouper {
 
 /**
  * A set of points that can be constructed to apply a set of changes to
+ *
+ * A set made by point_set_new_indexed() also has a membership bitmap for
+ * grids with 0 <= x < width and 0 <= y < height, so point_set_contains()
+ * doesn't have to search the points.
  */
 struct point_set {
 	int n;
 	int allocated;
 	struct loc *pts;
+	int width;
+	int height;
+	uint8_t *member;
 };
 
 struct point_set *point_set_new(int initial_size);
+struct point_set *point_set_new_indexed(int initial_size, int width,
+	int height);
 void point_set_dispose(struct point_set *ps);
 void add_to_point_set(struct point_set *ps, struct loc grid);
 int point_set_size(struct point_set *ps);
@@ -938,6 +938,52 @@ void sort(void *base, size_t nmemb, size_t smemb,
 	qsort(base, nmemb, smemb, comp);
 }
 
+/**
+ * Sort an array which is mostly in order already, such as a list which was
+ * sorted last time and has had a few elements changed since.
+ *
+ * Each element is inserted into the sorted part before it, finding its place
+ * by binary search, so elements which are already in place cost a single
+ * comparison.  Equal elements keep their original order.
+ */
+void sort_insertion(void *base, size_t nmemb, size_t smemb,
+	  int (*comp)(const void *, const void *))
+{
+	char *array = base;
+	char *tmp;
+	size_t i;
+
+	if (nmemb < 2) return;
+	tmp = malloc(smemb);
+	if (!tmp) {
+		qsort(base, nmemb, smemb, comp);
+		return;
+	}
+	for (i = 1; i < nmemb; i++) {
+		char *elt = array + i * smemb;
+		size_t lo = 0, hi = i - 1;
+
+		/* Already after everything before it */
+		if (comp(elt - smemb, elt) <= 0) continue;
+
+		/* Find the first element that sorts after it */
+		while (lo < hi) {
+			size_t mid = (lo + hi) / 2;
+			if (comp(array + mid * smemb, elt) <= 0) {
+				lo = mid + 1;
+			} else {
+				hi = mid;
+			}
+		}
+
+		memcpy(tmp, elt, smemb);
+		memmove(array + (lo + 1) * smemb, array + lo * smemb,
+			(i - lo) * smemb);
+		memcpy(array + lo * smemb, tmp, smemb);
+	}
+	free(tmp);
+}
+
 uint32_t djb2_hash(const char *str)
 {
 	uint32_t hash = 5381;